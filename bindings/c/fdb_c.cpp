@@ -62,6 +62,9 @@ int g_api_version = 0;
    Standalone<RangeResultRef> as an array of FDBKeyValue. */
 static_assert(sizeof(FDBKeyValue) == sizeof(KeyValueRef), "FDBKeyValue / KeyValueRef size mismatch");
 
+/* This must be true so that we can read an array of FDBKey as a VectorRef<KeyRef>. */
+static_assert(sizeof(FDBKey) == sizeof(KeyRef), "FDBKey / KeyRef size mismatch");
+
 #define TSAV_ERROR(type, error) ((FDBFuture*)(ThreadFuture<type>(error())).extractPtr())
 
 extern "C" DLLEXPORT const char* fdb_get_error(fdb_error_t code) {
@@ -951,6 +954,13 @@ extern "C" DLLEXPORT fdb_error_t fdb_transaction_add_conflict_range(FDBTransacti
 	    else return error_code_client_invalid_operation;);
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_multi(FDBTransaction* tr,
+                                                          FDBKey const* keys,
+                                                          int count,
+                                                          fdb_bool_t snapshot) {
+	return (FDBFuture*)(TXN(tr)->getMulti(VectorRef<KeyRef>((KeyRef*)keys, count), snapshot).extractPtr());
+}
+
 extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_estimated_range_size_bytes(FDBTransaction* tr,
                                                                                uint8_t const* begin_key_name,
                                                                                int begin_key_name_length,
@@ -433,6 +433,13 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get(FDBTransaction* tr,
                                                             fdb_bool_t snapshot);
 #endif
 
+/* Reads the values of count keys in as few requests to the cluster as possible. The returned future is read with
+ * fdb_future_get_keyvalue_array() and holds the keys which have a value, in key order. */
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_multi(FDBTransaction* tr,
+                                                                  FDBKey const* keys,
+                                                                  int count,
+                                                                  fdb_bool_t snapshot);
+
 #if FDB_API_VERSION >= 14
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_key(FDBTransaction* tr,
                                                                 uint8_t const* key_name,
@@ -57,6 +57,10 @@ std::unordered_map<std::string, std::function<void(const std::string& value, Tes
 	  [](const std::string& value, TestSpec* spec) { //
 	      spec->multiThreaded = (value == "true");
 	  } },
+	{ "shardDatabasesAcrossThreads",
+	  [](const std::string& value, TestSpec* spec) { //
+	      spec->shardDatabasesAcrossThreads = (value == "true");
+	  } },
 	{ "fdbCallbacksOnExternalThreads",
 	  [](const std::string& value, TestSpec* spec) { //
 	      spec->fdbCallbacksOnExternalThreads = (value == "true");
@@ -48,6 +48,9 @@ struct TestSpec {
 	// Use multi-threaded FDB client
 	bool multiThreaded = false;
 
+	// Spread the transactions of each database across all FDB client threads
+	bool shardDatabasesAcrossThreads = false;
+
 	// Enable injection of errors in FDB client
 	bool buggify = false;
 
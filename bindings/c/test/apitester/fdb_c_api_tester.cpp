@@ -319,6 +319,9 @@ void applyNetworkOptions(TesterOptions& options) {
 
 	if (options.testSpec.multiThreaded) {
 		fdb::network::setOption(FDBNetworkOption::FDB_NET_OPTION_CLIENT_THREADS_PER_VERSION, options.numFdbThreads);
+		if (options.testSpec.shardDatabasesAcrossThreads) {
+			fdb::network::setOption(FDBNetworkOption::FDB_NET_OPTION_CLIENT_THREADS_SHARD_DATABASES);
+		}
 	}
 
 	if (options.testSpec.fdbCallbacksOnExternalThreads) {
@@ -646,6 +646,45 @@ TEST_CASE("write system key") {
 	CHECK(value->compare("bar") == 0);
 }
 
+TEST_CASE("fdb_transaction_get_multi") {
+	std::map<std::string, std::string> data = create_data({ { "a", "1" }, { "b", "2" }, { "c", "3" }, { "d", "4" } });
+	insert_data(db, data);
+
+	fdb::Transaction tr(db);
+	while (1) {
+		tr.set(key("e"), "5");
+		tr.clear(key("d"));
+		// Keys are returned in key order, without duplicates or missing keys
+		fdb::KeyValueArrayFuture f1 = tr.get_multi({ key("c"), key("x"), key("a"), key("d"), key("e"), key("a") },
+		                                           /* snapshot */ false);
+
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+
+		FDBKeyValue const* out_kv;
+		int out_count;
+		int out_more;
+		fdb_check(f1.get(&out_kv, &out_count, &out_more));
+
+		std::vector<std::pair<std::string, std::string>> expected = { { key("a"), "1" },
+			                                                          { key("c"), "3" },
+			                                                          { key("e"), "5" } };
+		CHECK(out_count == expected.size());
+		CHECK(!out_more);
+		for (int i = 0; i < out_count && i < expected.size(); ++i) {
+			std::string k((const char*)out_kv[i].key, out_kv[i].key_length);
+			std::string v((const char*)out_kv[i].value, out_kv[i].value_length);
+			CHECK(k == expected[i].first);
+			CHECK(v == expected[i].second);
+		}
+		break;
+	}
+}
+
 TEST_CASE("fdb_transaction read_your_writes") {
 	fdb::Transaction tr(db);
 	clear_data(db);
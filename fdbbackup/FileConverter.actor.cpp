@@ -171,15 +171,16 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 		// Decodes the block into mutations and save them if >= minVersion and < maxVersion.
 		// Returns true if new mutations has been saved.
 		bool decodeBlock(const Standalone<StringRef>& buf, int len, Version minVersion, Version maxVersion) {
-			StringRef block(buf.begin(), len);
-			StringRefReader reader(block, restore_corrupted_data());
+			Standalone<StringRef> block;
+			StringRefReader reader;
 			int count = 0, inserted = 0;
 			Version msgVersion = invalidVersion;
 
 			try {
-				// Read block header
-				if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-					throw restore_unsupported_file_version();
+				// Read block header and decompress the block if needed
+				block = fileBackup::decodePartitionedLogBlock(
+				    Standalone<StringRef>(StringRef(buf.begin(), len), buf.arena()));
+				reader = StringRefReader(block, restore_corrupted_data());
 
 				while (1) {
 					// If eof reached or first key len bytes is 0xFF then end of block was reached.
@@ -193,7 +194,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 					const uint8_t* message = reader.consume(msgSize);
 
 					ArenaReader rd(
-					    buf.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
+					    block.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
 					MutationRef m;
 					rd >> m;
 					count++;
@@ -207,7 +208,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 					}
 					if (msgVersion >= minVersion) {
 						mutations.emplace_back(
-						    LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), buf.arena());
+						    LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), block.arena());
 						inserted++;
 					}
 				}
@@ -217,7 +218,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 				    .detail("Name", fd->getFilename())
 				    .detail("Count", count)
 				    .detail("Insert", inserted)
-				    .detail("BlockOffset", reader.rptr - buf.begin())
+				    .detail("BlockOffset", reader.rptr - block.begin())
 				    .detail("Total", mutations.size())
 				    .detail("EOF", eof)
 				    .detail("Version", msgVersion)
@@ -229,8 +230,8 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 				    .detail("Filename", fd->getFilename())
 				    .detail("BlockOffset", offset)
 				    .detail("BlockLen", len)
-				    .detail("ErrorRelativeOffset", reader.rptr - buf.begin())
-				    .detail("ErrorAbsoluteOffset", reader.rptr - buf.begin() + offset);
+				    .detail("ErrorRelativeOffset", reader.rptr - block.begin())
+				    .detail("ErrorAbsoluteOffset", reader.rptr - block.begin() + offset);
 				throw;
 			}
 		}
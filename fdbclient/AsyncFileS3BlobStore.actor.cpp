@@ -29,8 +29,60 @@ Future<int64_t> AsyncFileS3BlobStoreRead::size() const {
 	return m_size;
 }
 
+// Reads one range of a larger read once the file has room for it in its in-flight byte budget.
+ACTOR static Future<int> readObjectRange(AsyncFileS3BlobStoreRead* f, uint8_t* data, int length, int64_t offset) {
+	wait(f->m_readBytes.take(TaskPriority::DefaultYield, length));
+	state FlowLock::Releaser releaser(f->m_readBytes, length);
+	int len = wait(f->m_bstore->readObject(f->m_bucket, f->m_object, data, length, offset));
+	return std::min(len, length);
+}
+
+// Reads [offset, offset + length) as pieces of at most blockSize bytes, all read concurrently with readRange. Returns
+// the number of bytes read up to the first piece that came back short, since the bytes after it are not contiguous.
+ACTOR static Future<int> readRanges(std::function<Future<int>(uint8_t*, int, int64_t)> readRange,
+                                    uint8_t* data,
+                                    int length,
+                                    int64_t offset,
+                                    int blockSize) {
+	state std::vector<Future<int>> reads;
+	for (int pos = 0; pos < length; pos += blockSize) {
+		reads.push_back(readRange(data + pos, std::min(blockSize, length - pos), offset + pos));
+	}
+	wait(waitForAll(reads));
+
+	int total = 0;
+	for (int i = 0; i < reads.size(); i++) {
+		const int len = reads[i].get();
+		total += len;
+		if (len < std::min(blockSize, length - i * blockSize)) {
+			break;
+		}
+	}
+	return total;
+}
+
+ACTOR static Future<int> readObjectRanges(Reference<AsyncFileS3BlobStoreRead> f,
+                                         uint8_t* data,
+                                         int length,
+                                         int64_t offset) {
+	// Ranges starting past the end of the object would fail, so clip the read to the object first.
+	int64_t size = wait(f->size());
+	if (offset >= size)
+		return 0;
+	length = std::min<int64_t>(length, size - offset);
+
+	auto readPiece = [f = f](uint8_t* pieceData, int pieceLength, int64_t pieceOffset) {
+		return readObjectRange(f.getPtr(), pieceData, pieceLength, pieceOffset);
+	};
+	int total = wait(readRanges(readPiece, data, length, offset, f->m_bstore->knobs.read_block_size));
+	return total;
+}
+
 Future<int> AsyncFileS3BlobStoreRead::read(void* data, int length, int64_t offset) {
-	return m_bstore->readObject(m_bucket, m_object, data, length, offset);
+	if (length <= m_bstore->knobs.read_block_size || m_bstore->knobs.read_block_size <= 0) {
+		return m_bstore->readObject(m_bucket, m_object, data, length, offset);
+	}
+	return readObjectRanges(Reference<AsyncFileS3BlobStoreRead>::addRef(this), (uint8_t*)data, length, offset);
 }
 
 ACTOR Future<Void> sendStuff(int id, Reference<IRateControl> t, int bytes) {
@@ -82,3 +134,36 @@ TEST_CASE("/backup/throttling") {
 
 	return Void();
 }
+
+TEST_CASE("/backup/s3/readRanges") {
+	state int blockSize = 100;
+	state int length = 1000;
+	state int shortPiece = deterministicRandom()->randomInt(0, length / blockSize);
+	state int shortLength = deterministicRandom()->randomInt(0, blockSize);
+	state std::vector<uint8_t> buffer(length, 0);
+
+	// Fills each piece with its offset's low byte, except that one piece comes back short
+	state std::function<Future<int>(uint8_t*, int, int64_t)> readRange =
+	    [blockSize = blockSize, shortPiece = shortPiece, shortLength = shortLength](
+	        uint8_t* data, int len, int64_t offset) -> Future<int> {
+		const int n = offset / blockSize == shortPiece ? shortLength : len;
+		for (int i = 0; i < n; i++) {
+			data[i] = (offset + i) & 0xff;
+		}
+		return n;
+	};
+
+	int total = wait(readRanges(readRange, buffer.data(), length, 0, blockSize));
+	ASSERT_EQ(total, shortPiece * blockSize + shortLength);
+	for (int i = 0; i < total; i++) {
+		ASSERT_EQ(buffer[i], i & 0xff);
+	}
+
+	// A read that is short only in its last piece returns everything read
+	int last = wait(readRanges(readRange, buffer.data(), (shortPiece + 1) * blockSize, 0, blockSize));
+	ASSERT_EQ(last, shortPiece * blockSize + shortLength);
+
+	int full = wait(readRanges(readRange, buffer.data(), shortPiece * blockSize, 0, blockSize));
+	ASSERT_EQ(full, shortPiece * blockSize);
+	return Void();
+}
@@ -54,9 +54,14 @@
 // File Format stuff
 
 // Version info for file format of chunked files.
-uint16_t LATEST_BG_FORMAT_VERSION = 1;
+uint16_t LATEST_BG_FORMAT_VERSION = 2;
 uint16_t MIN_SUPPORTED_BG_FORMAT_VERSION = 1;
 
+// Delta files and row-oriented snapshot files are still written in version 1. Version 2 is only used for snapshot files
+// with columnar chunks, which version 1 readers can't parse.
+uint16_t ROW_BG_FORMAT_VERSION = 1;
+uint16_t COLUMNAR_SNAPSHOT_BG_FORMAT_VERSION = 2;
+
 // TODO combine with SystemData? These don't actually have to match though
 
 const uint8_t SNAPSHOT_FILE_TYPE = 'S';
@@ -193,6 +198,111 @@ struct ChildBlockPointerRef {
 	};
 };
 
+// Bloom filter over the keys of one snapshot chunk, using double hashing of the key's xxhash.
+struct ChunkKeyFilter {
+	static constexpr int BITS_PER_KEY = 10;
+	static constexpr int NUM_HASHES = 7;
+
+	static StringRef build(const VectorRef<KeyValueRef>& rows, Arena& arena) {
+		int bytes = (rows.size() * BITS_PER_KEY + 7) / 8;
+		uint8_t* bits = new (arena) uint8_t[bytes];
+		memset(bits, 0, bytes);
+		uint32_t numBits = bytes * 8;
+		for (auto& row : rows) {
+			uint64_t hash = XXH3_64bits(row.key.begin(), row.key.size());
+			uint32_t h1 = hash;
+			uint32_t h2 = hash >> 32;
+			for (int i = 0; i < NUM_HASHES; i++) {
+				uint32_t bit = (h1 + i * h2) % numBits;
+				bits[bit / 8] |= 1 << (bit % 8);
+			}
+		}
+		return StringRef(bits, bytes);
+	}
+
+	static bool mayContain(const StringRef& filter, const KeyRef& key) {
+		if (filter.empty()) {
+			return true;
+		}
+		uint32_t numBits = filter.size() * 8;
+		uint64_t hash = XXH3_64bits(key.begin(), key.size());
+		uint32_t h1 = hash;
+		uint32_t h2 = hash >> 32;
+		for (int i = 0; i < NUM_HASHES; i++) {
+			uint32_t bit = (h1 + i * h2) % numBits;
+			if (!(filter[bit / 8] & (1 << (bit % 8)))) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+// Columnar snapshot chunks store the row count and the size of the key column, then the key column, then the value
+// column. Each key is stored as the length of the prefix it shares with the previous key, the length of the rest of
+// the key and of its value, and the rest of the key. Sorted keys in a granule share long prefixes, and a reader can
+// find the rows in its range from the key column alone, only materializing the keys it returns.
+Value serializeColumnarSnapshotChunk(const VectorRef<KeyValueRef>& rows) {
+	BinaryWriter keyColumn(Unversioned());
+	BinaryWriter valueColumn(Unversioned());
+	KeyRef prevKey;
+	for (auto& row : rows) {
+		ASSERT(row.key.size() <= std::numeric_limits<uint16_t>::max());
+		uint16_t sharedLen = commonPrefixLength(prevKey, row.key);
+		uint16_t suffixLen = row.key.size() - sharedLen;
+		int32_t valueLen = row.value.size();
+		keyColumn << sharedLen << suffixLen << valueLen;
+		keyColumn.serializeBytes(row.key.substr(sharedLen));
+		valueColumn.serializeBytes(row.value);
+		prevKey = row.key;
+	}
+
+	BinaryWriter wr(Unversioned());
+	wr << (int32_t)rows.size() << (int32_t)keyColumn.getLength();
+	wr.serializeBytes(keyColumn.getData(), keyColumn.getLength());
+	wr.serializeBytes(valueColumn.getData(), valueColumn.getLength());
+	return wr.toValue();
+}
+
+// Appends the rows of a columnar snapshot chunk that are in keyRange to results, and returns whether there were any.
+// Values point into chunkBytes, so the caller must make results depend on the arena holding them.
+bool appendColumnarSnapshotChunk(const StringRef& chunkBytes,
+                                 const KeyRangeRef& keyRange,
+                                 Standalone<VectorRef<ParsedDeltaBoundaryRef>>& results) {
+	BinaryReader rd(chunkBytes, Unversioned());
+	int32_t rowCount;
+	int32_t keyColumnLen;
+	rd >> rowCount >> keyColumnLen;
+	const uint8_t* value = chunkBytes.begin() + 2 * sizeof(int32_t) + keyColumnLen;
+
+	std::vector<uint8_t> key;
+	bool anyRows = false;
+	for (int i = 0; i < rowCount; i++) {
+		uint16_t sharedLen;
+		uint16_t suffixLen;
+		int32_t valueLen;
+		rd >> sharedLen >> suffixLen >> valueLen;
+		ASSERT(sharedLen <= key.size());
+		key.resize(sharedLen + suffixLen);
+		memcpy(key.data() + sharedLen, rd.readBytes(suffixLen), suffixLen);
+
+		ASSERT(value + valueLen <= chunkBytes.end());
+
+		KeyRef currentKey(key.data(), key.size());
+		if (currentKey >= keyRange.end) {
+			break;
+		}
+		if (currentKey >= keyRange.begin) {
+			results.push_back(results.arena(),
+			                  ParsedDeltaBoundaryRef(
+			                      KeyValueRef(KeyRef(results.arena(), currentKey), StringRef(value, valueLen))));
+			anyRows = true;
+		}
+		value += valueLen;
+	}
+	return anyRows;
+}
+
 namespace {
 BlobGranuleFileEncryptionKeys getEncryptBlobCipherKey(const BlobGranuleCipherKeysCtx cipherKeysCtx) {
 	BlobGranuleFileEncryptionKeys eKeys;
@@ -260,10 +370,14 @@ struct IndexBlock {
 
 	// Serializable fields
 	VectorRef<ChildBlockPointerRef> children;
+	// Columnar snapshot files only, one entry per chunk: the last key in the chunk and a bloom filter of its keys, so
+	// readers can skip chunks without decrypting or decompressing them.
+	VectorRef<KeyRef> chunkLastKeys;
+	VectorRef<StringRef> chunkKeyFilters;
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, children);
+		serializer(ar, children, chunkLastKeys, chunkKeyFilters);
 	}
 };
 
@@ -574,7 +688,7 @@ struct IndexedBlobGranuleFile {
 	StringRef fileBytes;
 
 	void init(uint8_t fType, const Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx) {
-		formatVersion = LATEST_BG_FORMAT_VERSION;
+		formatVersion = ROW_BG_FORMAT_VERSION;
 		fileType = fType;
 		chunkStartOffset = -1;
 	}
@@ -627,6 +741,31 @@ struct IndexedBlobGranuleFile {
 		return startBlock;
 	}
 
+	bool isColumnarSnapshot() const {
+		return fileType == SNAPSHOT_FILE_TYPE && formatVersion >= COLUMNAR_SNAPSHOT_BG_FORMAT_VERSION;
+	}
+
+	// Returns the decrypted and decompressed bytes of a child chunk, which live in arena.
+	StringRef getChildBytes(const ChildBlockPointerRef* childPointer,
+	                        Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
+	                        int startOffset,
+	                        Arena& arena) {
+		ASSERT(childPointer != indexBlockRef.block.children.end());
+		const ChildBlockPointerRef* nextPointer = childPointer + 1;
+		ASSERT(nextPointer != indexBlockRef.block.children.end());
+
+		size_t blockSize = nextPointer->offset - childPointer->offset;
+		StringRef childData(fileBytes.begin() + childPointer->offset + startOffset, blockSize);
+
+		IndexBlobGranuleFileChunkRef chunkRef =
+		    IndexBlobGranuleFileChunkRef::fromBytes(cipherKeysCtx, childData, arena);
+		if (!chunkRef.encryptHeaderRef.present() && !chunkRef.compressionFilter.present()) {
+			// chunk bytes point into the file buffer, which the caller does not own
+			return StringRef(arena, chunkRef.chunkBytes.get());
+		}
+		return chunkRef.chunkBytes.get();
+	}
+
 	// FIXME: implement some sort of iterator type interface?
 	template <class ChildType>
 	Standalone<ChildType> getChild(const ChildBlockPointerRef* childPointer,
@@ -719,20 +858,26 @@ Value serializeChunkedSnapshot(const Standalone<StringRef>& fileNameRef,
                                const Standalone<GranuleSnapshot>& snapshot,
                                int targetChunkBytes,
                                Optional<CompressionFilter> compressFilter,
-                               Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx) {
+                               Optional<BlobGranuleCipherKeysCtx> cipherKeysCtx,
+                               bool columnar) {
 
 	if (BG_ENCRYPT_COMPRESS_DEBUG) {
 		TraceEvent(SevDebug, "SerializeChunkedSnapshot")
 		    .detail("FileName", fileNameRef.toString())
 		    .detail("Encrypted", cipherKeysCtx.present())
-		    .detail("Compressed", compressFilter.present());
+		    .detail("Compressed", compressFilter.present())
+		    .detail("Columnar", columnar);
 	}
 
 	CODE_PROBE(compressFilter.present(), "serializing compressed snapshot file");
 	CODE_PROBE(cipherKeysCtx.present(), "serializing encrypted snapshot file");
+	CODE_PROBE(columnar, "serializing columnar snapshot file");
 	Standalone<IndexedBlobGranuleFile> file;
 
 	file.init(SNAPSHOT_FILE_TYPE, cipherKeysCtx);
+	if (columnar) {
+		file.formatVersion = COLUMNAR_SNAPSHOT_BG_FORMAT_VERSION;
+	}
 
 	size_t currentChunkBytesEstimate = 0;
 	size_t previousChunkBytes = 0;
@@ -751,8 +896,16 @@ Value serializeChunkedSnapshot(const Standalone<StringRef>& fileNameRef,
 		currentChunkBytesEstimate += snapshot[i].expectedSize();
 
 		if (currentChunkBytesEstimate >= targetChunkBytes || i == snapshot.size() - 1) {
-			Value serialized =
-			    BinaryWriter::toValue(currentChunk, IncludeVersion(ProtocolVersion::withBlobGranuleFile()));
+			Value serialized;
+			if (columnar) {
+				serialized = serializeColumnarSnapshotChunk(currentChunk);
+				file.indexBlockRef.block.chunkLastKeys.push_back_deep(file.arena(), currentChunk.back().key);
+				file.indexBlockRef.block.chunkKeyFilters.push_back(file.arena(),
+				                                                   ChunkKeyFilter::build(currentChunk, file.arena()));
+			} else {
+				serialized =
+				    BinaryWriter::toValue(currentChunk, IncludeVersion(ProtocolVersion::withBlobGranuleFile()));
+			}
 			Value chunkBytes =
 			    IndexBlobGranuleFileChunkRef::toBytes(cipherKeysCtx, compressFilter, serialized, file.arena());
 			chunks.push_back(chunkBytes);
@@ -811,6 +964,10 @@ static Standalone<VectorRef<ParsedDeltaBoundaryRef>> loadSnapshotFile(
 	}
 
 	ASSERT(file.indexBlockRef.block.children.size() >= 2);
+	if (file.isColumnarSnapshot()) {
+		ASSERT(file.indexBlockRef.block.chunkLastKeys.size() == file.indexBlockRef.block.children.size() - 1);
+		ASSERT(file.indexBlockRef.block.chunkKeyFilters.size() == file.indexBlockRef.block.chunkLastKeys.size());
+	}
 
 	// find range of blocks needed to read
 	ChildBlockPointerRef* currentBlock = file.findStartBlock(keyRange.begin);
@@ -826,6 +983,26 @@ static Standalone<VectorRef<ParsedDeltaBoundaryRef>> loadSnapshotFile(
 		auto nextBlock = currentBlock;
 		nextBlock++;
 		lastBlock = (nextBlock == (file.indexBlockRef.block.children.end() - 1)) || (keyRange.end <= nextBlock->key);
+
+		if (file.isColumnarSnapshot()) {
+			int chunkIdx = currentBlock - file.indexBlockRef.block.children.begin();
+			const IndexBlock& index = file.indexBlockRef.block;
+			if (index.chunkLastKeys[chunkIdx] < keyRange.begin) {
+				CODE_PROBE(true, "skipping columnar snapshot chunk before range");
+			} else if (keyRange.singleKeyRange() &&
+			           !ChunkKeyFilter::mayContain(index.chunkKeyFilters[chunkIdx], keyRange.begin)) {
+				CODE_PROBE(true, "skipping columnar snapshot chunk by bloom filter");
+			} else {
+				Arena chunkArena;
+				StringRef chunkBytes =
+				    file.getChildBytes(currentBlock, cipherKeysCtx, file.chunkStartOffset, chunkArena);
+				if (appendColumnarSnapshotChunk(chunkBytes, keyRange, results)) {
+					results.arena().dependsOn(chunkArena);
+				}
+			}
+			currentBlock++;
+			continue;
+		}
 		Standalone<GranuleSnapshot> dataBlock =
 		    file.getChild<GranuleSnapshot>(currentBlock, cipherKeysCtx, file.chunkStartOffset);
 		ASSERT(!dataBlock.empty());
@@ -2019,6 +2196,7 @@ struct KeyValueGen {
 	// TODO: possibly different cipher keys or meta context per file?
 	Optional<BlobGranuleCipherKeysCtx> cipherKeys;
 	Optional<CompressionFilter> compressFilter;
+	bool columnarSnapshot;
 
 	KeyValueGen() {
 		sharedPrefix = deterministicRandom()->randomUniqueID().toString();
@@ -2065,6 +2243,7 @@ struct KeyValueGen {
 		if (deterministicRandom()->coinflip()) {
 			compressFilter = CompressionUtils::getRandomFilter();
 		}
+		columnarSnapshot = deterministicRandom()->coinflip();
 	}
 
 	Optional<StringRef> newKey() {
@@ -2250,16 +2429,19 @@ TEST_CASE("/blobgranule/files/validateEncryptionCompression") {
 	for (bool encryptionMode : encryptionModes) {
 		Optional<BlobGranuleCipherKeysCtx> keys = encryptionMode ? cipherKeys : Optional<BlobGranuleCipherKeysCtx>();
 		for (auto& compressionMode : compressionModes) {
-			Value v =
-			    serializeChunkedSnapshot(fileNameRef, snapshotData, targetSnapshotChunkSize, compressionMode, keys);
-			fmt::print("snapshot({0}, {1}): {2}\n",
-			           encryptionMode,
-			           compressionMode.present() ? CompressionUtils::toString(compressionMode.get()) : "",
-			           v.size());
-			for (auto& v2 : snapshotValues) {
-				ASSERT(v != v2);
+			for (bool columnar : { false, true }) {
+				Value v = serializeChunkedSnapshot(
+				    fileNameRef, snapshotData, targetSnapshotChunkSize, compressionMode, keys, columnar);
+				fmt::print("snapshot({0}, {1}, {2}): {3}\n",
+				           encryptionMode,
+				           compressionMode.present() ? CompressionUtils::toString(compressionMode.get()) : "",
+				           columnar,
+				           v.size());
+				for (auto& v2 : snapshotValues) {
+					ASSERT(v != v2);
+				}
+				snapshotValues.push_back(v);
 			}
-			snapshotValues.push_back(v);
 		}
 	}
 	fmt::print("Validated {0} encryption/compression combos for snapshot\n", snapshotValues.size());
@@ -2307,10 +2489,13 @@ TEST_CASE("/blobgranule/files/snapshotFormatUnitTest") {
 		ASSERT(data[i].key < data[i + 1].key);
 	}
 
-	fmt::print("Constructing snapshot with {0} rows, {1} chunks\n", data.size(), targetChunks);
+	fmt::print("Constructing {0} snapshot with {1} rows, {2} chunks\n",
+	           kvGen.columnarSnapshot ? "columnar" : "row",
+	           data.size(),
+	           targetChunks);
 
-	Value serialized =
-	    serializeChunkedSnapshot(fnameRef, data, targetChunkSize, kvGen.compressFilter, kvGen.cipherKeys);
+	Value serialized = serializeChunkedSnapshot(
+	    fnameRef, data, targetChunkSize, kvGen.compressFilter, kvGen.cipherKeys, kvGen.columnarSnapshot);
 
 	fmt::print("Snapshot serialized! {0} bytes\n", serialized.size());
 
@@ -2333,6 +2518,20 @@ TEST_CASE("/blobgranule/files/snapshotFormatUnitTest") {
 			checkSnapshotRead(fnameRef, data, serialized, start, start + width, kvGen.cipherKeys);
 		}
 
+		fmt::print("Doing single key checks\n");
+		for (int i = 0; i < std::min(100, data.size()); i++) {
+			int idx = deterministicRandom()->randomInt(0, data.size() - 1);
+			Standalone<VectorRef<ParsedDeltaBoundaryRef>> result =
+			    loadSnapshotFile(fnameRef, serialized, singleKeyRange(data[idx].key), kvGen.cipherKeys);
+			ASSERT(result.size() == 1);
+			ASSERT(result[0].key == data[idx].key);
+			ASSERT(result[0].value == data[idx].value);
+			if (keyAfter(data[idx].key) != data[idx + 1].key) {
+				Key missingKey = keyAfter(data[idx].key);
+				checkSnapshotEmpty(serialized, missingKey, keyAfter(missingKey), kvGen.cipherKeys);
+			}
+		}
+
 		fmt::print("Doing empty checks\n");
 		int randomIdx = deterministicRandom()->randomInt(0, data.size() - 1);
 		checkSnapshotEmpty(serialized, keyAfter(data[randomIdx].key), data[randomIdx + 1].key, kvGen.cipherKeys);
@@ -2609,8 +2808,12 @@ TEST_CASE("/blobgranule/files/granuleReadUnitTest") {
 		}
 	}
 
-	Value serializedSnapshot = serializeChunkedSnapshot(
-	    fileNameRef, snapshotData, targetSnapshotChunkSize, kvGen.compressFilter, kvGen.cipherKeys);
+	Value serializedSnapshot = serializeChunkedSnapshot(fileNameRef,
+	                                                    snapshotData,
+	                                                    targetSnapshotChunkSize,
+	                                                    kvGen.compressFilter,
+	                                                    kvGen.cipherKeys,
+	                                                    kvGen.columnarSnapshot);
 
 	// split deltas up across multiple files
 	int deltaFiles = std::min(deltaData.size(), deterministicRandom()->randomInt(1, 21));
@@ -2887,7 +3090,8 @@ int WRITE_RUNS = 5;
 std::pair<int64_t, double> doSnapshotWriteBench(const Standalone<GranuleSnapshot>& data,
                                                 bool chunked,
                                                 Optional<BlobGranuleCipherKeysCtx> cipherKeys,
-                                                Optional<CompressionFilter> compressionFilter) {
+                                                Optional<CompressionFilter> compressionFilter,
+                                                bool columnar) {
 	Standalone<StringRef> fileNameRef = StringRef();
 	int64_t serializedBytes = 0;
 	double elapsed = -timer_monotonic();
@@ -2896,7 +3100,7 @@ std::pair<int64_t, double> doSnapshotWriteBench(const Standalone<GranuleSnapshot
 			serializedBytes = ObjectWriter::toValue(data, Unversioned()).size();
 		} else {
 			serializedBytes =
-			    serializeChunkedSnapshot(fileNameRef, data, 64 * 1024, compressionFilter, cipherKeys).size();
+			    serializeChunkedSnapshot(fileNameRef, data, 64 * 1024, compressionFilter, cipherKeys, columnar).size();
 		}
 	}
 	elapsed += timer_monotonic();
@@ -2950,7 +3154,8 @@ void chunkFromFileSet(const FileSet& fileSet,
 
 FileSet rewriteChunkedFileSet(const FileSet& fileSet,
                               Optional<BlobGranuleCipherKeysCtx> keys,
-                              Optional<CompressionFilter> compressionFilter) {
+                              Optional<CompressionFilter> compressionFilter,
+                              bool columnar) {
 	Standalone<StringRef> fileNameRef = StringRef();
 	FileSet newFiles;
 	newFiles.snapshotFile = fileSet.snapshotFile;
@@ -2958,8 +3163,8 @@ FileSet rewriteChunkedFileSet(const FileSet& fileSet,
 	newFiles.commonPrefix = fileSet.commonPrefix;
 	newFiles.range = fileSet.range;
 
-	std::get<2>(newFiles.snapshotFile) =
-	    serializeChunkedSnapshot(fileNameRef, std::get<3>(newFiles.snapshotFile), 64 * 1024, compressionFilter, keys);
+	std::get<2>(newFiles.snapshotFile) = serializeChunkedSnapshot(
+	    fileNameRef, std::get<3>(newFiles.snapshotFile), 64 * 1024, compressionFilter, keys, columnar);
 	for (auto& deltaFile : newFiles.deltaFiles) {
 		std::get<2>(deltaFile) = serializeChunkedDeltaFile(
 		    fileNameRef, std::get<3>(deltaFile), fileSet.range, 32 * 1024, compressionFilter, keys);
@@ -3051,6 +3256,26 @@ void printMetrics(int64_t diskBytes, double elapsed, int64_t processesBytes, int
 	fmt::print("{}", fmt::format(" {:.6} {:.6}", storageAmp, MBperCPUsec));
 }
 
+std::string benchRunName(bool chunk, bool encrypt, Optional<CompressionFilter> compressionFilter, bool columnar) {
+	if (!chunk) {
+		return "old";
+	}
+	std::string name;
+	if (encrypt) {
+		name += "ENC";
+	}
+	if (compressionFilter.present() && compressionFilter.get() != CompressionFilter::NONE) {
+		name += "CMP";
+	}
+	if (columnar) {
+		name += "COL";
+	}
+	if (name.empty()) {
+		name = "chunked";
+	}
+	return name;
+}
+
 TEST_CASE("!/blobgranule/files/benchFromFiles") {
 	std::string basePath = "SET_ME";
 	std::vector<std::vector<std::string>> fileSetNames = { { "SET_ME" } };
@@ -3058,6 +3283,7 @@ TEST_CASE("!/blobgranule/files/benchFromFiles") {
 	BlobGranuleCipherKeysCtx cipherKeys = getCipherKeysCtx(ar);
 	std::vector<bool> chunkModes = { false, true };
 	std::vector<bool> encryptionModes = { false, true };
+	std::vector<bool> columnarModes = { false, true };
 	std::vector<Optional<CompressionFilter>> compressionModes;
 	compressionModes.push_back({});
 	compressionModes.insert(
@@ -3094,42 +3320,35 @@ TEST_CASE("!/blobgranule/files/benchFromFiles") {
 				if (compressionFilter.present() && CompressionFilter::NONE == compressionFilter.get()) {
 					continue;
 				}
-
-				std::string name;
-				if (!chunk) {
-					name = "old";
-				} else {
-					if (encrypt) {
-						name += "ENC";
-					}
-					if (compressionFilter.present() && compressionFilter.get() != CompressionFilter::NONE) {
-						name += "CMP";
-					}
-					if (name.empty()) {
-						name = "chunked";
+				for (bool columnar : columnarModes) {
+					if (!chunk && columnar) {
+						continue;
 					}
-				}
-				runNames.push_back(name);
-				int64_t snapshotTotalBytes = 0;
-				double snapshotTotalElapsed = 0.0;
-				for (auto& fileSet : fileSets) {
-					auto res = doSnapshotWriteBench(std::get<3>(fileSet.snapshotFile), chunk, keys, compressionFilter);
-					snapshotTotalBytes += res.first;
-					snapshotTotalElapsed += res.second;
-				}
-				snapshotMetrics.push_back({ snapshotTotalBytes, snapshotTotalElapsed });
 
-				int64_t deltaTotalBytes = 0;
-				double deltaTotalElapsed = 0.0;
-				for (auto& fileSet : fileSets) {
-					for (auto& deltaFile : fileSet.deltaFiles) {
-						auto res =
-						    doDeltaWriteBench(std::get<3>(deltaFile), fileSet.range, chunk, keys, compressionFilter);
-						deltaTotalBytes += res.first;
-						deltaTotalElapsed += res.second;
+					std::string name = benchRunName(chunk, encrypt, compressionFilter, columnar);
+					runNames.push_back(name);
+					int64_t snapshotTotalBytes = 0;
+					double snapshotTotalElapsed = 0.0;
+					for (auto& fileSet : fileSets) {
+						auto res = doSnapshotWriteBench(
+						    std::get<3>(fileSet.snapshotFile), chunk, keys, compressionFilter, columnar);
+						snapshotTotalBytes += res.first;
+						snapshotTotalElapsed += res.second;
 					}
+					snapshotMetrics.push_back({ snapshotTotalBytes, snapshotTotalElapsed });
+
+					int64_t deltaTotalBytes = 0;
+					double deltaTotalElapsed = 0.0;
+					for (auto& fileSet : fileSets) {
+						for (auto& deltaFile : fileSet.deltaFiles) {
+							auto res = doDeltaWriteBench(
+							    std::get<3>(deltaFile), fileSet.range, chunk, keys, compressionFilter);
+							deltaTotalBytes += res.first;
+							deltaTotalElapsed += res.second;
+						}
+					}
+					deltaMetrics.push_back({ deltaTotalBytes, deltaTotalElapsed });
 				}
-				deltaMetrics.push_back({ deltaTotalBytes, deltaTotalElapsed });
 			}
 		}
 	}
@@ -3183,69 +3402,65 @@ TEST_CASE("!/blobgranule/files/benchFromFiles") {
 				if (compressionFilter.present() && CompressionFilter::NONE == compressionFilter.get()) {
 					continue;
 				}
-				std::string name;
-				if (!chunk) {
-					name = "old";
-				} else {
-					if (encrypt) {
-						name += "ENC";
+				for (bool columnar : columnarModes) {
+					if (!chunk && columnar) {
+						continue;
 					}
-					if (compressionFilter.present() && compressionFilter.get() != CompressionFilter::NONE) {
-						name += "CMP";
+					readRunNames.push_back(benchRunName(chunk, encrypt, compressionFilter, columnar));
+
+					int64_t totalBytesRead = 0;
+					double totalElapsed = 0.0;
+					double totalElapsedClearAll = 0.0;
+					double totalElapsedSingleKey = 0.0;
+					std::vector<std::pair<int64_t, double>> varyingDeltas;
+					for (int i = 0; i <= maxDeltaFiles; i++) {
+						varyingDeltas.push_back({ 0, 0.0 });
 					}
-					if (name.empty()) {
-						name = "chunked";
-					}
-				}
-				readRunNames.push_back(name);
-
-				int64_t totalBytesRead = 0;
-				double totalElapsed = 0.0;
-				double totalElapsedClearAll = 0.0;
-				double totalElapsedSingleKey = 0.0;
-				std::vector<std::pair<int64_t, double>> varyingDeltas;
-				for (int i = 0; i <= maxDeltaFiles; i++) {
-					varyingDeltas.push_back({ 0, 0.0 });
-				}
-				for (auto& fileSet : fileSets) {
-					FileSet newFileSet;
-					if (!chunk) {
-						newFileSet = fileSet;
-					} else {
-						newFileSet = rewriteChunkedFileSet(fileSet, keys, compressionFilter);
-					}
-
-					auto res = doReadBench(newFileSet, chunk, fileSet.range, false, keys, newFileSet.deltaFiles.size());
-					totalBytesRead += res.first;
-					totalElapsed += res.second;
+					for (auto& fileSet : fileSets) {
+						FileSet newFileSet;
+						if (!chunk) {
+							newFileSet = fileSet;
+						} else {
+							newFileSet = rewriteChunkedFileSet(fileSet, keys, compressionFilter, columnar);
+						}
 
-					if (doEdgeCaseReadTests) {
-						totalElapsedClearAll +=
-						    doReadBench(newFileSet, chunk, fileSet.range, true, keys, newFileSet.deltaFiles.size())
-						        .second;
-						Key k = std::get<3>(fileSet.snapshotFile).front().key;
-						KeyRange singleKeyRange(KeyRangeRef(k, keyAfter(k)));
-						totalElapsedSingleKey +=
-						    doReadBench(newFileSet, chunk, singleKeyRange, false, keys, newFileSet.deltaFiles.size())
-						        .second;
-					}
+						auto res =
+						    doReadBench(newFileSet, chunk, fileSet.range, false, keys, newFileSet.deltaFiles.size());
+						totalBytesRead += res.first;
+						totalElapsed += res.second;
+
+						if (doEdgeCaseReadTests) {
+							totalElapsedClearAll +=
+							    doReadBench(newFileSet, chunk, fileSet.range, true, keys, newFileSet.deltaFiles.size())
+							        .second;
+							Key k = std::get<3>(fileSet.snapshotFile).front().key;
+							KeyRange singleKeyRange(KeyRangeRef(k, keyAfter(k)));
+							totalElapsedSingleKey += doReadBench(newFileSet,
+							                                     chunk,
+							                                     singleKeyRange,
+							                                     false,
+							                                     keys,
+							                                     newFileSet.deltaFiles.size())
+							                             .second;
+						}
 
-					if (doVaryingDeltaTests && chunk) {
-						for (int i = 0; i <= maxDeltaFiles; i++) {
-							auto r = doReadBench(newFileSet, chunk, fileSet.range, false, keys, i);
-							varyingDeltas[i].first += r.first;
-							varyingDeltas[i].second += r.second;
+						if (doVaryingDeltaTests && chunk) {
+							for (int i = 0; i <= maxDeltaFiles; i++) {
+								auto r = doReadBench(newFileSet, chunk, fileSet.range, false, keys, i);
+								varyingDeltas[i].first += r.first;
+								varyingDeltas[i].second += r.second;
+							}
 						}
 					}
-				}
-				readMetrics.push_back({ totalBytesRead, totalElapsed });
+					readMetrics.push_back({ totalBytesRead, totalElapsed });
 
-				if (doEdgeCaseReadTests) {
-					clearAllReadMetrics.push_back(totalElapsedClearAll);
-					readSingleKeyMetrics.push_back(totalElapsedSingleKey);
-				}
-				if (doVaryingDeltaTests) {
-					varyingDeltaMetrics.push_back(varyingDeltas);
+					if (doEdgeCaseReadTests) {
+						clearAllReadMetrics.push_back(totalElapsedClearAll);
+						readSingleKeyMetrics.push_back(totalElapsedSingleKey);
+					}
+					if (doVaryingDeltaTests) {
+						varyingDeltaMetrics.push_back(varyingDeltas);
+					}
 				}
 			}
 		}
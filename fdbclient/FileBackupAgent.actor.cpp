@@ -37,6 +37,7 @@
 
 #include "flow/Arena.h"
 #include "flow/CodeProbe.h"
+#include "flow/CompressionUtils.h"
 #include "flow/EncryptUtils.h"
 #include "flow/network.h"
 #include "flow/ObjectSerializer.h"
@@ -3844,6 +3845,33 @@ std::vector<MutationRef> decodeMutationLogValue(const StringRef& value) {
 	return mutations;
 }
 
+Standalone<StringRef> decodePartitionedLogBlock(Standalone<StringRef> block) {
+	StringRefReader reader(block, restore_corrupted_data());
+	const uint32_t version = reader.consume<uint32_t>();
+	if (version == PARTITIONED_MLOG_VERSION) {
+		return Standalone<StringRef>(reader.remainder(), block.arena());
+	}
+	if (version != PARTITIONED_MLOG_COMPRESSED_VERSION) {
+		throw restore_unsupported_file_version();
+	}
+
+	const int32_t filter = reader.consume<int32_t>();
+	const int32_t compressedSize = reader.consume<int32_t>();
+	if (filter <= (int32_t)CompressionFilter::NONE || filter >= (int32_t)CompressionFilter::LAST ||
+	    !CompressionUtils::supportedFilters.count((CompressionFilter)filter)) {
+		throw restore_unsupported_file_version();
+	}
+	StringRef compressed(reader.consume(compressedSize), compressedSize);
+	for (auto b : reader.remainder()) {
+		if (b != 0xFF)
+			throw restore_corrupted_data_padding();
+	}
+
+	Standalone<StringRef> mutations;
+	mutations.contents() = CompressionUtils::decompress((CompressionFilter)filter, compressed, mutations.arena());
+	return mutations;
+}
+
 void AccumulatedMutations::addChunk(int chunkNumber, const KeyValueRef& kv) {
 	if (chunkNumber == lastChunkNumber + 1) {
 		lastChunkNumber = chunkNumber;
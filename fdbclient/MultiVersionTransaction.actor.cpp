@@ -88,6 +88,26 @@ ThreadFuture<Optional<Value>> DLTransaction::get(const KeyRef& key, bool snapsho
 	});
 }
 
+ThreadFuture<RangeResult> DLTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	if (!api->transactionGetMulti) {
+		return unsupported_operation();
+	}
+	// KeyRef has the same layout as FDBKey
+	FdbCApi::FDBFuture* f =
+	    api->transactionGetMulti(tr, (const FdbCApi::FDBKey*)keys.begin(), keys.size(), snapshot);
+
+	return toThreadFuture<RangeResult>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBKeyValue* kvs;
+		int count;
+		FdbCApi::fdb_bool_t more;
+		FdbCApi::fdb_error_t error = api->futureGetKeyValueArray(f, &kvs, &count, &more);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return RangeResult(RangeResultRef(VectorRef<KeyValueRef>((KeyValueRef*)kvs, count), more), Arena());
+	});
+}
+
 ThreadFuture<Key> DLTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	FdbCApi::FDBFuture* f =
 	    api->transactionGetKey(tr, key.getKey().begin(), key.getKey().size(), key.orEqual, key.offset, snapshot);
@@ -944,6 +964,9 @@ void DLApi::init() {
 	loadClientFunction(
 	    &api->transactionGetReadVersion, lib, fdbCPath, "fdb_transaction_get_read_version", headerVersion >= 0);
 	loadClientFunction(&api->transactionGet, lib, fdbCPath, "fdb_transaction_get", headerVersion >= 0);
+	// Optional: external clients released at the same API version predate it, and getMulti() reports
+	// unsupported_operation for them
+	loadClientFunction(&api->transactionGetMulti, lib, fdbCPath, "fdb_transaction_get_multi", false);
 	loadClientFunction(&api->transactionGetKey, lib, fdbCPath, "fdb_transaction_get_key", headerVersion >= 0);
 	loadClientFunction(&api->transactionGetAddressesForKey,
 	                   lib,
@@ -1270,6 +1293,12 @@ ThreadFuture<Optional<Value>> MultiVersionTransaction::get(const KeyRef& key, bo
 	return abortableFuture(f, tr.onChange);
 }
 
+ThreadFuture<RangeResult> MultiVersionTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	auto tr = getTransaction();
+	auto f = tr.transaction ? tr.transaction->getMulti(keys, snapshot) : makeTimeout<RangeResult>();
+	return abortableFuture(f, tr.onChange);
+}
+
 ThreadFuture<Key> MultiVersionTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	auto tr = getTransaction();
 	auto f = tr.transaction ? tr.transaction->getKey(key, snapshot) : makeTimeout<Key>();
@@ -2322,6 +2351,131 @@ void MultiVersionDatabase::LegacyVersionMonitor::close() {
 	}
 }
 
+// ThreadShardedTenant
+ThreadShardedTenant::ThreadShardedTenant(std::vector<Reference<ITenant>> shards)
+  : shards(std::move(shards)), nextShard(0) {
+	ASSERT(!this->shards.empty());
+}
+
+Reference<ITransaction> ThreadShardedTenant::createTransaction() {
+	return shards[nextShard.fetch_add(1, std::memory_order_relaxed) % shards.size()]->createTransaction();
+}
+
+ThreadFuture<Key> ThreadShardedTenant::purgeBlobGranules(const KeyRangeRef& keyRange,
+                                                         Version purgeVersion,
+                                                         bool force) {
+	return shards[0]->purgeBlobGranules(keyRange, purgeVersion, force);
+}
+
+ThreadFuture<Void> ThreadShardedTenant::waitPurgeGranulesComplete(const KeyRef& purgeKey) {
+	return shards[0]->waitPurgeGranulesComplete(purgeKey);
+}
+
+ThreadFuture<bool> ThreadShardedTenant::blobbifyRange(const KeyRangeRef& keyRange) {
+	return shards[0]->blobbifyRange(keyRange);
+}
+
+ThreadFuture<bool> ThreadShardedTenant::unblobbifyRange(const KeyRangeRef& keyRange) {
+	return shards[0]->unblobbifyRange(keyRange);
+}
+
+ThreadFuture<Standalone<VectorRef<KeyRangeRef>>> ThreadShardedTenant::listBlobbifiedRanges(const KeyRangeRef& keyRange,
+                                                                                           int rangeLimit) {
+	return shards[0]->listBlobbifiedRanges(keyRange, rangeLimit);
+}
+
+ThreadFuture<Version> ThreadShardedTenant::verifyBlobRange(const KeyRangeRef& keyRange, Optional<Version> version) {
+	return shards[0]->verifyBlobRange(keyRange, version);
+}
+
+// ThreadShardedDatabase
+ThreadShardedDatabase::ThreadShardedDatabase(std::vector<Reference<IDatabase>> shards)
+  : shards(std::move(shards)), nextShard(0) {
+	ASSERT(!this->shards.empty());
+}
+
+Reference<ITenant> ThreadShardedDatabase::openTenant(TenantNameRef tenantName) {
+	std::vector<Reference<ITenant>> tenants;
+	tenants.reserve(shards.size());
+	for (auto& shard : shards) {
+		tenants.push_back(shard->openTenant(tenantName));
+	}
+	return makeReference<ThreadShardedTenant>(std::move(tenants));
+}
+
+Reference<ITransaction> ThreadShardedDatabase::createTransaction() {
+	return shards[nextShard.fetch_add(1, std::memory_order_relaxed) % shards.size()]->createTransaction();
+}
+
+void ThreadShardedDatabase::setOption(FDBDatabaseOptions::Option option, Optional<StringRef> value) {
+	for (auto& shard : shards) {
+		shard->setOption(option, value);
+	}
+}
+
+// Returns the average busyness of the shards' network threads, since transactions are spread evenly across them
+double ThreadShardedDatabase::getMainThreadBusyness() {
+	double busyness = 0.0;
+	for (auto& shard : shards) {
+		busyness += shard->getMainThreadBusyness();
+	}
+	return busyness / shards.size();
+}
+
+ThreadFuture<ProtocolVersion> ThreadShardedDatabase::getServerProtocol(Optional<ProtocolVersion> expectedVersion) {
+	return shards[0]->getServerProtocol(expectedVersion);
+}
+
+ThreadFuture<int64_t> ThreadShardedDatabase::rebootWorker(const StringRef& address, bool check, int duration) {
+	return shards[0]->rebootWorker(address, check, duration);
+}
+
+ThreadFuture<Void> ThreadShardedDatabase::forceRecoveryWithDataLoss(const StringRef& dcid) {
+	return shards[0]->forceRecoveryWithDataLoss(dcid);
+}
+
+ThreadFuture<Void> ThreadShardedDatabase::createSnapshot(const StringRef& uid, const StringRef& snapshot_command) {
+	return shards[0]->createSnapshot(uid, snapshot_command);
+}
+
+ThreadFuture<Key> ThreadShardedDatabase::purgeBlobGranules(const KeyRangeRef& keyRange,
+                                                           Version purgeVersion,
+                                                           bool force) {
+	return shards[0]->purgeBlobGranules(keyRange, purgeVersion, force);
+}
+
+ThreadFuture<Void> ThreadShardedDatabase::waitPurgeGranulesComplete(const KeyRef& purgeKey) {
+	return shards[0]->waitPurgeGranulesComplete(purgeKey);
+}
+
+ThreadFuture<bool> ThreadShardedDatabase::blobbifyRange(const KeyRangeRef& keyRange) {
+	return shards[0]->blobbifyRange(keyRange);
+}
+
+ThreadFuture<bool> ThreadShardedDatabase::unblobbifyRange(const KeyRangeRef& keyRange) {
+	return shards[0]->unblobbifyRange(keyRange);
+}
+
+ThreadFuture<Standalone<VectorRef<KeyRangeRef>>> ThreadShardedDatabase::listBlobbifiedRanges(
+    const KeyRangeRef& keyRange,
+    int rangeLimit) {
+	return shards[0]->listBlobbifiedRanges(keyRange, rangeLimit);
+}
+
+ThreadFuture<Version> ThreadShardedDatabase::verifyBlobRange(const KeyRangeRef& keyRange, Optional<Version> version) {
+	return shards[0]->verifyBlobRange(keyRange, version);
+}
+
+ThreadFuture<DatabaseSharedState*> ThreadShardedDatabase::createSharedState() {
+	return shards[0]->createSharedState();
+}
+
+void ThreadShardedDatabase::setSharedState(DatabaseSharedState* p) {
+	for (auto& shard : shards) {
+		shard->setSharedState(p);
+	}
+}
+
 // MultiVersionApi
 void MultiVersionApi::runOnExternalClientsAllThreads(std::function<void(Reference<ClientInfo>)> func,
                                                      bool runOnFailedClients,
@@ -2648,6 +2802,13 @@ void MultiVersionApi::setNetworkOptionInternal(FDBNetworkOptions::Option option,
 		// multiple client threads are not supported on windows.
 		threadCount = extractIntOption(value, 1, 1);
 #endif
+	} else if (option == FDBNetworkOptions::CLIENT_THREADS_SHARD_DATABASES) {
+		MutexHolder holder(lock);
+		validateOption(value, false, true);
+		if (networkStartSetup) {
+			throw invalid_option();
+		}
+		shardDatabasesAcrossThreads = true;
 	} else if (option == FDBNetworkOptions::CLIENT_TMP_DIR) {
 		validateOption(value, true, false, false);
 		tmpDir = abspath(value.get().toString());
@@ -2908,6 +3069,19 @@ Reference<IDatabase> MultiVersionApi::createDatabase(ClusterConnectionRecord con
 	if (localClientDisabled) {
 		ASSERT(!bypassMultiClientApi);
 
+		if (shardDatabasesAcrossThreads && threadCount > 1) {
+			lock.leave();
+
+			std::vector<Reference<IDatabase>> shards;
+			shards.reserve(threadCount);
+			for (int threadIdx = 0; threadIdx < threadCount; threadIdx++) {
+				Reference<IDatabase> localDb = connectionRecord.createDatabase(localClient->api);
+				shards.push_back(Reference<IDatabase>(
+				    new MultiVersionDatabase(this, threadIdx, connectionRecord, Reference<IDatabase>(), localDb)));
+			}
+			return makeReference<ThreadShardedDatabase>(std::move(shards));
+		}
+
 		int threadIdx = nextThread;
 		nextThread = (nextThread + 1) % threadCount;
 		lock.leave();
@@ -3145,8 +3319,8 @@ void MultiVersionApi::loadEnvironmentVariableNetworkOptions() {
 MultiVersionApi::MultiVersionApi()
   : callbackOnMainThread(true), localClientDisabled(false), networkStartSetup(false), networkSetup(false),
     disableBypass(false), bypassMultiClientApi(false), externalClient(false), ignoreExternalClientFailures(false),
-    retainClientLibCopies(false), apiVersion(0), threadCount(0), tmpDir("/tmp"), traceShareBaseNameAmongThreads(false),
-    envOptionsLoaded(false) {}
+    retainClientLibCopies(false), apiVersion(0), threadCount(0), shardDatabasesAcrossThreads(false), tmpDir("/tmp"),
+    traceShareBaseNameAmongThreads(false), envOptionsLoaded(false) {}
 
 MultiVersionApi* MultiVersionApi::api = new MultiVersionApi();
 
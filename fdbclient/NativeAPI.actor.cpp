@@ -634,6 +634,8 @@ ACTOR Future<Void> tssLogger(DatabaseContext* cx) {
 			it.second->cc.logToTraceEvent(tssEv);
 
 			traceTSSPercentiles(tssEv, "GetValueLatency", it.second->SSgetValueLatency, it.second->TSSgetValueLatency);
+			traceTSSPercentiles(
+			    tssEv, "GetValuesLatency", it.second->SSgetValuesLatency, it.second->TSSgetValuesLatency);
 			traceTSSPercentiles(
 			    tssEv, "GetKeyValuesLatency", it.second->SSgetKeyValuesLatency, it.second->TSSgetKeyValuesLatency);
 			traceTSSPercentiles(tssEv, "GetKeyLatency", it.second->SSgetKeyLatency, it.second->TSSgetKeyLatency);
@@ -3503,6 +3505,166 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 	}
 }
 
+ACTOR Future<RangeResult> getValues(Reference<TransactionState> trState,
+                                    Standalone<VectorRef<KeyRef>> keys,
+                                    Future<Version> version,
+                                    UseTenant useTenant);
+
+// Reads keys, which are sorted and all on the storage team locations, with one GetValuesRequest. If the locations turn
+// out to be stale, the keys are looked up and read again through getValues().
+ACTOR Future<RangeResult> getValuesFromTeam(Reference<TransactionState> trState,
+                                            Reference<LocationInfo> locations,
+                                            Key tenantPrefix,
+                                            Standalone<VectorRef<KeyRef>> keys,
+                                            Version ver,
+                                            UseTenant useTenant,
+                                            SpanContext spanContext) {
+	// Cached ranges are only served one key at a time
+	if (locations->hasCaches) {
+		std::vector<Future<Optional<Value>>> values;
+		values.reserve(keys.size());
+		for (const KeyRef& key : keys) {
+			values.push_back(getValue(trState, key, ver, useTenant, TransactionRecordLogInfo::True));
+		}
+		RangeResult result = wait(getMultiFromValues(keys, values));
+		return result;
+	}
+
+	state uint64_t startTime = timer_int();
+	state double startTimeD = now();
+	state VersionVector ssLatestCommitVersions;
+	trState->cx->getLatestCommitVersions(locations, ver, trState, ssLatestCommitVersions);
+
+	try {
+		state GetValuesRequest req;
+		req.spanContext = spanContext;
+		req.tenantInfo = useTenant ? trState->getTenantInfo() : TenantInfo();
+		req.arena.dependsOn(keys.arena());
+		req.keys = keys;
+		req.version = ver;
+		req.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
+		req.options = trState->readOptions;
+		req.ssLatestCommitVersions = ssLatestCommitVersions;
+
+		++trState->cx->getValueSubmitted;
+		++trState->cx->transactionPhysicalReads;
+		state GetValuesReply reply;
+		try {
+			if (CLIENT_BUGGIFY_WITH_PROB(.01)) {
+				throw deterministicRandom()->randomChoice(
+				    std::vector<Error>{ transaction_too_old(), future_version() });
+			}
+			choose {
+				when(wait(trState->cx->connectionFileChanged())) { throw transaction_too_old(); }
+				when(GetValuesReply _reply = wait(loadBalance(
+				         trState->cx.getPtr(),
+				         locations,
+				         &StorageServerInterface::getValues,
+				         req,
+				         TaskPriority::DefaultPromiseEndpoint,
+				         AtMostOnce::False,
+				         trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr))) {
+					reply = _reply;
+				}
+			}
+			++trState->cx->transactionPhysicalReadsCompleted;
+		} catch (Error&) {
+			++trState->cx->transactionPhysicalReadsCompleted;
+			throw;
+		}
+
+		trState->cx->readLatencies.addSample(now() - startTimeD);
+		trState->cx->getValueCompleted->latency = timer_int() - startTime;
+		trState->cx->getValueCompleted->log();
+
+		int64_t bytesRead = 0;
+		for (const KeyValueRef& kv : reply.data) {
+			bytesRead += kv.value.size();
+		}
+		trState->totalCost += getReadOperationCost(keys.expectedSize() + bytesRead);
+		trState->cx->transactionBytesRead += bytesRead;
+		trState->cx->transactionKeysRead += keys.size();
+		return RangeResult(RangeResultRef(reply.data, false), reply.arena);
+	} catch (Error& e) {
+		trState->cx->getValueCompleted->latency = timer_int() - startTime;
+		trState->cx->getValueCompleted->log();
+		if (e.code() == error_code_wrong_shard_server || e.code() == error_code_all_alternatives_failed ||
+		    (e.code() == error_code_transaction_too_old && ver == latestVersion)) {
+			for (const KeyRef& key : keys) {
+				trState->cx->invalidateCache(tenantPrefix, key);
+			}
+			wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY, trState->taskID));
+		} else if (e.code() == error_code_unknown_tenant) {
+			ASSERT(useTenant);
+			wait(trState->handleUnknownTenant());
+		} else {
+			throw e;
+		}
+	}
+
+	RangeResult result = wait(getValues(trState, keys, ver, useTenant));
+	return result;
+}
+
+// Reads the sorted, unique keys by grouping them by the storage team which holds them and sending one request to each
+ACTOR Future<RangeResult> getValues(Reference<TransactionState> trState,
+                                    Standalone<VectorRef<KeyRef>> keys,
+                                    Future<Version> version,
+                                    UseTenant useTenant) {
+	state Version ver = wait(version);
+	state Span span("NAPI:getValues"_loc, trState->spanContext);
+	if (useTenant && trState->tenant().present()) {
+		span.addAttribute("tenant"_sr, trState->tenant().get());
+	}
+	trState->cx->validateVersion(ver);
+
+	// Since keys are sorted, each location lookup covers every following key in the same shard
+	state std::vector<std::pair<KeyRangeLocationInfo, Standalone<VectorRef<KeyRef>>>> teams;
+	state std::map<std::vector<UID>, int> teamIndex; // Keyed by the sorted IDs of each team's storage servers
+	state int i = 0;
+	while (i < keys.size()) {
+		KeyRangeLocationInfo locationInfo = wait(
+		    getKeyLocation(trState, keys[i], &StorageServerInterface::getValues, Reverse::False, useTenant, ver));
+		// Shards served by the same storage servers share one request
+		std::vector<UID> teamID;
+		teamID.reserve(locationInfo.locations->size());
+		for (int s = 0; s < locationInfo.locations->size(); s++) {
+			teamID.push_back(locationInfo.locations->getId(s));
+		}
+		std::sort(teamID.begin(), teamID.end());
+		auto team = teamIndex.try_emplace(std::move(teamID), teams.size());
+		if (team.second) {
+			teams.emplace_back(locationInfo, Standalone<VectorRef<KeyRef>>());
+			teams.back().second.arena().dependsOn(keys.arena());
+		}
+		Standalone<VectorRef<KeyRef>>& teamKeys = teams[team.first->second].second;
+		do {
+			teamKeys.push_back(teamKeys.arena(), keys[i++]);
+		} while (i < keys.size() && locationInfo.range.contains(keys[i]));
+	}
+
+	std::vector<Future<RangeResult>> replies;
+	replies.reserve(teams.size());
+	for (const auto& team : teams) {
+		replies.push_back(getValuesFromTeam(trState,
+		                                    team.first.locations,
+		                                    team.first.tenantEntry.prefix,
+		                                    team.second,
+		                                    ver,
+		                                    useTenant,
+		                                    span.context));
+	}
+	std::vector<RangeResult> results = wait(getAll(replies));
+
+	RangeResult result;
+	for (const RangeResult& r : results) {
+		result.arena().dependsOn(r.arena());
+		result.append(result.arena(), r.begin(), r.size());
+	}
+	std::sort(result.begin(), result.end(), KeyValueRef::OrderByKey());
+	return result;
+}
+
 ACTOR Future<Key> getKey(Reference<TransactionState> trState,
                          KeySelector k,
                          Future<Version> version,
@@ -5361,6 +5523,48 @@ Future<Optional<Value>> Transaction::get(const Key& key, Snapshot snapshot) {
 	return getValue(trState, key, ver, useTenant);
 }
 
+Future<RangeResult> Transaction::getMulti(Standalone<VectorRef<KeyRef>> keys, Snapshot snapshot) {
+	for (const KeyRef& key : keys) {
+		if (key == metadataVersionKey) {
+			// The metadata version key is answered by get() from the metadata version cache
+			std::vector<Future<Optional<Value>>> values;
+			values.reserve(keys.size());
+			for (const KeyRef& k : keys) {
+				values.push_back(get(k, snapshot));
+			}
+			return getMultiFromValues(keys, values);
+		}
+	}
+
+	++trState->cx->transactionLogicalReads;
+	trState->cx->transactionGetValueRequests += keys.size();
+
+	Standalone<VectorRef<KeyRef>> readKeys;
+	readKeys.arena().dependsOn(keys.arena());
+	readKeys.reserve(readKeys.arena(), keys.size());
+	for (const KeyRef& key : keys) {
+		// There are no keys in the database with size greater than the max key size
+		if (key.size() <= getMaxReadKeySize(key)) {
+			readKeys.push_back(readKeys.arena(), key);
+		}
+	}
+	std::sort(readKeys.begin(), readKeys.end());
+	readKeys.resize(readKeys.arena(), std::unique(readKeys.begin(), readKeys.end()) - readKeys.begin());
+
+	auto ver = getReadVersion();
+
+	if (!snapshot) {
+		for (const KeyRef& key : readKeys) {
+			tr.transaction.read_conflict_ranges.push_back(tr.arena, singleKeyRange(key, tr.arena));
+		}
+	}
+
+	if (readKeys.empty()) {
+		return RangeResult();
+	}
+	return getValues(trState, readKeys, ver, UseTenant::True);
+}
+
 void Watch::setWatch(Future<Void> watchFuture) {
 	this->watchFuture = watchFuture;
 
@@ -10965,6 +11169,27 @@ int64_t getMaxReadKeySize(KeyRef const& key) {
 	return getMaxKeySize(key);
 }
 
+Future<RangeResult> getMultiFromValues(Standalone<VectorRef<KeyRef>> keys,
+                                       std::vector<Future<Optional<Value>>> values) {
+	return map(getAll(values), [keys](const std::vector<Optional<Value>>& results) {
+		RangeResult result;
+		result.arena().dependsOn(keys.arena());
+		for (int i = 0; i < keys.size(); ++i) {
+			if (results[i].present()) {
+				result.arena().dependsOn(results[i].get().arena());
+				result.push_back(result.arena(), KeyValueRef(keys[i], results[i].get()));
+			}
+		}
+		std::sort(result.begin(), result.end(), KeyValueRef::OrderByKey());
+		result.resize(result.arena(),
+		              std::unique(result.begin(),
+		                          result.end(),
+		                          [](const KeyValueRef& a, const KeyValueRef& b) { return a.key == b.key; }) -
+		                  result.begin());
+		return result;
+	});
+}
+
 int64_t getMaxWriteKeySize(KeyRef const& key, bool hasRawAccess) {
 	int64_t tenantSize = hasRawAccess ? TenantMapEntry::PREFIX_SIZE : 0;
 	return key.startsWith(systemKeys.begin) ? CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT
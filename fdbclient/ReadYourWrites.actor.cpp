@@ -396,6 +396,58 @@ public:
 		return readWithConflictRangeRYW(ryw, req, snapshot);
 	}
 
+	// Reads all the keys which the snapshot cache knows nothing about with one multi-get on the underlying transaction,
+	// then reads each key through the usual path, which finds it in the cache
+	ACTOR static Future<RangeResult> getMulti(ReadYourWritesTransaction* ryw,
+	                                          Standalone<VectorRef<KeyRef>> keys,
+	                                          Snapshot snapshot) {
+		if (ryw->options.readYourWritesDisabled) {
+			choose {
+				when(RangeResult result = wait(ryw->tr.getMulti(keys, snapshot))) { return result; }
+				when(wait(ryw->resetPromise.getFuture())) { throw internal_error(); }
+			}
+		}
+
+		state Standalone<VectorRef<KeyRef>> unknownKeys;
+		unknownKeys.arena().dependsOn(keys.arena());
+		SnapshotCache::iterator it(&ryw->cache, &ryw->writes);
+		for (const KeyRef& key : keys) {
+			it.skip(key);
+			if (it.is_unknown_range()) {
+				unknownKeys.push_back(unknownKeys.arena(), key);
+			}
+		}
+
+		if (!unknownKeys.empty()) {
+			state RangeResult fetched;
+			choose {
+				when(RangeResult _fetched = wait(ryw->tr.getMulti(unknownKeys, Snapshot::True))) {
+					fetched = _fetched;
+				}
+				when(wait(ryw->resetPromise.getFuture())) { throw internal_error(); }
+			}
+
+			ryw->arena.dependsOn(fetched.arena());
+			for (const KeyRef& key : unknownKeys) {
+				KeyRef k(ryw->arena, key);
+				auto kv = std::lower_bound(fetched.begin(), fetched.end(), key, KeyValueRef::OrderByKey());
+				if (kv != fetched.end() && kv->key == key) {
+					ryw->cache.insert(k, kv->value);
+				} else {
+					ryw->cache.insert(k, Optional<ValueRef>());
+				}
+			}
+		}
+
+		std::vector<Future<Optional<Value>>> values;
+		values.reserve(keys.size());
+		for (const KeyRef& key : keys) {
+			values.push_back(readWithConflictRange(ryw, GetValueReq(key), snapshot));
+		}
+		RangeResult result = wait(getMultiFromValues(keys, values));
+		return result;
+	}
+
 	template <class Iter>
 	static void resolveKeySelectorFromCache(KeySelector& key,
 	                                        Iter& it,
@@ -1604,6 +1656,26 @@ Future<Optional<Value>> ReadYourWritesTransaction::get(const Key& key, Snapshot
 	return result;
 }
 
+Future<RangeResult> ReadYourWritesTransaction::getMulti(Standalone<VectorRef<KeyRef>> keys, Snapshot snapshot) {
+	if (checkUsedDuringCommit()) {
+		return used_during_commit();
+	}
+
+	if (resetPromise.isSet())
+		return resetPromise.getFuture().getError();
+
+	for (const KeyRef& key : keys) {
+		// Special keys, the metadata version key and illegal keys are handled by get()
+		if (key >= getMaxReadKey() || key == metadataVersionKey) {
+			return ISingleThreadTransaction::getMulti(keys, snapshot);
+		}
+	}
+
+	Future<RangeResult> result = RYWImpl::getMulti(this, keys, snapshot);
+	reading.add(success(result));
+	return result;
+}
+
 Future<Key> ReadYourWritesTransaction::getKey(const KeySelector& key, Snapshot snapshot) {
 	if (checkUsedDuringCommit()) {
 		return used_during_commit();
@@ -84,9 +84,15 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES,            2e9 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES = 2e6;
 	init( TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK,           100 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK = 1;
 	init( TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH,           16<<10 ); if ( randomize && BUGGIFY ) TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH = 500;
+	init( TLOG_SPILL_BY_VALUE_COMPRESSION_FILTER,             "NONE" ); if ( randomize && BUGGIFY ) TLOG_SPILL_BY_VALUE_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
+	init( TLOG_QUEUE_COMPRESSION_FILTER,                      "NONE" ); if ( randomize && BUGGIFY ) TLOG_QUEUE_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
+	init( TLOG_QUEUE_COMPRESSION_MIN_BYTES,                     1024 ); if ( randomize && BUGGIFY ) TLOG_QUEUE_COMPRESSION_MIN_BYTES = 0;
+	init( TLOG_PEEK_CACHE_BYTES,                                50e6 ); if ( randomize && BUGGIFY ) TLOG_PEEK_CACHE_BYTES = deterministicRandom()->coinflip() ? 0 : 1e6;
+	init( PUSH_TAG_MESSAGE_INDEX,                              false ); if ( randomize && BUGGIFY ) PUSH_TAG_MESSAGE_INDEX = true;
 	init( DISK_QUEUE_FILE_EXTENSION_BYTES,                    10<<20 ); // BUGGIFYd per file within the DiskQueue
 	init( DISK_QUEUE_FILE_SHRINK_BYTES,                      100<<20 ); // BUGGIFYd per file within the DiskQueue
 	init( DISK_QUEUE_MAX_TRUNCATE_BYTES,                     2LL<<30 ); if ( randomize && BUGGIFY ) DISK_QUEUE_MAX_TRUNCATE_BYTES = 0;
+	init( DISK_QUEUE_RECOVERY_READ_AHEAD,                       true ); if ( randomize && BUGGIFY ) DISK_QUEUE_RECOVERY_READ_AHEAD = false;
 	init( TLOG_DEGRADED_DURATION,                                5.0 );
 	init( MAX_CACHE_VERSIONS,                                   10e6 );
 	init( TLOG_IGNORE_POP_AUTO_ENABLE_DELAY,                   300.0 );
@@ -102,6 +108,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( PEEK_STATS_INTERVAL,                                  10.0 );
 	init( PEEK_STATS_SLOW_AMOUNT,                                  2 );
 	init( PEEK_STATS_SLOW_RATIO,                                 0.5 );
+	init( PEEK_COMPRESSION_FILTER,                            "NONE" ); if ( randomize && BUGGIFY ) PEEK_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
+	init( PEEK_COMPRESSION_MIN_BYTES,                           4096 ); if ( randomize && BUGGIFY ) PEEK_COMPRESSION_MIN_BYTES = 0;
+	init( PEEK_COMPRESSION_CACHE_BYTES,                         50e6 ); if ( randomize && BUGGIFY ) PEEK_COMPRESSION_CACHE_BYTES = 0;
 	// Buggified value must be larger than the amount of simulated time taken by snapshots, to prevent repeatedly failing
 	// snapshots due to closed commit proxy connections
 	init( PUSH_RESET_INTERVAL,                                 300.0 ); if ( randomize && BUGGIFY ) PUSH_RESET_INTERVAL = 40.0;
@@ -554,6 +563,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SAMPLE_EXPIRATION_TIME,                                1.0 );
 	init( SAMPLE_POLL_TIME,                                      0.1 );
 	init( RESOLVER_STATE_MEMORY_LIMIT,                           1e6 );
+	init( RESOLVER_CONFLICT_SET_THREADS,                           1 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_SET_THREADS = deterministicRandom()->randomInt(1, 5);
+	init( RESOLVER_PARALLEL_MIN_CONFLICT_RANGES,                1000 ); if( randomize && BUGGIFY ) RESOLVER_PARALLEL_MIN_CONFLICT_RANGES = deterministicRandom()->randomInt(0, 100);
+	init( RESOLVER_CONFLICT_SET_ART,                           false ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_SET_ART = deterministicRandom()->coinflip();
 	init( LAST_LIMITED_RATIO,                                    2.0 );
 
 	// Backup Worker
@@ -562,6 +574,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BACKUP_FILE_BLOCK_BYTES,                       1024 * 1024 );
 	init( BACKUP_LOCK_BYTES,                                     3e9 ); if(randomize && BUGGIFY) BACKUP_LOCK_BYTES = deterministicRandom()->randomInt(1024, 4096) * 15 * 1024;
 	init( BACKUP_UPLOAD_DELAY,                                  10.0 ); if(randomize && BUGGIFY) BACKUP_UPLOAD_DELAY = deterministicRandom()->random01() * 60;
+	init( BACKUP_MAX_CONCURRENT_UPLOADS,                           4 ); if(randomize && BUGGIFY) BACKUP_MAX_CONCURRENT_UPLOADS = deterministicRandom()->randomInt(1, 9);
+	init( BACKUP_LOG_COMPRESSION_FILTER,                      "NONE" ); if(randomize && BUGGIFY) BACKUP_LOG_COMPRESSION_FILTER = CompressionUtils::toString(CompressionUtils::getRandomFilter());
 
 	//Cluster Controller
 	init( CLUSTER_CONTROLLER_LOGGING_DELAY,                      5.0 );
@@ -833,6 +847,11 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	// This exists for flexibility but assigning each ReadType to its own unique priority number makes the most sense
 	// The enumeration is currently: eager, fetch, low, normal, high
 	init( STORAGESERVER_READTYPE_PRIORITY_MAP,           "0,1,2,3,4" );
+	// Point reads which reach the storage engine within STORAGE_SERVER_POINT_READ_BATCH_WINDOW seconds of each other are
+	// sent to it together, sorted, in batches of at most STORAGE_SERVER_POINT_READ_BATCH_MAX keys
+	init( STORAGE_SERVER_BATCH_POINT_READS,                    false ); if( randomize && BUGGIFY ) STORAGE_SERVER_BATCH_POINT_READS = true;
+	init( STORAGE_SERVER_POINT_READ_BATCH_WINDOW,                0.0 ); if( randomize && BUGGIFY ) STORAGE_SERVER_POINT_READ_BATCH_WINDOW = deterministicRandom()->random01() * 0.002;
+	init( STORAGE_SERVER_POINT_READ_BATCH_MAX,                   128 ); if( randomize && BUGGIFY ) STORAGE_SERVER_POINT_READ_BATCH_MAX = deterministicRandom()->randomInt(1, 10);
 
 	//Wait Failure
 	init( MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS,                 250 ); if( randomize && BUGGIFY ) MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS = 2;
@@ -922,6 +941,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FASTRESTORE_TXN_CLEAR_MAX,                             100 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_CLEAR_MAX = deterministicRandom()->random01() * 100 + 1; }
 	init( FASTRESTORE_TXN_RETRY_MAX,                              10 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_RETRY_MAX = deterministicRandom()->random01() * 100 + 1; }
 	init( FASTRESTORE_TXN_EXTRA_DELAY,                           0.0 ); if( randomize && BUGGIFY ) { FASTRESTORE_TXN_EXTRA_DELAY = deterministicRandom()->random01() * 1 + 0.001;}
+	init( FASTRESTORE_APPLIER_SORTED_RUNS,                     false ); if( randomize && BUGGIFY ) { FASTRESTORE_APPLIER_SORTED_RUNS = true; }
+	init( FASTRESTORE_APPLIER_RUN_MUTATIONS,                  100000 ); if( randomize && BUGGIFY ) { FASTRESTORE_APPLIER_RUN_MUTATIONS = deterministicRandom()->randomInt(1, 1000); }
+	init( FASTRESTORE_APPLIER_MERGE_MUTATIONS,                100000 ); if( randomize && BUGGIFY ) { FASTRESTORE_APPLIER_MERGE_MUTATIONS = deterministicRandom()->randomInt(1, 1000); }
 	init( FASTRESTORE_NOT_WRITE_DB,                            false ); // Perf test only: set it to true will cause simulation failure
 	init( FASTRESTORE_USE_RANGE_FILE,                           true ); // Perf test only: set it to false will cause simulation failure
 	init( FASTRESTORE_USE_LOG_FILE,                             true ); // Perf test only: set it to false will cause simulation failure
@@ -945,6 +967,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REDWOOD_DEFAULT_EXTENT_READ_SIZE,              1024 * 1024 );
 	init( REDWOOD_EXTENT_CONCURRENT_READS,                         4 );
 	init( REDWOOD_KVSTORE_RANGE_PREFETCH,                       true );
+	init( REDWOOD_RANGE_READ_AHEAD_MIN_PAGES,                      4 ); if( randomize && BUGGIFY ) { REDWOOD_RANGE_READ_AHEAD_MIN_PAGES = deterministicRandom()->randomInt(0, 3); }
+	init( REDWOOD_RANGE_READ_AHEAD_MAX_PAGES,                     64 ); if( randomize && BUGGIFY ) { REDWOOD_RANGE_READ_AHEAD_MAX_PAGES = deterministicRandom()->randomInt(1, 8); }
 	init( REDWOOD_PAGE_REBUILD_MAX_SLACK,                       0.33 );
 	init( REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES,                    10 );
 	init( REDWOOD_LAZY_CLEAR_MIN_PAGES,                            0 );
@@ -990,6 +1014,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BG_METADATA_SOURCE,                                "knobs" );
 	init( BG_SNAPSHOT_FILE_TARGET_BYTES,                    10000000 ); if( buggifySmallShards ) BG_SNAPSHOT_FILE_TARGET_BYTES = 100000; else if (buggifyMediumGranules) BG_SNAPSHOT_FILE_TARGET_BYTES = 1000000;
 	init( BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES,               64*1024 ); if ( randomize && BUGGIFY ) BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES = BG_SNAPSHOT_FILE_TARGET_BYTES / (1 << deterministicRandom()->randomInt(0, 8));
+	init( BG_SNAPSHOT_COLUMNAR_FORMAT,                         false );
 	init( BG_DELTA_BYTES_BEFORE_COMPACT, BG_SNAPSHOT_FILE_TARGET_BYTES/2 );
 	init( BG_DELTA_FILE_TARGET_BYTES,   BG_DELTA_BYTES_BEFORE_COMPACT/10 );
 	init( BG_DELTA_FILE_TARGET_CHUNK_BYTES,                  32*1024 ); if ( randomize && BUGGIFY ) BG_DELTA_FILE_TARGET_CHUNK_BYTES = BG_DELTA_FILE_TARGET_BYTES / (1 << deterministicRandom()->randomInt(0, 7));
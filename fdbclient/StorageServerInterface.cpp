@@ -55,6 +55,30 @@ void TSS_traceMismatch(TraceEvent& event,
 	    .detail("TSSReply", tss.value.present() ? traceChecksumValue(tss.value.get()) : "missing");
 }
 
+// batched point reads
+template <>
+bool TSS_doCompare(const GetValuesReply& src, const GetValuesReply& tss) {
+	return src.data == tss.data;
+}
+
+template <>
+const char* TSS_mismatchTraceName(const GetValuesRequest& req) {
+	return "TSSMismatchGetValues";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const GetValuesRequest& req,
+                       const GetValuesReply& src,
+                       const GetValuesReply& tss) {
+	event.detail("Keys", req.keys.size())
+	    .detail("FirstKey", req.keys.empty() ? "" : req.keys.front().printable())
+	    .detail("Tenant", req.tenantInfo.name)
+	    .detail("Version", req.version)
+	    .detail("SSReplySize", src.data.size())
+	    .detail("TSSReplySize", tss.data.size());
+}
+
 // key selector reads
 template <>
 bool TSS_doCompare(const GetKeyReply& src, const GetKeyReply& tss) {
@@ -411,6 +435,12 @@ void TSSMetrics::recordLatency(const GetValueRequest& req, double ssLatency, dou
 	TSSgetValueLatency.addSample(tssLatency);
 }
 
+template <>
+void TSSMetrics::recordLatency(const GetValuesRequest& req, double ssLatency, double tssLatency) {
+	SSgetValuesLatency.addSample(ssLatency);
+	TSSgetValuesLatency.addSample(tssLatency);
+}
+
 template <>
 void TSSMetrics::recordLatency(const GetKeyRequest& req, double ssLatency, double tssLatency) {
 	SSgetKeyLatency.addSample(ssLatency);
@@ -363,6 +363,17 @@ ThreadFuture<Optional<Value>> ThreadSafeTransaction::get(const KeyRef& key, bool
 	});
 }
 
+ThreadFuture<RangeResult> ThreadSafeTransaction::getMulti(const VectorRef<KeyRef>& keys, bool snapshot) {
+	Standalone<VectorRef<KeyRef>> k;
+	k.append_deep(k.arena(), keys.begin(), keys.size());
+
+	ISingleThreadTransaction* tr = this->tr;
+	return onMainThread([tr, k, snapshot]() -> Future<RangeResult> {
+		tr->checkDeferredError();
+		return tr->getMulti(k, Snapshot{ snapshot });
+	});
+}
+
 ThreadFuture<Key> ThreadSafeTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	KeySelector k = key;
 
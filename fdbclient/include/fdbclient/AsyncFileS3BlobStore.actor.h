@@ -261,6 +261,8 @@ public:
 };
 
 // This class represents a read-only file that lives in an S3-style blob store.  It reads using the REST API.
+// Reads larger than read_block_size are split into ranged GETs which are issued concurrently, with at most
+// concurrent_reads_per_file blocks worth of bytes in flight for the file.
 class AsyncFileS3BlobStoreRead final : public IAsyncFile, public ReferenceCounted<AsyncFileS3BlobStoreRead> {
 public:
 	void addref() override { ReferenceCounted<AsyncFileS3BlobStoreRead>::addref(); }
@@ -292,9 +294,12 @@ public:
 	std::string m_bucket;
 	std::string m_object;
 	mutable Future<int64_t> m_size;
+	// Bytes of ranged GETs in flight for reads larger than read_block_size
+	FlowLock m_readBytes;
 
 	AsyncFileS3BlobStoreRead(Reference<S3BlobStoreEndpoint> bstore, std::string bucket, std::string object)
-	  : m_bstore(bstore), m_bucket(bucket), m_object(object) {}
+	  : m_bstore(bstore), m_bucket(bucket), m_object(object),
+	    m_readBytes((int64_t)bstore->knobs.concurrent_reads_per_file * bstore->knobs.read_block_size) {}
 };
 
 #include "flow/unactorcompiler.h"
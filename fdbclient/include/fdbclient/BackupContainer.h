@@ -64,6 +64,10 @@ static const uint32_t BACKUP_AGENT_MLOG_VERSION = 2001;
 // Mutation log version written by BackupWorker
 static const uint32_t PARTITIONED_MLOG_VERSION = 4110;
 
+// Compressed mutation log block version written by BackupWorker. The block header is followed by the compression
+// filter and the compressed size (int32 each), then the compressed mutations of a PARTITIONED_MLOG_VERSION block.
+static const uint32_t PARTITIONED_MLOG_COMPRESSED_VERSION = 4111;
+
 // Snapshot file version written by FileBackupAgent
 static const uint32_t BACKUP_AGENT_SNAPSHOT_FILE_VERSION = 1001;
 
@@ -355,6 +359,10 @@ std::pair<Version, int32_t> decodeMutationLogKey(const StringRef& key);
 // where a mutation is encoded as:
 //   [type:uint32_t][keyLength:uint32_t][valueLength:uint32_t][param1][param2]
 std::vector<MutationRef> decodeMutationLogValue(const StringRef& value);
+
+// Returns the mutations of a partitioned mutation log block, i.e., the bytes after the block header, decompressing
+// PARTITIONED_MLOG_COMPRESSED_VERSION blocks. Uncompressed blocks keep their padding.
+Standalone<StringRef> decodePartitionedLogBlock(Standalone<StringRef> block);
 } // namespace fileBackup
 
 #endif
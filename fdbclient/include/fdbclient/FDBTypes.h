@@ -955,6 +955,7 @@ struct TLogVersion {
 		// V5 merged reference and value spilling
 		// V6 added span context to list of serialized mutations sent from proxy to tlogs
 		// V7 use xxhash3 for TLog checksum
+		// V8 allows messages spilled by value to be compressed
 		// V1 = 1,  // 4.6 is dispatched to via 6.0
 		V2 = 2, // 6.0
 		V3 = 3, // 6.1
@@ -962,8 +963,9 @@ struct TLogVersion {
 		V5 = 5, // 6.3
 		V6 = 6, // 7.0
 		V7 = 7, // 7.2
+		V8 = 8, // 7.3
 		MIN_SUPPORTED = V2,
-		MAX_SUPPORTED = V7,
+		MAX_SUPPORTED = V8,
 		MIN_RECRUITABLE = V6,
 		DEFAULT = V6,
 	} version;
@@ -993,6 +995,8 @@ struct TLogVersion {
 			return V6;
 		if (s == "7"_sr)
 			return V7;
+		if (s == "8"_sr)
+			return V8;
 		return default_error_or();
 	}
 };
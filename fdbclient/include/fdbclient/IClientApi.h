@@ -45,6 +45,8 @@ public:
 	// own memory. It is guaranteed, however, that the ThreadFuture will hold a reference to the memory. It will persist
 	// until the ThreadFuture's ThreadSingleAssignmentVar has its memory released or it is destroyed.
 	virtual ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) = 0;
+	// Returns the keys which have a value, in key order
+	virtual ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) = 0;
 	virtual ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) = 0;
 	virtual ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                           const KeySelectorRef& end,
@@ -60,6 +60,15 @@ public:
 	virtual Optional<Version> getCachedReadVersion() const = 0;
 	virtual Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False) = 0;
 	virtual Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False) = 0;
+	// Returns the keys which have a value, in key order. By default this reads each key with get().
+	virtual Future<RangeResult> getMulti(Standalone<VectorRef<KeyRef>> keys, Snapshot snapshot = Snapshot::False) {
+		std::vector<Future<Optional<Value>>> values;
+		values.reserve(keys.size());
+		for (const KeyRef& key : keys) {
+			values.push_back(get(key, snapshot));
+		}
+		return getMultiFromValues(keys, values);
+	}
 	virtual Future<RangeResult> getRange(const KeySelector& begin,
 	                                     const KeySelector& end,
 	                                     int limit,
@@ -260,6 +260,7 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	FDBFuture* (*transactionGetReadVersion)(FDBTransaction* tr);
 
 	FDBFuture* (*transactionGet)(FDBTransaction* tr, uint8_t const* keyName, int keyNameLength, fdb_bool_t snapshot);
+	FDBFuture* (*transactionGetMulti)(FDBTransaction* tr, FDBKey const* keys, int count, fdb_bool_t snapshot);
 	FDBFuture* (*transactionGetKey)(FDBTransaction* tr,
 	                                uint8_t const* keyName,
 	                                int keyNameLength,
@@ -435,6 +436,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -662,6 +664,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMulti(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -1077,6 +1080,72 @@ public:
 	friend class MultiVersionTransaction;
 };
 
+// An implementation of ITenant that opens the tenant on every shard of a ThreadShardedDatabase and spreads its
+// transactions across them.
+class ThreadShardedTenant final : public ITenant, ThreadSafeReferenceCounted<ThreadShardedTenant> {
+public:
+	explicit ThreadShardedTenant(std::vector<Reference<ITenant>> shards);
+
+	Reference<ITransaction> createTransaction() override;
+
+	ThreadFuture<Key> purgeBlobGranules(const KeyRangeRef& keyRange, Version purgeVersion, bool force) override;
+	ThreadFuture<Void> waitPurgeGranulesComplete(const KeyRef& purgeKey) override;
+
+	ThreadFuture<bool> blobbifyRange(const KeyRangeRef& keyRange) override;
+	ThreadFuture<bool> unblobbifyRange(const KeyRangeRef& keyRange) override;
+	ThreadFuture<Standalone<VectorRef<KeyRangeRef>>> listBlobbifiedRanges(const KeyRangeRef& keyRange,
+	                                                                      int rangeLimit) override;
+	ThreadFuture<Version> verifyBlobRange(const KeyRangeRef& keyRange, Optional<Version> version) override;
+
+	void addref() override { ThreadSafeReferenceCounted<ThreadShardedTenant>::addref(); }
+	void delref() override { ThreadSafeReferenceCounted<ThreadShardedTenant>::delref(); }
+
+private:
+	const std::vector<Reference<ITenant>> shards;
+	std::atomic<uint32_t> nextShard;
+};
+
+// An implementation of IDatabase that wraps one MultiVersionDatabase per client thread and spreads transactions across
+// them round-robin, so that a single database is not limited by what one network thread can process. Each shard keeps
+// its own connections and location cache; the GRV cache is shared through the cluster shared state.
+//
+// Database options are applied to every shard. Management and blob granule calls go to the first shard.
+class ThreadShardedDatabase final : public IDatabase, ThreadSafeReferenceCounted<ThreadShardedDatabase> {
+public:
+	explicit ThreadShardedDatabase(std::vector<Reference<IDatabase>> shards);
+
+	Reference<ITenant> openTenant(TenantNameRef tenantName) override;
+	Reference<ITransaction> createTransaction() override;
+	void setOption(FDBDatabaseOptions::Option option, Optional<StringRef> value = Optional<StringRef>()) override;
+	double getMainThreadBusyness() override;
+
+	ThreadFuture<ProtocolVersion> getServerProtocol(
+	    Optional<ProtocolVersion> expectedVersion = Optional<ProtocolVersion>()) override;
+
+	void addref() override { ThreadSafeReferenceCounted<ThreadShardedDatabase>::addref(); }
+	void delref() override { ThreadSafeReferenceCounted<ThreadShardedDatabase>::delref(); }
+
+	ThreadFuture<int64_t> rebootWorker(const StringRef& address, bool check, int duration) override;
+	ThreadFuture<Void> forceRecoveryWithDataLoss(const StringRef& dcid) override;
+	ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) override;
+
+	ThreadFuture<Key> purgeBlobGranules(const KeyRangeRef& keyRange, Version purgeVersion, bool force) override;
+	ThreadFuture<Void> waitPurgeGranulesComplete(const KeyRef& purgeKey) override;
+
+	ThreadFuture<bool> blobbifyRange(const KeyRangeRef& keyRange) override;
+	ThreadFuture<bool> unblobbifyRange(const KeyRangeRef& keyRange) override;
+	ThreadFuture<Standalone<VectorRef<KeyRangeRef>>> listBlobbifiedRanges(const KeyRangeRef& keyRange,
+	                                                                      int rangeLimit) override;
+	ThreadFuture<Version> verifyBlobRange(const KeyRangeRef& keyRange, Optional<Version> version) override;
+
+	ThreadFuture<DatabaseSharedState*> createSharedState() override;
+	void setSharedState(DatabaseSharedState* p) override;
+
+private:
+	const std::vector<Reference<IDatabase>> shards;
+	std::atomic<uint32_t> nextShard;
+};
+
 // An implementation of IClientApi that can choose between multiple different client implementations either provided
 // locally within the primary loaded fdb_c client or through any number of dynamically loaded clients.
 //
@@ -1161,6 +1230,7 @@ private:
 
 	int nextThread = 0;
 	int threadCount;
+	bool shardDatabasesAcrossThreads;
 	std::string tmpDir;
 	bool traceShareBaseNameAmongThreads;
 	std::string traceFileIdentifier;
@@ -317,6 +317,9 @@ public:
 	Optional<Version> getCachedReadVersion() const;
 
 	[[nodiscard]] Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False);
+	// Reads the values of keys, sending one request to each storage team which holds any of them. Returns the keys
+	// which have a value, in key order.
+	[[nodiscard]] Future<RangeResult> getMulti(Standalone<VectorRef<KeyRef>> keys, Snapshot = Snapshot::False);
 	[[nodiscard]] Future<Void> watch(Reference<Watch> watch);
 	[[nodiscard]] Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False);
 	// Future< Optional<KeyValue> > get( const KeySelectorRef& key );
@@ -604,6 +607,10 @@ int64_t getMaxReadKeySize(KeyRef const& key);
 // be allowed to be slighly larger to accommodate the prefix.
 int64_t getMaxWriteKeySize(KeyRef const& key, bool hasRawAccess);
 
+// Combines point reads of keys into the result of a multi-get: the keys which have a value, in key order
+Future<RangeResult> getMultiFromValues(Standalone<VectorRef<KeyRef>> keys,
+                                       std::vector<Future<Optional<Value>>> values);
+
 // Returns the maximum legal size of a key that can be cleared. Keys larger than this will be assumed not to exist.
 int64_t getMaxClearKeySize(KeyRef const& key);
 
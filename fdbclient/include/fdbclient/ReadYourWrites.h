@@ -78,6 +78,7 @@ public:
 	Future<Version> getReadVersion() override;
 	Optional<Version> getCachedReadVersion() const override { return tr.getCachedReadVersion(); }
 	Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False) override;
+	Future<RangeResult> getMulti(Standalone<VectorRef<KeyRef>> keys, Snapshot = Snapshot::False) override;
 	Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False) override;
 	Future<RangeResult> getRange(const KeySelector& begin,
 	                             const KeySelector& end,
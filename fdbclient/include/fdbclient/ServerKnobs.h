@@ -86,9 +86,15 @@ public:
 	int64_t TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BATCHES_PER_PEEK;
 	int64_t TLOG_SPILL_REFERENCE_MAX_BYTES_PER_BATCH;
+	std::string TLOG_SPILL_BY_VALUE_COMPRESSION_FILTER; // Compression of messages V8 TLogs spill by value
+	std::string TLOG_QUEUE_COMPRESSION_FILTER; // Compression of commits V8 TLogs write to their disk queue
+	int TLOG_QUEUE_COMPRESSION_MIN_BYTES; // Smaller commits are written to the disk queue uncompressed
+	int64_t TLOG_PEEK_CACHE_BYTES; // Spilled peek results a TLog keeps for other peekers of the same tag and version
+	bool PUSH_TAG_MESSAGE_INDEX; // Send TLogs the offsets of each tag's messages, so they need not parse every message
 	int64_t DISK_QUEUE_FILE_EXTENSION_BYTES; // When we grow the disk queue, by how many bytes should it grow?
 	int64_t DISK_QUEUE_FILE_SHRINK_BYTES; // When we shrink the disk queue, by how many bytes should it shrink?
 	int64_t DISK_QUEUE_MAX_TRUNCATE_BYTES; // A truncate larger than this will cause the file to be replaced instead.
+	bool DISK_QUEUE_RECOVERY_READ_AHEAD; // Read the next chunk of the queue while the previous one is being recovered
 	double TLOG_DEGRADED_DURATION;
 	int64_t MAX_CACHE_VERSIONS;
 	double TXS_POPPED_MAX_DELAY;
@@ -101,6 +107,9 @@ public:
 	double PEEK_STATS_INTERVAL;
 	double PEEK_STATS_SLOW_AMOUNT;
 	double PEEK_STATS_SLOW_RATIO;
+	std::string PEEK_COMPRESSION_FILTER; // Compression peek cursors ask TLogs and log routers to apply, NONE or ZSTD
+	int PEEK_COMPRESSION_MIN_BYTES; // Peek replies smaller than this are sent uncompressed
+	int64_t PEEK_COMPRESSION_CACHE_BYTES; // Compressed peek replies a TLog or log router keeps for other peekers
 	double PUSH_RESET_INTERVAL;
 	double PUSH_MAX_LATENCY;
 	double PUSH_STATS_INTERVAL;
@@ -459,6 +468,9 @@ public:
 	double SAMPLE_EXPIRATION_TIME;
 	double SAMPLE_POLL_TIME;
 	int64_t RESOLVER_STATE_MEMORY_LIMIT;
+	int RESOLVER_CONFLICT_SET_THREADS; // Number of key-range partitions (and threads) used to resolve a batch
+	int RESOLVER_PARALLEL_MIN_CONFLICT_RANGES; // Smaller batches are resolved on a single thread
+	bool RESOLVER_CONFLICT_SET_ART; // Keep the conflict history in an adaptive radix tree instead of a skip list
 
 	// Backup Worker
 	double BACKUP_TIMEOUT; // master's reaction time for backup failure
@@ -466,6 +478,8 @@ public:
 	int BACKUP_FILE_BLOCK_BYTES;
 	int64_t BACKUP_LOCK_BYTES;
 	double BACKUP_UPLOAD_DELAY;
+	int BACKUP_MAX_CONCURRENT_UPLOADS; // Version ranges a backup worker writes to the backup container at once
+	std::string BACKUP_LOG_COMPRESSION_FILTER; // Compression of partitioned mutation log blocks, NONE or ZSTD
 
 	// Cluster Controller
 	double CLUSTER_CONTROLLER_LOGGING_DELAY;
@@ -775,6 +789,9 @@ public:
 	std::string STORAGESERVER_READ_PRIORITIES;
 	int STORAGE_SERVER_READ_CONCURRENCY;
 	std::string STORAGESERVER_READTYPE_PRIORITY_MAP;
+	bool STORAGE_SERVER_BATCH_POINT_READS;
+	double STORAGE_SERVER_POINT_READ_BATCH_WINDOW;
+	int STORAGE_SERVER_POINT_READ_BATCH_MAX;
 
 	// Wait Failure
 	int MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS;
@@ -881,6 +898,9 @@ public:
 	int FASTRESTORE_TXN_CLEAR_MAX; // threshold to start tracking each clear op in a txn
 	int FASTRESTORE_TXN_RETRY_MAX; // threshold to start output error on too many retries
 	double FASTRESTORE_TXN_EXTRA_DELAY; // extra delay to avoid overwhelming fdb
+	bool FASTRESTORE_APPLIER_SORTED_RUNS; // appliers buffer point mutations in sorted runs and merge them when applying
+	int FASTRESTORE_APPLIER_RUN_MUTATIONS; // number of mutations in a sorted run on applier
+	int FASTRESTORE_APPLIER_MERGE_MUTATIONS; // number of mutations merged from sorted runs and applied at a time
 	bool FASTRESTORE_NOT_WRITE_DB; // do not write result to DB. Only for dev testing
 	bool FASTRESTORE_USE_RANGE_FILE; // use range file in backup
 	bool FASTRESTORE_USE_LOG_FILE; // use log file in backup
@@ -905,6 +925,9 @@ public:
 	int REDWOOD_DEFAULT_EXTENT_READ_SIZE; // Extent read size for Redwood files
 	int REDWOOD_EXTENT_CONCURRENT_READS; // Max number of simultaneous extent disk reads in progress.
 	bool REDWOOD_KVSTORE_RANGE_PREFETCH; // Whether to use range read prefetching
+	int REDWOOD_RANGE_READ_AHEAD_MIN_PAGES; // Leaf pages a range read reads ahead of its cursor to begin with
+	int REDWOOD_RANGE_READ_AHEAD_MAX_PAGES; // Leaf pages a range read reads ahead of its cursor at most, as the
+	                                        // read ahead doubles with each leaf the scan moves to
 	double REDWOOD_PAGE_REBUILD_MAX_SLACK; // When rebuilding pages, max slack to allow in page
 	int REDWOOD_LAZY_CLEAR_BATCH_SIZE_PAGES; // Number of pages to try to pop from the lazy delete queue and process at
 	                                         // once
@@ -958,6 +981,7 @@ public:
 
 	int BG_SNAPSHOT_FILE_TARGET_BYTES;
 	int BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES;
+	bool BG_SNAPSHOT_COLUMNAR_FORMAT; // Write snapshots with columnar, prefix-compressed chunks
 	int BG_DELTA_FILE_TARGET_BYTES;
 	int BG_DELTA_FILE_TARGET_CHUNK_BYTES;
 	int BG_DELTA_BYTES_BEFORE_COMPACT;
@@ -123,6 +123,8 @@ struct StorageServerInterface {
 	RequestStream<struct FetchCheckpointKeyValuesRequest> fetchCheckpointKeyValues;
 	RequestStream<struct UpdateCommitCostRequest> updateCommitCostRequest;
 	RequestStream<struct AuditStorageRequest> auditStorage;
+	// Reads the values of several keys at one version; throws wrong_shard_server if any key is not on this server
+	PublicRequestStream<struct GetValuesRequest> getValues;
 
 private:
 	bool acceptingRequests;
@@ -198,6 +200,8 @@ public:
 				    RequestStream<struct UpdateCommitCostRequest>(getValue.getEndpoint().getAdjustedEndpoint(22));
 				auditStorage =
 				    RequestStream<struct AuditStorageRequest>(getValue.getEndpoint().getAdjustedEndpoint(23));
+				getValues =
+				    PublicRequestStream<struct GetValuesRequest>(getValue.getEndpoint().getAdjustedEndpoint(24));
 			}
 		} else {
 			ASSERT(Ar::isDeserializing);
@@ -250,6 +254,7 @@ public:
 		streams.push_back(fetchCheckpointKeyValues.getReceiver());
 		streams.push_back(updateCommitCostRequest.getReceiver());
 		streams.push_back(auditStorage.getReceiver());
+		streams.push_back(getValues.getReceiver(TaskPriority::LoadBalancedEndpoint));
 		FlowTransport::transport().addEndpoints(streams);
 	}
 };
@@ -325,6 +330,44 @@ struct GetValueRequest : TimedRequest {
 	}
 };
 
+struct GetValuesReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 2907261;
+	Arena arena;
+	// The requested keys which have a value, in key order
+	VectorRef<KeyValueRef, VecSerStrategy::String> data;
+	bool cached = false;
+
+	GetValuesReply() {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, cached, arena);
+	}
+};
+
+struct GetValuesRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 5730148;
+	SpanContext spanContext;
+	Arena arena;
+	TenantInfo tenantInfo;
+	VectorRef<KeyRef> keys; // sorted and unique
+	Version version;
+	Optional<TagSet> tags;
+	ReplyPromise<GetValuesReply> reply;
+	Optional<ReadOptions> options;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given keys
+	GetValuesRequest() {}
+
+	bool verify() const { return tenantInfo.isAuthorized(); }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, tags, reply, spanContext, tenantInfo, options, ssLatestCommitVersions, arena);
+	}
+};
+
 struct WatchValueReply {
 	constexpr static FileIdentifier file_identifier = 3;
 
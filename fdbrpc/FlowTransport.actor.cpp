@@ -378,6 +378,7 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 				    .detail("P90Latency", peer->pingLatencies.percentile(0.90))
 				    .detail("Count", peer->pingLatencies.getPopulationSize())
 				    .detail("BytesReceived", peer->bytesReceived - peer->lastLoggedBytesReceived)
+				    .detail("BytesCopied", peer->bytesCopied - peer->lastLoggedBytesCopied)
 				    .detail("BytesSent", peer->bytesSent - peer->lastLoggedBytesSent)
 				    .detail("TimeoutCount", peer->timeoutCount)
 				    .detail("ConnectOutgoingCount", peer->connectOutgoingCount)
@@ -395,6 +396,7 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 				peer->pingLatencies.clear();
 				peer->connectLatencies.clear();
 				peer->lastLoggedBytesReceived = peer->bytesReceived;
+				peer->lastLoggedBytesCopied = peer->bytesCopied;
 				peer->lastLoggedBytesSent = peer->bytesSent;
 				peer->timeoutCount = 0;
 				wait(delay(FLOW_KNOBS->PING_LOGGING_INTERVAL));
@@ -877,9 +879,9 @@ ACTOR Future<Void> connectionKeeper(Reference<Peer> self,
 Peer::Peer(TransportData* transport, NetworkAddress const& destination)
   : transport(transport), destination(destination), compatible(true), outgoingConnectionIdle(true),
     lastConnectTime(0.0), reconnectionDelay(FLOW_KNOBS->INITIAL_RECONNECTION_TIME), peerReferences(-1),
-    bytesReceived(0), bytesSent(0), lastDataPacketSentTime(now()), outstandingReplies(0),
+    bytesReceived(0), bytesCopied(0), bytesSent(0), lastDataPacketSentTime(now()), outstandingReplies(0),
     pingLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1), lastLoggedTime(0.0),
-    lastLoggedBytesReceived(0), lastLoggedBytesSent(0), timeoutCount(0),
+    lastLoggedBytesReceived(0), lastLoggedBytesCopied(0), lastLoggedBytesSent(0), timeoutCount(0),
     protocolVersion(Reference<AsyncVar<Optional<ProtocolVersion>>>(new AsyncVar<Optional<ProtocolVersion>>())),
     connectOutgoingCount(0), connectIncomingCount(0), connectFailedCount(0),
     connectLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1) {
@@ -1247,6 +1249,130 @@ static int getNewBufferSize(const uint8_t* begin,
 	                          packetLen + sizeof(uint32_t) * (peerAddress.isTLS() ? 2 : 3));
 }
 
+// If the unprocessed buffer [begin, end) starts with the header of a packet of at least PACKET_DIRECT_READ_BYTES,
+// return the number of bytes the whole packet occupies on the wire, otherwise return 0. Such packets are moved to a
+// buffer of exactly this size as soon as their header arrives. The bytes received so far are copied once, and the rest
+// of the packet is read straight into the buffer it will be deserialized from.
+static int getDirectReadPacketSize(const uint8_t* begin, const uint8_t* end, const NetworkAddress& peerAddress) {
+	if (end - begin < PACKET_LEN_WIDTH) {
+		return 0;
+	}
+	const uint32_t packetLen = *(uint32_t*)begin;
+	if (packetLen < FLOW_KNOBS->PACKET_DIRECT_READ_BYTES || packetLen > FLOW_KNOBS->PACKET_LIMIT) {
+		return 0;
+	}
+	return PACKET_LEN_WIDTH + (peerAddress.isTLS() ? 0 : sizeof(XXH64_hash_t)) + packetLen;
+}
+
+// Returns the size of the buffer which the unprocessed bytes [begin, end) should move to before reading more into the
+// current buffer, which ends at bufferEnd, or 0 to keep reading into the current buffer.
+static int getNextReceiveBufferSize(const uint8_t* begin,
+                                    const uint8_t* end,
+                                    const uint8_t* bufferEnd,
+                                    bool expectConnectPacket,
+                                    const NetworkAddress& peerAddress,
+                                    ProtocolVersion peerProtocolVersion) {
+	const int directReadLen = expectConnectPacket ? 0 : getDirectReadPacketSize(begin, end, peerAddress);
+	if (directReadLen > 0) {
+		// A large packet which does not fit in the current buffer moves to its own buffer right away, before more of
+		// it is read into a buffer it would later have to be copied out of.
+		return directReadLen > bufferEnd - begin ? directReadLen : 0;
+	}
+	if (bufferEnd - end < FLOW_KNOBS->MIN_PACKET_BUFFER_FREE_BYTES) {
+		return getNewBufferSize(begin, end, peerAddress, peerProtocolVersion);
+	}
+	return 0;
+}
+
+// Before connectionReader reads more bytes, moves the unprocessed bytes [begin, end) to a new buffer owned by arena if
+// getNextReceiveBufferSize() asks for one. Returns the number of bytes copied.
+static int prepareReceiveBuffer(Arena& arena,
+                                uint8_t*& begin,
+                                uint8_t*& end,
+                                uint8_t*& bufferEnd,
+                                bool expectConnectPacket,
+                                const NetworkAddress& peerAddress,
+                                ProtocolVersion peerProtocolVersion) {
+	const int newBufferLen =
+	    getNextReceiveBufferSize(begin, end, bufferEnd, expectConnectPacket, peerAddress, peerProtocolVersion);
+	if (newBufferLen == 0) {
+		return 0;
+	}
+	Arena newArena;
+	const int unproc_len = end - begin;
+	uint8_t* const newBuffer = new (newArena) uint8_t[newBufferLen];
+	if (unproc_len > 0) {
+		memcpy(newBuffer, begin, unproc_len);
+	}
+	arena = newArena;
+	begin = newBuffer;
+	end = newBuffer + unproc_len;
+	bufferEnd = newBuffer + newBufferLen;
+	return unproc_len;
+}
+
+// A small packet followed by a large one arrive in pieces, and go through the buffer management of connectionReader.
+// Once its header has arrived, the large packet must be moved to its own buffer once, and not copied again.
+TEST_CASE("/fdbrpc/FlowTransport/DirectReadSplitPacket") {
+	const NetworkAddress peerAddress(IPAddress(0x7f000001), 4500);
+	const int smallLen = 100;
+	const int largeLen = FLOW_KNOBS->PACKET_DIRECT_READ_BYTES + deterministicRandom()->randomInt(0, 100000);
+	const int checksumLen = sizeof(XXH64_hash_t);
+	const int smallWireLen = PACKET_LEN_WIDTH + checksumLen + smallLen;
+	const int largeWireLen = PACKET_LEN_WIDTH + checksumLen + largeLen;
+
+	std::vector<uint8_t> wire;
+	for (int packetLen : { smallLen, largeLen }) {
+		uint8_t header[PACKET_LEN_WIDTH + sizeof(XXH64_hash_t)] = {};
+		memcpy(header, &packetLen, PACKET_LEN_WIDTH);
+		wire.insert(wire.end(), header, header + sizeof(header));
+		for (int i = 0; i < packetLen; i++) {
+			wire.push_back(deterministicRandom()->randomInt(0, 256));
+		}
+	}
+
+	Arena arena;
+	uint8_t* unprocessed_begin = nullptr;
+	uint8_t* unprocessed_end = nullptr;
+	uint8_t* buffer_end = nullptr;
+	int received = 0;
+	int largeMoves = 0;
+	int largeBytesCopied = 0;
+	bool smallProcessed = false;
+	while (true) {
+		const uint8_t* const previousBuffer = unprocessed_begin;
+		const int bytesCopied = prepareReceiveBuffer(
+		    arena, unprocessed_begin, unprocessed_end, buffer_end, false, peerAddress, currentProtocolVersion());
+		if (unprocessed_begin != previousBuffer && smallProcessed && bytesCopied >= PACKET_LEN_WIDTH) {
+			largeMoves++;
+			largeBytesCopied += bytesCopied;
+			ASSERT_EQ(buffer_end - unprocessed_begin, largeWireLen);
+		}
+
+		// Each read returns a random part of what the socket has
+		const int readBytes = std::min<int>({ static_cast<int>(buffer_end - unprocessed_end),
+		                                      static_cast<int>(wire.size()) - received,
+		                                      deterministicRandom()->randomInt(1, 20000) });
+		memcpy(unprocessed_end, wire.data() + received, readBytes);
+		unprocessed_end += readBytes;
+		received += readBytes;
+
+		if (!smallProcessed && unprocessed_end - unprocessed_begin >= smallWireLen) {
+			unprocessed_begin += smallWireLen;
+			smallProcessed = true;
+		}
+		if (smallProcessed && unprocessed_end - unprocessed_begin == largeWireLen) {
+			ASSERT(memcmp(unprocessed_begin, wire.data() + smallWireLen, largeWireLen) == 0);
+			ASSERT(unprocessed_end == buffer_end);
+			break;
+		}
+	}
+	ASSERT_LE(largeMoves, 1);
+	// Only the bytes which arrived with the header were copied out of the shared buffer
+	ASSERT_LE(largeBytesCopied, FLOW_KNOBS->MIN_PACKET_BUFFER_BYTES);
+	return Void();
+}
+
 // This actor exists whenever there is an open or opening connection, whether incoming or outgoing
 // For incoming connections conn is set and peer is initially nullptr; for outgoing connections it is the reverse
 ACTOR static Future<Void> connectionReader(TransportData* transport,
@@ -1272,22 +1398,17 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 	try {
 		loop {
 			loop {
-				state int readAllBytes = buffer_end - unprocessed_end;
-				if (readAllBytes < FLOW_KNOBS->MIN_PACKET_BUFFER_FREE_BYTES) {
-					Arena newArena;
-					const int unproc_len = unprocessed_end - unprocessed_begin;
-					const int len =
-					    getNewBufferSize(unprocessed_begin, unprocessed_end, peerAddress, peerProtocolVersion);
-					uint8_t* const newBuffer = new (newArena) uint8_t[len];
-					if (unproc_len > 0) {
-						memcpy(newBuffer, unprocessed_begin, unproc_len);
-					}
-					arena = newArena;
-					unprocessed_begin = newBuffer;
-					unprocessed_end = newBuffer + unproc_len;
-					buffer_end = newBuffer + len;
-					readAllBytes = buffer_end - unprocessed_end;
+				const int bytesCopied = prepareReceiveBuffer(arena,
+				                                             unprocessed_begin,
+				                                             unprocessed_end,
+				                                             buffer_end,
+				                                             expectConnectPacket,
+				                                             peerAddress,
+				                                             peerProtocolVersion);
+				if (peer) {
+					peer->bytesCopied += bytesCopied;
 				}
+				state int readAllBytes = buffer_end - unprocessed_end;
 
 				state int totalReadBytes = 0;
 				while (true) {
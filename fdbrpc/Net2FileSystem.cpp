@@ -35,6 +35,7 @@
 #include "fdbrpc/AsyncFileEncrypted.h"
 #include "fdbrpc/AsyncFileWinASIO.actor.h"
 #include "fdbrpc/AsyncFileKAIO.actor.h"
+#include "fdbrpc/AsyncFileIOUring.actor.h"
 #include "flow/AsioReactor.h"
 #include "flow/Platform.h"
 #include "fdbrpc/AsyncFileWriteChecker.h"
@@ -64,11 +65,14 @@ Future<Reference<class IAsyncFile>> Net2FileSystem::open(const std::string& file
 	// don’t properly support kernel async I/O without O_DIRECT or AIO at all. In such
 	// cases, DISABLE_POSIX_KERNEL_AIO knob can be enabled to fallback to EIO instead
 	// of Kernel AIO. And EIO_USE_ODIRECT can be used to turn on or off O_DIRECT within
-	// EIO.
+	// EIO. With ENABLE_IO_URING, io_uring takes the place of Kernel AIO where the kernel supports it.
 	if ((flags & IAsyncFile::OPEN_UNBUFFERED) && !(flags & IAsyncFile::OPEN_NO_AIO) &&
-	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
-	else
+	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+		if (AsyncFileIOUring::isEnabled())
+			f = AsyncFileIOUring::open(filename, flags, mode, nullptr);
+		else
+			f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
+	} else
 #endif
 		f = Net2AsyncFile::open(
 		    filename,
@@ -111,8 +115,12 @@ void Net2FileSystem::newFileSystem(double ioTimeout, const std::string& fileSyst
 Net2FileSystem::Net2FileSystem(double ioTimeout, const std::string& fileSystemPath) {
 	Net2AsyncFile::init();
 #ifdef __linux__
-	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+		// Both use the network's eventfd and run cycle function, so only one of them can be initialized
+		Reference<IEventFD> ev(N2::ASIOReactor::getEventFD());
+		if (!FLOW_KNOBS->ENABLE_IO_URING || !AsyncFileIOUring::init(ev, ioTimeout))
+			AsyncFileKAIO::init(ev, ioTimeout);
+	}
 
 	if (fileSystemPath.empty()) {
 		checkFileSystem = false;
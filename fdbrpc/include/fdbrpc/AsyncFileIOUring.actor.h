@@ -0,0 +1,786 @@
+/*
+ * AsyncFileIOUring.actor.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#ifdef __linux__
+
+// When actually compiled (NO_INTELLISENSE), include the generated version of this file.  In intellisense use the source
+// version.
+#if defined(NO_INTELLISENSE) && !defined(FLOW_ASYNCFILEIOURING_ACTOR_G_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_G_H
+#include "fdbrpc/AsyncFileIOUring.actor.g.h"
+#elif !defined(FLOW_ASYNCFILEIOURING_ACTOR_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_H
+
+#include "flow/IAsyncFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "fdbrpc/linux_io_uring.h"
+#include "fdbrpc/AsyncFileEIO.actor.h"
+#include "flow/Knobs.h"
+#include "fdbrpc/Stats.h"
+#include "flow/UnitTest.h"
+#include "flow/genericactors.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// An alternative to AsyncFileKAIO for unbuffered files, using an io_uring instead of libaio.
+//
+// Requests are queued by priority as in AsyncFileKAIO, and the run loop's cycle function copies them into the
+// submission ring and submits the whole batch with one io_uring_enter(). The network's eventfd is registered with the
+// ring, and completions are read straight from the mapped completion ring, so that collecting them needs no system
+// call. Open files are registered with the ring as fixed files when there is room in the table, which saves the kernel
+// a file table lookup and reference count per request.
+class AsyncFileIOUring final : public IAsyncFile, public ReferenceCounted<AsyncFileIOUring> {
+public:
+	struct AsyncFileIOUringMetrics {
+		LatencySample readLatencySample = { "AsyncFileIOUringReadLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample writeLatencySample = { "AsyncFileIOUringWriteLatency",
+			                                 UID(),
+			                                 FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                 FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample syncLatencySample = { "AsyncFileIOUringSyncLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+	};
+
+	static AsyncFileIOUringMetrics& getMetrics() {
+		static AsyncFileIOUringMetrics metrics;
+		return metrics;
+	}
+
+	// Returns true if init() succeeded, in which case unbuffered files should be opened with this class
+	static bool isEnabled() { return ctx.ringFd >= 0; }
+
+	static Future<Reference<IAsyncFile>> open(std::string filename, int flags, int mode, void* ignore) {
+		ASSERT(isEnabled());
+		ASSERT(flags & OPEN_UNBUFFERED);
+
+		if (flags & OPEN_LOCK)
+			mode |= 02000; // Enable mandatory locking for this file if it is supported by the filesystem
+
+		std::string open_filename = filename;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			ASSERT((flags & OPEN_CREATE) && (flags & OPEN_READWRITE) && !(flags & OPEN_EXCLUSIVE));
+			open_filename = filename + ".part";
+		}
+
+		int fd = ::open(open_filename.c_str(), openFlags(flags), mode);
+		if (fd < 0) {
+			Error e = errno == ENOENT ? file_not_found() : io_error();
+			int ecode = errno; // Save errno in case it is modified before it is used below
+			TraceEvent ev("AsyncFileIOUringOpenFailed");
+			ev.error(e)
+			    .detail("Filename", filename)
+			    .detailf("Flags", "%x", flags)
+			    .detailf("OSFlags", "%x", openFlags(flags))
+			    .detailf("Mode", "0%o", mode)
+			    .GetLastError();
+			if (ecode == EINVAL)
+				ev.detail("Description", "Invalid argument - Does the target filesystem support O_DIRECT?");
+			return e;
+		}
+
+		Reference<AsyncFileIOUring> r(new AsyncFileIOUring(fd, flags, filename));
+		TraceEvent("AsyncFileIOUringOpen")
+		    .detail("Filename", filename)
+		    .detail("Flags", flags)
+		    .detail("Mode", mode)
+		    .detail("Fd", fd)
+		    .detail("FixedFile", r->fixedFile);
+
+		if (flags & OPEN_LOCK) {
+			// Acquire a "write" lock for the entire file
+			flock lockDesc;
+			lockDesc.l_type = F_WRLCK;
+			lockDesc.l_whence = SEEK_SET;
+			lockDesc.l_start = 0;
+			lockDesc.l_len = 0; // Lock all bytes through to the end of file, no matter how large the file grows
+			lockDesc.l_pid = 0;
+			if (fcntl(fd, F_SETLK, &lockDesc) == -1) {
+				TraceEvent(SevWarn, "UnableToLockFile").detail("Filename", filename).GetLastError();
+				return lock_file_failure();
+			}
+		}
+
+		struct stat buf;
+		if (fstat(fd, &buf)) {
+			TraceEvent("AsyncFileIOUringFStatError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		r->lastFileSize = r->nextFileSize = buf.st_size;
+		return Reference<IAsyncFile>(std::move(r));
+	}
+
+	// Returns true if the kernel supports every operation this file submits
+	static bool supportsRequiredOps(int ringFd) {
+		constexpr int maxOps = 256;
+		std::vector<uint8_t> buffer(sizeof(linux_io_uring_probe) + maxOps * sizeof(linux_io_uring_probe_op));
+		if (io_uring_register(ringFd, IORING_REGISTER_PROBE, buffer.data(), maxOps) < 0) {
+			TraceEvent(SevWarn, "IOUringProbeError").GetLastError();
+			return false;
+		}
+		const linux_io_uring_probe* probe = (const linux_io_uring_probe*)buffer.data();
+		const linux_io_uring_probe_op* ops = (const linux_io_uring_probe_op*)(probe + 1);
+		for (int op : { IORING_OP_FSYNC, IORING_OP_READ, IORING_OP_WRITE }) {
+			if (op > probe->last_op || op >= probe->ops_len || !(ops[op].flags & IO_URING_OP_SUPPORTED))
+				return false;
+		}
+		return true;
+	}
+
+	// Sets up the ring, and returns false if the kernel does not support it (or io_uring is disabled)
+	static bool init(Reference<IEventFD> ev, double ioTimeout) {
+		ASSERT(!isEnabled());
+		linux_io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		int ringFd = io_uring_setup(FLOW_KNOBS->MAX_OUTSTANDING, &params);
+		if (ringFd < 0) {
+			TraceEvent(SevWarnAlways, "IOUringSetupError").GetLastError();
+			return false;
+		}
+		if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+			// Kernels before 5.4 need separate mappings for the two rings; KAIO is used there instead
+			TraceEvent(SevWarnAlways, "IOUringUnsupported").detail("Features", params.features);
+			close(ringFd);
+			return false;
+		}
+		if (!supportsRequiredOps(ringFd)) {
+			// IORING_OP_READ and IORING_OP_WRITE need 5.6, which is also the first kernel that can be probed. On
+			// older kernels the ring sets up fine but every read and write would fail with EINVAL.
+			TraceEvent(SevWarnAlways, "IOUringUnsupported")
+			    .detail("Features", params.features)
+			    .detail("Reason", "MissingOps");
+			close(ringFd);
+			return false;
+		}
+
+		size_t ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+		                           params.cq_off.cqes + params.cq_entries * sizeof(linux_io_uring_cqe));
+		size_t sqesSize = params.sq_entries * sizeof(linux_io_uring_sqe);
+		uint8_t* ring = (uint8_t*)mmap(
+		    nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+		void* sqes =
+		    mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+		if (ring == MAP_FAILED || sqes == MAP_FAILED) {
+			TraceEvent(SevWarnAlways, "IOUringMapError").GetLastError();
+			if (ring != MAP_FAILED)
+				munmap(ring, ringSize);
+			if (sqes != MAP_FAILED)
+				munmap(sqes, sqesSize);
+			close(ringFd);
+			return false;
+		}
+
+		int evfd = ev->getFD();
+		if (io_uring_register(ringFd, IORING_REGISTER_EVENTFD, &evfd, 1) < 0) {
+			TraceEvent(SevWarnAlways, "IOUringRegisterEventFDError").GetLastError();
+			munmap(ring, ringSize);
+			munmap(sqes, sqesSize);
+			close(ringFd);
+			return false;
+		}
+
+		// A sparse table of fixed files, filled in as files are opened. Without it every request uses a plain fd.
+		std::vector<int32_t> files(FLOW_KNOBS->IO_URING_FIXED_FILES, -1);
+		if (!files.empty() && io_uring_register(ringFd, IORING_REGISTER_FILES, files.data(), files.size()) == 0) {
+			for (int i = files.size() - 1; i >= 0; i--)
+				ctx.freeFixedFiles.push_back(i);
+		} else if (!files.empty()) {
+			TraceEvent(SevWarn, "IOUringRegisterFilesError").GetLastError();
+		}
+
+		ctx.ringFd = ringFd;
+		ctx.sqHead = (uint32_t*)(ring + params.sq_off.head);
+		ctx.sqTail = (uint32_t*)(ring + params.sq_off.tail);
+		ctx.sqMask = *(uint32_t*)(ring + params.sq_off.ring_mask);
+		ctx.sqArray = (uint32_t*)(ring + params.sq_off.array);
+		ctx.sqes = (linux_io_uring_sqe*)sqes;
+		ctx.sqEntries = params.sq_entries;
+		ctx.cqHead = (uint32_t*)(ring + params.cq_off.head);
+		ctx.cqTail = (uint32_t*)(ring + params.cq_off.tail);
+		ctx.cqMask = *(uint32_t*)(ring + params.cq_off.ring_mask);
+		ctx.cqes = (linux_io_uring_cqe*)(ring + params.cq_off.cqes);
+
+		if (!g_network->isSimulated()) {
+			ctx.countIOUringSubmit.init("AsyncFile.CountIOUringSubmit"_sr);
+			ctx.countIOUringCollect.init("AsyncFile.CountIOUringCollect"_sr);
+			ctx.countPreSubmitTruncate.init("AsyncFile.CountPreIOUringSubmitTruncate"_sr);
+			ctx.preSubmitTruncateBytes.init("AsyncFile.PreIOUringSubmitTruncateBytes"_sr);
+		}
+
+		setTimeout(ioTimeout);
+		poll(ev);
+
+		g_network->setGlobal(INetwork::enRunCycleFunc, (flowGlobalType)&AsyncFileIOUring::launch);
+		TraceEvent("IOUringInitialized")
+		    .detail("Entries", params.sq_entries)
+		    .detail("Features", params.features)
+		    .detail("FixedFiles", ctx.freeFixedFiles.size());
+		return true;
+	}
+
+	static void setTimeout(double ioTimeout) { ctx.setIOTimeout(ioTimeout); }
+
+	void addref() override { ReferenceCounted<AsyncFileIOUring>::addref(); }
+	void delref() override { ReferenceCounted<AsyncFileIOUring>::delref(); }
+
+	Future<int> read(void* data, int length, int64_t offset) override {
+		++countFileLogicalReads;
+		++countLogicalReads;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_READ, data, length, offset);
+		enqueue(io);
+		return io->result.getFuture();
+	}
+
+	Future<Void> write(void const* data, int length, int64_t offset) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_WRITE, (void*)data, length, offset);
+		nextFileSize = std::max(nextFileSize, offset + length);
+		enqueue(io);
+		return success(io->result.getFuture());
+	}
+
+// TODO(alexmiller): Remove when we upgrade the dev docker image to >14.10
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE 0x10
+#endif
+	Future<Void> zeroRange(int64_t offset, int64_t length) override {
+		bool success = false;
+		if (ctx.fallocateZeroSupported) {
+			int rc = fallocate(fd, FALLOC_FL_ZERO_RANGE, offset, length);
+			if (rc == -1 && errno == EOPNOTSUPP) {
+				ctx.fallocateZeroSupported = false;
+			}
+			if (rc == 0) {
+				success = true;
+			}
+		}
+		return success ? Void() : IAsyncFile::zeroRange(offset, length);
+	}
+
+	Future<Void> truncate(int64_t size) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		int result = -1;
+		bool completed = false;
+		if (ctx.fallocateSupported && size >= lastFileSize) {
+			result = fallocate(fd, 0, 0, size);
+			if (result != 0) {
+				int fallocateErrCode = errno;
+				TraceEvent("AsyncFileIOUringAllocateError")
+				    .detail("Fd", fd)
+				    .detail("Filename", filename)
+				    .detail("Size", size)
+				    .GetLastError();
+				if (fallocateErrCode == EOPNOTSUPP) {
+					// Mark fallocate as unsupported. Try again with truncate.
+					ctx.fallocateSupported = false;
+				} else {
+					return io_error();
+				}
+			} else {
+				completed = true;
+			}
+		}
+		if (!completed)
+			result = ftruncate(fd, size);
+
+		if (result != 0) {
+			TraceEvent("AsyncFileIOUringTruncateError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		lastFileSize = nextFileSize = size;
+		return Void();
+	}
+
+	Future<Void> sync() override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		// Unlike KAIO, io_uring implements fdatasync itself, so no thread is needed. Only writes that have completed
+		// are guaranteed to be covered, which is all that IAsyncFile::sync() promises.
+		IOBlock* io = new IOBlock(IORING_OP_FSYNC, nullptr, 0, 0);
+		io->opFlags = IORING_FSYNC_DATASYNC;
+		enqueue(io);
+		double startTime = timer();
+		Future<Void> fsync = map(io->result.getFuture(), [startTime](int) {
+			getMetrics().syncLatencySample.addMeasurement(timer() - startTime);
+			return Void();
+		});
+
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			flags &= ~OPEN_ATOMIC_WRITE_AND_CREATE;
+
+			return AsyncFileEIO::waitAndAtomicRename(fsync, filename + ".part", filename);
+		}
+
+		return fsync;
+	}
+
+	Future<int64_t> size() const override { return nextFileSize; }
+	int64_t debugFD() const override { return fd; }
+	std::string getFilename() const override { return filename; }
+
+	~AsyncFileIOUring() override {
+		// Requests hold a reference to their file, so none are outstanding here
+		if (fixedFile >= 0) {
+			int32_t none = -1;
+			linux_io_uring_files_update update = { uint32_t(fixedFile), 0, uint64_t(&none) };
+			if (io_uring_register(ctx.ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1)
+				ctx.freeFixedFiles.push_back(fixedFile);
+			else
+				TraceEvent(SevWarn, "IOUringUnregisterFileError").detail("Filename", filename).GetLastError();
+		}
+		close(fd);
+	}
+
+	// Moves queued requests into the submission ring and submits them, along with any entries the kernel did not take
+	// on an earlier cycle, with one system call
+	static void launch() {
+		int n = 0;
+		if (!ctx.queue.empty() && ctx.outstanding < FLOW_KNOBS->MAX_OUTSTANDING - FLOW_KNOBS->MIN_SUBMIT) {
+			const int room =
+			    std::min<int>(FLOW_KNOBS->MAX_OUTSTANDING, ctx.sqEntries) - ctx.outstanding - ctx.unsubmitted;
+			n = std::max(0, std::min<int>(room, ctx.queue.size()));
+		}
+		if (n == 0 && ctx.unsubmitted == 0)
+			return;
+
+		double start = timer();
+		double begin = timer_monotonic();
+		if (!ctx.outstanding)
+			ctx.ioStallBegin = begin;
+
+		uint32_t tail = *ctx.sqTail;
+		for (int i = 0; i < n; i++) {
+			IOBlock* io = ctx.queue.top();
+			ctx.queue.pop();
+			io->startTime = start;
+
+			if (ctx.ioTimeout > 0) {
+				ctx.appendToRequestList(io);
+			}
+
+			// Extending the file with O_DIRECT writes is slow and serializes them, so allocate ahead of time
+			AsyncFileIOUring* owner = io->owner.getPtr();
+			if (io->opcode == IORING_OP_WRITE && owner->lastFileSize != owner->nextFileSize) {
+				++ctx.countPreSubmitTruncate;
+				ctx.preSubmitTruncateBytes += owner->nextFileSize - owner->lastFileSize;
+				owner->truncate(owner->nextFileSize);
+			}
+
+			const uint32_t index = tail & ctx.sqMask;
+			linux_io_uring_sqe* sqe = &ctx.sqes[index];
+			memset(sqe, 0, sizeof(*sqe));
+			sqe->opcode = io->opcode;
+			if (owner->fixedFile >= 0) {
+				sqe->flags = IOSQE_FIXED_FILE;
+				sqe->fd = owner->fixedFile;
+			} else {
+				sqe->fd = owner->fd;
+			}
+			sqe->addr = uint64_t(io->buf);
+			sqe->len = io->nbytes;
+			sqe->off = io->offset;
+			sqe->op_flags = io->opFlags;
+			sqe->user_data = uint64_t(io);
+			ctx.sqArray[index] = index;
+			tail++;
+		}
+		__atomic_store_n(ctx.sqTail, tail, __ATOMIC_RELEASE);
+		ctx.outstanding += n;
+		ctx.unsubmitted += n;
+
+		int rc;
+		do {
+			rc = io_uring_enter(ctx.ringFd, ctx.unsubmitted, 0, 0);
+		} while (rc < 0 && errno == EINTR);
+		++ctx.countIOUringSubmit;
+
+		if (rc >= 0) {
+			ctx.unsubmitted -= rc;
+		} else if (errno != EAGAIN && errno != EBUSY) {
+			TraceEvent(SevError, "IOUringEnterError").GetLastError();
+			throw io_error();
+		}
+		// Entries the kernel did not take stay in the ring, and are submitted again on the next cycle
+
+		double elapsed = timer_monotonic() - begin;
+		g_network->networkInfo.metrics.secSquaredSubmit += elapsed * elapsed / 2;
+	}
+
+	bool failed;
+
+private:
+	int fd, flags;
+	int fixedFile; // Index in the ring's file table, or -1
+	int64_t lastFileSize, nextFileSize;
+	std::string filename;
+	Int64MetricHandle countFileLogicalWrites;
+	Int64MetricHandle countFileLogicalReads;
+
+	Int64MetricHandle countLogicalWrites;
+	Int64MetricHandle countLogicalReads;
+
+	struct IOBlock : FastAllocated<IOBlock> {
+		uint8_t opcode;
+		uint32_t opFlags;
+		void* buf;
+		uint32_t nbytes;
+		int64_t offset;
+
+		Promise<int> result;
+		Reference<AsyncFileIOUring> owner;
+		int64_t prio;
+		IOBlock* prev;
+		IOBlock* next;
+		double startTime;
+
+		struct indirect_order_by_priority {
+			bool operator()(IOBlock* a, IOBlock* b) { return a->prio < b->prio; }
+		};
+
+		IOBlock(uint8_t opcode, void* buf, uint32_t nbytes, int64_t offset)
+		  : opcode(opcode), opFlags(0), buf(buf), nbytes(nbytes), offset(offset), prev(nullptr), next(nullptr),
+		    startTime(0) {}
+
+		TaskPriority getTask() const { return static_cast<TaskPriority>((prio >> 32) + 1); }
+
+		ACTOR static void deliver(Promise<int> result, bool failed, int r, TaskPriority task) {
+			wait(delay(0, task));
+			if (failed)
+				result.sendError(io_timeout());
+			else if (r < 0)
+				result.sendError(io_error());
+			else
+				result.send(r);
+		}
+
+		void setResult(int r) {
+			if (r < 0) {
+				errno = -r;
+				TraceEvent("AsyncFileIOUringIOError")
+				    .GetLastError()
+				    .detail("Fd", owner->fd)
+				    .detail("Op", opcode)
+				    .detail("Nbytes", nbytes)
+				    .detail("Offset", offset)
+				    .detail("Ptr", int64_t(buf))
+				    .detail("Filename", owner->filename);
+			}
+			deliver(result, owner->failed, r, getTask());
+			delete this;
+		}
+
+		void timeout(bool warnOnly) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringTimeout")
+			    .detail("Fd", owner->fd)
+			    .detail("Op", opcode)
+			    .detail("Nbytes", nbytes)
+			    .detail("Offset", offset)
+			    .detail("Ptr", int64_t(buf))
+			    .detail("Filename", owner->filename);
+			g_network->setGlobal(INetwork::enASIOTimedOut, (flowGlobalType) true);
+
+			if (!warnOnly)
+				owner->failed = true;
+		}
+	};
+
+	struct Context {
+		int ringFd;
+		uint32_t* sqHead;
+		uint32_t* sqTail;
+		uint32_t sqMask;
+		uint32_t* sqArray;
+		linux_io_uring_sqe* sqes;
+		int sqEntries;
+		uint32_t* cqHead;
+		uint32_t* cqTail;
+		uint32_t cqMask;
+		linux_io_uring_cqe* cqes;
+
+		int outstanding; // Requests in the ring or in flight
+		int unsubmitted; // Requests in the ring that the kernel has not taken yet
+		double ioStallBegin;
+		bool fallocateSupported;
+		bool fallocateZeroSupported;
+		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority> queue;
+		std::vector<int> freeFixedFiles;
+		Int64MetricHandle countIOUringSubmit;
+		Int64MetricHandle countIOUringCollect;
+		Int64MetricHandle countPreSubmitTruncate;
+		Int64MetricHandle preSubmitTruncateBytes;
+
+		double ioTimeout;
+		bool timeoutWarnOnly;
+		IOBlock* submittedRequestList;
+
+		uint32_t opsIssued;
+		Context()
+		  : ringFd(-1), outstanding(0), unsubmitted(0), ioStallBegin(0), fallocateSupported(true),
+		    fallocateZeroSupported(true), submittedRequestList(nullptr), opsIssued(0) {
+			setIOTimeout(0);
+		}
+
+		void setIOTimeout(double timeout) {
+			ioTimeout = fabs(timeout);
+			timeoutWarnOnly = timeout < 0;
+		}
+
+		void appendToRequestList(IOBlock* io) {
+			ASSERT(!io->next && !io->prev);
+
+			if (submittedRequestList) {
+				io->prev = submittedRequestList->prev;
+				io->prev->next = io;
+
+				submittedRequestList->prev = io;
+				io->next = submittedRequestList;
+			} else {
+				submittedRequestList = io;
+				io->next = io->prev = io;
+			}
+		}
+
+		void removeFromRequestList(IOBlock* io) {
+			if (io->next == nullptr) {
+				ASSERT(io->prev == nullptr);
+				return;
+			}
+
+			ASSERT(io->prev != nullptr);
+
+			if (io == io->next) {
+				ASSERT(io == submittedRequestList && io == io->prev);
+				submittedRequestList = nullptr;
+			} else {
+				io->next->prev = io->prev;
+				io->prev->next = io->next;
+
+				if (submittedRequestList == io) {
+					submittedRequestList = io->next;
+				}
+			}
+
+			io->next = io->prev = nullptr;
+		}
+	};
+	static Context ctx;
+
+	explicit AsyncFileIOUring(int fd, int flags, std::string const& filename)
+	  : failed(false), fd(fd), flags(flags), fixedFile(-1), filename(filename) {
+		if (!g_network->isSimulated()) {
+			countFileLogicalWrites.init("AsyncFile.CountFileLogicalWrites"_sr, filename);
+			countFileLogicalReads.init("AsyncFile.CountFileLogicalReads"_sr, filename);
+			countLogicalWrites.init("AsyncFile.CountLogicalWrites"_sr);
+			countLogicalReads.init("AsyncFile.CountLogicalReads"_sr);
+		}
+
+		if (!ctx.freeFixedFiles.empty()) {
+			int slot = ctx.freeFixedFiles.back();
+			int32_t fd32 = fd;
+			linux_io_uring_files_update update = { uint32_t(slot), 0, uint64_t(&fd32) };
+			if (io_uring_register(ctx.ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1) {
+				ctx.freeFixedFiles.pop_back();
+				fixedFile = slot;
+			}
+		}
+	}
+
+	void enqueue(IOBlock* io) {
+		ASSERT(int64_t(io->buf) % 4096 == 0 && io->offset % 4096 == 0 && io->nbytes % 4096 == 0);
+
+		io->prio = (int64_t(g_network->getCurrentTask()) << 32) - (++ctx.opsIssued);
+		io->owner = Reference<AsyncFileIOUring>::addRef(this);
+
+		ctx.queue.push(io);
+	}
+
+	static int openFlags(int flags) {
+		int oflags = O_DIRECT | O_CLOEXEC;
+		ASSERT(bool(flags & OPEN_READONLY) != bool(flags & OPEN_READWRITE)); // readonly xor readwrite
+		if (flags & OPEN_EXCLUSIVE)
+			oflags |= O_EXCL;
+		if (flags & OPEN_CREATE)
+			oflags |= O_CREAT;
+		if (flags & OPEN_READONLY)
+			oflags |= O_RDONLY;
+		if (flags & OPEN_READWRITE)
+			oflags |= O_RDWR;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE)
+			oflags |= O_TRUNC;
+		return oflags;
+	}
+
+	// Collects completions whenever the kernel signals the eventfd registered with the ring
+	ACTOR static void poll(Reference<IEventFD> ev) {
+		loop {
+			wait(success(ev->read()));
+
+			wait(delay(0, TaskPriority::DiskIOComplete));
+
+			state double currentTime = timer();
+			++ctx.countIOUringCollect;
+
+			uint32_t head = *ctx.cqHead;
+			const uint32_t tail = __atomic_load_n(ctx.cqTail, __ATOMIC_ACQUIRE);
+			const int n = tail - head;
+			if (n) {
+				double t = timer_monotonic();
+				double elapsed = t - ctx.ioStallBegin;
+				ctx.ioStallBegin = t;
+				g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+			}
+			ctx.outstanding -= n;
+
+			if (ctx.ioTimeout > 0) {
+				while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
+					ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
+					ctx.removeFromRequestList(ctx.submittedRequestList);
+				}
+			}
+
+			for (; head != tail; head++) {
+				const linux_io_uring_cqe& cqe = ctx.cqes[head & ctx.cqMask];
+				IOBlock* iob = (IOBlock*)cqe.user_data;
+				const int result = cqe.res;
+
+				if (ctx.ioTimeout > 0) {
+					ctx.removeFromRequestList(iob);
+				}
+
+				switch (iob->opcode) {
+				case IORING_OP_READ:
+					getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
+					break;
+				case IORING_OP_WRITE:
+					getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
+					break;
+				}
+
+				iob->setResult(result);
+			}
+			// Hand the entries back to the kernel only after they have been read
+			__atomic_store_n(ctx.cqHead, tail, __ATOMIC_RELEASE);
+		}
+	}
+};
+
+ACTOR Future<Void> runIOUringTestOps(Reference<IAsyncFile> f, int fileSize) {
+	state int pageCount = 64;
+	state uint8_t* data = (uint8_t*)aligned_alloc(4096, pageCount * 4096);
+	state uint8_t* readBuf = (uint8_t*)aligned_alloc(4096, pageCount * 4096);
+	state int iteration = 0;
+
+	for (; iteration < 20; ++iteration) {
+		// Write distinct pages at random offsets in one batch, sync, then read them all back in one batch
+		state std::vector<int64_t> offsets;
+		std::set<int64_t> used;
+		while (offsets.size() < pageCount) {
+			int64_t offset = deterministicRandom()->randomInt(0, fileSize / 4096) * int64_t(4096);
+			if (used.insert(offset).second)
+				offsets.push_back(offset);
+		}
+		for (int i = 0; i < pageCount * 4096; i++)
+			data[i] = deterministicRandom()->randomInt(0, 256);
+
+		std::vector<Future<Void>> writes;
+		for (int p = 0; p < pageCount; p++)
+			writes.push_back(f->write(data + p * 4096, 4096, offsets[p]));
+		wait(waitForAll(writes));
+		wait(f->sync());
+
+		memset(readBuf, 0, pageCount * 4096);
+		state std::vector<Future<int>> reads;
+		for (int p = 0; p < pageCount; p++)
+			reads.push_back(f->read(readBuf + p * 4096, 4096, offsets[p]));
+		wait(waitForAll(reads));
+		for (int p = 0; p < pageCount; p++)
+			ASSERT_EQ(reads[p].get(), 4096);
+		ASSERT(memcmp(data, readBuf, pageCount * 4096) == 0);
+	}
+
+	free(data);
+	free(readBuf);
+	return Void();
+}
+
+TEST_CASE("/fdbrpc/AsyncFileIOUring/ReadWrite") {
+	// This test does nothing in simulation, or where io_uring is not in use
+	if (!g_network->isSimulated() && AsyncFileIOUring::isEnabled()) {
+		state Reference<IAsyncFile> f;
+		try {
+			Reference<IAsyncFile> f_ = wait(AsyncFileIOUring::open(
+			    "/tmp/__IOURING_TEST_FILE__",
+			    IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_CREATE,
+			    0666,
+			    nullptr));
+			f = f_;
+			state int fileSize = 1 << 24;
+			wait(f->truncate(fileSize));
+			wait(runIOUringTestOps(f, fileSize));
+		} catch (Error& e) {
+			state Error err = e;
+			if (f) {
+				wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+			}
+			throw err;
+		}
+
+		wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+	}
+
+	return Void();
+}
+
+AsyncFileIOUring::Context AsyncFileIOUring::ctx;
+
+#include "flow/unactorcompiler.h"
+#endif
+#endif
@@ -156,12 +156,14 @@ struct Peer : public ReferenceCounted<Peer> {
 	double reconnectionDelay;
 	int peerReferences;
 	int64_t bytesReceived;
+	int64_t bytesCopied; // Received bytes which were memcpy'd into a larger receive buffer
 	int64_t bytesSent;
 	double lastDataPacketSentTime;
 	int outstandingReplies;
 	DDSketch<double> pingLatencies;
 	double lastLoggedTime;
 	int64_t lastLoggedBytesReceived;
+	int64_t lastLoggedBytesCopied;
 	int64_t lastLoggedBytesSent;
 	int timeoutCount;
 
@@ -48,11 +48,13 @@ struct TSSMetrics : ReferenceCounted<TSSMetrics>, NonCopyable {
 
 	// We could probably just ignore getKey as it's seldom used?
 	DDSketch<double> SSgetValueLatency;
+	DDSketch<double> SSgetValuesLatency;
 	DDSketch<double> SSgetKeyLatency;
 	DDSketch<double> SSgetKeyValuesLatency;
 	DDSketch<double> SSgetMappedKeyValuesLatency;
 
 	DDSketch<double> TSSgetValueLatency;
+	DDSketch<double> TSSgetValuesLatency;
 	DDSketch<double> TSSgetKeyLatency;
 	DDSketch<double> TSSgetKeyValuesLatency;
 	DDSketch<double> TSSgetMappedKeyValuesLatency;
@@ -87,11 +89,13 @@ struct TSSMetrics : ReferenceCounted<TSSMetrics>, NonCopyable {
 
 	void clear() {
 		SSgetValueLatency.clear();
+		SSgetValuesLatency.clear();
 		SSgetKeyLatency.clear();
 		SSgetKeyValuesLatency.clear();
 		SSgetMappedKeyValuesLatency.clear();
 
 		TSSgetValueLatency.clear();
+		TSSgetValuesLatency.clear();
 		TSSgetKeyLatency.clear();
 		TSSgetKeyValuesLatency.clear();
 		TSSgetMappedKeyValuesLatency.clear();
@@ -105,9 +109,9 @@ struct TSSMetrics : ReferenceCounted<TSSMetrics>, NonCopyable {
 	TSSMetrics()
 	  : cc("TSSClientMetrics"), requests("Requests", cc), streamComparisons("StreamComparisons", cc),
 	    ssErrors("SSErrors", cc), tssErrors("TSSErrors", cc), tssTimeouts("TSSTimeouts", cc),
-	    mismatches("Mismatches", cc), SSgetValueLatency(), SSgetKeyLatency(), SSgetKeyValuesLatency(),
-	    SSgetMappedKeyValuesLatency(), TSSgetValueLatency(), TSSgetKeyLatency(), TSSgetKeyValuesLatency(),
-	    TSSgetMappedKeyValuesLatency() {}
+	    mismatches("Mismatches", cc), SSgetValueLatency(), SSgetValuesLatency(), SSgetKeyLatency(),
+	    SSgetKeyValuesLatency(), SSgetMappedKeyValuesLatency(), TSSgetValueLatency(), TSSgetValuesLatency(),
+	    TSSgetKeyLatency(), TSSgetKeyValuesLatency(), TSSgetMappedKeyValuesLatency() {}
 };
 
 template <class Rep>
@@ -0,0 +1,142 @@
+/*
+ * linux_io_uring.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// io_uring system calls and the parts of the kernel ABI that AsyncFileIOUring uses. These are declared here, rather
+// than taken from <linux/io_uring.h> or liburing, so that the build does not depend on the kernel headers installed.
+
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+enum {
+	IORING_OP_NOP = 0,
+	IORING_OP_FSYNC = 3,
+	IORING_OP_READ = 22,
+	IORING_OP_WRITE = 23,
+};
+
+enum { IOSQE_FIXED_FILE = 1 << 0 };
+enum { IORING_FSYNC_DATASYNC = 1 << 0 };
+enum { IORING_ENTER_GETEVENTS = 1 << 0 };
+enum { IORING_FEAT_SINGLE_MMAP = 1 << 0 };
+
+enum {
+	IORING_REGISTER_FILES = 2,
+	IORING_REGISTER_EVENTFD = 4,
+	IORING_REGISTER_FILES_UPDATE = 6,
+	IORING_REGISTER_PROBE = 8,
+};
+
+enum { IO_URING_OP_SUPPORTED = 1 << 0 };
+
+static constexpr uint64_t IORING_OFF_SQ_RING = 0;
+static constexpr uint64_t IORING_OFF_CQ_RING = 0x8000000ULL;
+static constexpr uint64_t IORING_OFF_SQES = 0x10000000ULL;
+
+struct linux_io_uring_sqe {
+	uint8_t opcode;
+	uint8_t flags;
+	uint16_t ioprio;
+	int32_t fd;
+	uint64_t off;
+	uint64_t addr;
+	uint32_t len;
+	uint32_t op_flags; // fsync_flags, rw_flags, ...
+	uint64_t user_data;
+	uint64_t pad[3];
+};
+
+struct linux_io_uring_cqe {
+	uint64_t user_data;
+	int32_t res;
+	uint32_t flags;
+};
+
+struct linux_io_sqring_offsets {
+	uint32_t head, tail, ring_mask, ring_entries, flags, dropped, array, resv1;
+	uint64_t resv2;
+};
+
+struct linux_io_cqring_offsets {
+	uint32_t head, tail, ring_mask, ring_entries, overflow, cqes, flags, resv1;
+	uint64_t resv2;
+};
+
+struct linux_io_uring_params {
+	uint32_t sq_entries;
+	uint32_t cq_entries;
+	uint32_t flags;
+	uint32_t sq_thread_cpu;
+	uint32_t sq_thread_idle;
+	uint32_t features;
+	uint32_t wq_fd;
+	uint32_t resv[3];
+	linux_io_sqring_offsets sq_off;
+	linux_io_cqring_offsets cq_off;
+};
+
+struct linux_io_uring_files_update {
+	uint32_t offset;
+	uint32_t resv;
+	uint64_t fds; // pointer to an array of int32_t
+};
+
+struct linux_io_uring_probe_op {
+	uint8_t op;
+	uint8_t resv;
+	uint16_t flags; // IO_URING_OP_SUPPORTED
+	uint32_t resv2;
+};
+
+// Followed by ops_len linux_io_uring_probe_op
+struct linux_io_uring_probe {
+	uint8_t last_op;
+	uint8_t ops_len;
+	uint16_t resv;
+	uint32_t resv2[3];
+};
+
+static_assert(sizeof(linux_io_uring_sqe) == 64, "io_uring submission entries are 64 bytes");
+static_assert(sizeof(linux_io_uring_cqe) == 16, "io_uring completion entries are 16 bytes");
+static_assert(sizeof(linux_io_uring_params) == 120, "io_uring_params layout mismatch");
+static_assert(sizeof(linux_io_uring_probe) == 16, "io_uring_probe layout mismatch");
+static_assert(sizeof(linux_io_uring_probe_op) == 8, "io_uring_probe_op layout mismatch");
+
+static int io_uring_setup(unsigned entries, linux_io_uring_params* p) {
+	return syscall(__NR_io_uring_setup, entries, p);
+}
+static int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+	return syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0);
+}
+static int io_uring_register(int fd, unsigned opcode, const void* arg, unsigned nrArgs) {
+	return syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs);
+}
@@ -0,0 +1,762 @@
+/*
+ * ArtVersionHistory.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flow/FastAlloc.h"
+#include "flow/UnitTest.h"
+#include "fdbserver/ArtVersionHistory.h"
+
+// A node's key is the concatenation, along the path from the root, of every node's prefix and the byte selecting the
+// next child. A node holds a boundary if hasValue is set, with that boundary's key being the node's key. Apart from
+// the root, every node either holds a boundary or has at least two children.
+//
+// maxVersion is at least the version of every boundary in the subtree. It is raised when a boundary is set, but is
+// not lowered when boundaries are removed: the keys of a boundary removed by addConflictRange() were just written at
+// a version at least as new as any stale max, and those of a boundary removed by removeBefore() are older than every
+// read version that is still checked. Either way a stale max never reports a conflict that the boundaries would not.
+struct ArtVersionHistory::Node {
+	enum Type : uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+	Type type;
+	bool hasValue;
+	uint16_t childCount;
+	int prefixLength;
+	Version value;
+	Version maxVersion;
+
+	// The prefix is stored after the type-specific part of the node
+	uint8_t* prefix();
+	const uint8_t* prefix() const { return const_cast<Node*>(this)->prefix(); }
+};
+
+namespace {
+
+using Node = ArtVersionHistory::Node;
+
+struct Node4 : Node {
+	uint8_t keys[4];
+	Node* children[4];
+};
+
+struct Node16 : Node {
+	uint8_t keys[16];
+	Node* children[16];
+};
+
+// index holds the slot of each child plus one, or zero for no child. Children are kept in the first childCount slots.
+struct Node48 : Node {
+	uint8_t index[256];
+	Node* children[48];
+};
+
+struct Node256 : Node {
+	Node* children[256];
+};
+
+int nodeSize(Node::Type type) {
+	switch (type) {
+	case Node::Leaf:
+		return sizeof(Node);
+	case Node::Node4:
+		return sizeof(Node4);
+	case Node::Node16:
+		return sizeof(Node16);
+	case Node::Node48:
+		return sizeof(Node48);
+	case Node::Node256:
+		return sizeof(Node256);
+	}
+	UNREACHABLE();
+}
+
+int capacity(Node::Type type) {
+	static const int capacities[] = { 0, 4, 16, 48, 256 };
+	return capacities[type];
+}
+
+Node* newNode(Node::Type type, const uint8_t* prefix, int prefixLength) {
+	const int size = nodeSize(type);
+	Node* n = (Node*)allocateFast(size + prefixLength);
+	memset((void*)n, 0, size);
+	n->type = type;
+	n->prefixLength = prefixLength;
+	memcpy(n->prefix(), prefix, prefixLength);
+	return n;
+}
+
+Node* newLeaf(const uint8_t* prefix, int prefixLength, Version version) {
+	Node* n = newNode(Node::Leaf, prefix, prefixLength);
+	n->hasValue = true;
+	n->value = version;
+	n->maxVersion = version;
+	return n;
+}
+
+void freeNode(Node* n) {
+	freeFast(nodeSize(n->type) + n->prefixLength, n);
+}
+
+void freeTree(Node* n) {
+	switch (n->type) {
+	case Node::Leaf:
+		break;
+	case Node::Node4:
+		for (int i = 0; i < n->childCount; i++)
+			freeTree(static_cast<Node4*>(n)->children[i]);
+		break;
+	case Node::Node16:
+		for (int i = 0; i < n->childCount; i++)
+			freeTree(static_cast<Node16*>(n)->children[i]);
+		break;
+	case Node::Node48:
+		for (int i = 0; i < n->childCount; i++)
+			freeTree(static_cast<Node48*>(n)->children[i]);
+		break;
+	case Node::Node256:
+		for (int c = 0; c < 256; c++)
+			if (static_cast<Node256*>(n)->children[c])
+				freeTree(static_cast<Node256*>(n)->children[c]);
+		break;
+	}
+	freeNode(n);
+}
+
+// Returns a copy of n with the given prefix and frees n. The prefix may point into n.
+Node* replacePrefix(Node* n, const uint8_t* prefix, int prefixLength) {
+	const int size = nodeSize(n->type);
+	Node* r = (Node*)allocateFast(size + prefixLength);
+	memcpy((void*)r, n, size);
+	r->prefixLength = prefixLength;
+	memcpy(r->prefix(), prefix, prefixLength);
+	freeNode(n);
+	return r;
+}
+
+// Returns the slot holding the child of n for byte c, or nullptr
+Node** findChild(Node* n, uint8_t c) {
+	switch (n->type) {
+	case Node::Leaf:
+		return nullptr;
+	case Node::Node4: {
+		Node4* n4 = static_cast<Node4*>(n);
+		for (int i = 0; i < n->childCount; i++)
+			if (n4->keys[i] == c)
+				return &n4->children[i];
+		return nullptr;
+	}
+	case Node::Node16: {
+		Node16* n16 = static_cast<Node16*>(n);
+		__m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(c), _mm_loadu_si128((const __m128i*)n16->keys));
+		int mask = _mm_movemask_epi8(cmp) & ((1 << n->childCount) - 1);
+		return mask ? &n16->children[ctz(mask)] : nullptr;
+	}
+	case Node::Node48: {
+		Node48* n48 = static_cast<Node48*>(n);
+		return n48->index[c] ? &n48->children[n48->index[c] - 1] : nullptr;
+	}
+	case Node::Node256: {
+		Node256* n256 = static_cast<Node256*>(n);
+		return n256->children[c] ? &n256->children[c] : nullptr;
+	}
+	}
+	UNREACHABLE();
+}
+
+const Node* findChild(const Node* n, uint8_t c) {
+	Node* const* child = findChild(const_cast<Node*>(n), c);
+	return child ? *child : nullptr;
+}
+
+// Calls f(c, child) for the children of n with bytes in [from, to], in order, until f returns false
+template <class F>
+void forEachChild(const Node* n, int from, int to, F&& f) {
+	switch (n->type) {
+	case Node::Leaf:
+		return;
+	case Node::Node4:
+	case Node::Node16: {
+		const uint8_t* keys =
+		    n->type == Node::Node4 ? static_cast<const Node4*>(n)->keys : static_cast<const Node16*>(n)->keys;
+		Node* const* children =
+		    n->type == Node::Node4 ? static_cast<const Node4*>(n)->children : static_cast<const Node16*>(n)->children;
+		for (int i = 0; i < n->childCount && keys[i] <= to; i++)
+			if (keys[i] >= from && !f(keys[i], children[i]))
+				return;
+		return;
+	}
+	case Node::Node48: {
+		const Node48* n48 = static_cast<const Node48*>(n);
+		for (int c = from; c <= to; c++)
+			if (n48->index[c] && !f(c, n48->children[n48->index[c] - 1]))
+				return;
+		return;
+	}
+	case Node::Node256: {
+		const Node256* n256 = static_cast<const Node256*>(n);
+		for (int c = from; c <= to; c++)
+			if (n256->children[c] && !f(c, n256->children[c]))
+				return;
+		return;
+	}
+	}
+}
+
+// Returns the child of n with the greatest byte less than c, or nullptr
+const Node* lastChildBefore(const Node* n, int c) {
+	switch (n->type) {
+	case Node::Leaf:
+		return nullptr;
+	case Node::Node4:
+	case Node::Node16: {
+		const uint8_t* keys =
+		    n->type == Node::Node4 ? static_cast<const Node4*>(n)->keys : static_cast<const Node16*>(n)->keys;
+		Node* const* children =
+		    n->type == Node::Node4 ? static_cast<const Node4*>(n)->children : static_cast<const Node16*>(n)->children;
+		for (int i = n->childCount - 1; i >= 0; i--)
+			if (keys[i] < c)
+				return children[i];
+		return nullptr;
+	}
+	case Node::Node48: {
+		const Node48* n48 = static_cast<const Node48*>(n);
+		for (int b = c - 1; b >= 0; b--)
+			if (n48->index[b])
+				return n48->children[n48->index[b] - 1];
+		return nullptr;
+	}
+	case Node::Node256: {
+		const Node256* n256 = static_cast<const Node256*>(n);
+		for (int b = c - 1; b >= 0; b--)
+			if (n256->children[b])
+				return n256->children[b];
+		return nullptr;
+	}
+	}
+	UNREACHABLE();
+}
+
+// Returns a copy of n of the given type, with the same children, and frees n
+Node* resize(Node* n, Node::Type type) {
+	Node* r = newNode(type, n->prefix(), n->prefixLength);
+	r->hasValue = n->hasValue;
+	r->value = n->value;
+	r->maxVersion = n->maxVersion;
+	forEachChild(n, 0, 255, [&](int c, Node* child) {
+		// Children arrive in order, so appending keeps Node4 and Node16 sorted
+		switch (type) {
+		case Node::Node4:
+		case Node::Node16: {
+			uint8_t* keys = type == Node::Node4 ? static_cast<Node4*>(r)->keys : static_cast<Node16*>(r)->keys;
+			Node** children =
+			    type == Node::Node4 ? static_cast<Node4*>(r)->children : static_cast<Node16*>(r)->children;
+			keys[r->childCount] = c;
+			children[r->childCount] = child;
+			break;
+		}
+		case Node::Node48:
+			static_cast<Node48*>(r)->index[c] = r->childCount + 1;
+			static_cast<Node48*>(r)->children[r->childCount] = child;
+			break;
+		case Node::Node256:
+			static_cast<Node256*>(r)->children[c] = child;
+			break;
+		case Node::Leaf:
+			UNREACHABLE();
+		}
+		r->childCount++;
+		return true;
+	});
+	freeNode(n);
+	return r;
+}
+
+// Adds child for byte c to *ref, growing the node if it is full
+void addChild(Node** ref, uint8_t c, Node* child) {
+	Node* n = *ref;
+	if (n->childCount == capacity(n->type))
+		*ref = n = resize(n, Node::Type(n->type + 1));
+
+	switch (n->type) {
+	case Node::Node4:
+	case Node::Node16: {
+		uint8_t* keys = n->type == Node::Node4 ? static_cast<Node4*>(n)->keys : static_cast<Node16*>(n)->keys;
+		Node** children = n->type == Node::Node4 ? static_cast<Node4*>(n)->children : static_cast<Node16*>(n)->children;
+		int i = 0;
+		while (i < n->childCount && keys[i] < c)
+			i++;
+		memmove(keys + i + 1, keys + i, n->childCount - i);
+		memmove(children + i + 1, children + i, (n->childCount - i) * sizeof(Node*));
+		keys[i] = c;
+		children[i] = child;
+		break;
+	}
+	case Node::Node48:
+		static_cast<Node48*>(n)->index[c] = n->childCount + 1;
+		static_cast<Node48*>(n)->children[n->childCount] = child;
+		break;
+	case Node::Node256:
+		static_cast<Node256*>(n)->children[c] = child;
+		break;
+	case Node::Leaf:
+		UNREACHABLE();
+	}
+	n->childCount++;
+}
+
+// Removes the (already freed) child for byte c from *ref, shrinking the node once it is sparse
+void removeChild(Node** ref, uint8_t c) {
+	Node* n = *ref;
+	switch (n->type) {
+	case Node::Node4:
+	case Node::Node16: {
+		uint8_t* keys = n->type == Node::Node4 ? static_cast<Node4*>(n)->keys : static_cast<Node16*>(n)->keys;
+		Node** children = n->type == Node::Node4 ? static_cast<Node4*>(n)->children : static_cast<Node16*>(n)->children;
+		int i = 0;
+		while (keys[i] != c)
+			i++;
+		memmove(keys + i, keys + i + 1, n->childCount - i - 1);
+		memmove(children + i, children + i + 1, (n->childCount - i - 1) * sizeof(Node*));
+		break;
+	}
+	case Node::Node48: {
+		// Move the last child into the freed slot to keep the children contiguous
+		Node48* n48 = static_cast<Node48*>(n);
+		const int slot = n48->index[c] - 1;
+		const int last = n->childCount - 1;
+		n48->index[c] = 0;
+		if (slot != last) {
+			n48->children[slot] = n48->children[last];
+			for (int b = 0; b < 256; b++) {
+				if (n48->index[b] == last + 1) {
+					n48->index[b] = slot + 1;
+					break;
+				}
+			}
+		}
+		break;
+	}
+	case Node::Node256:
+		static_cast<Node256*>(n)->children[c] = nullptr;
+		break;
+	case Node::Leaf:
+		UNREACHABLE();
+	}
+	n->childCount--;
+
+	// Shrink with some hysteresis, so that alternating adds and removes do not resize every time
+	if (n->type == Node::Node256 && n->childCount <= 40)
+		*ref = resize(n, Node::Node48);
+	else if (n->type == Node::Node48 && n->childCount <= 12)
+		*ref = resize(n, Node::Node16);
+	else if (n->type == Node::Node16 && n->childCount <= 3)
+		*ref = resize(n, Node::Node4);
+	else if (n->type == Node::Node4 && n->childCount == 0)
+		*ref = resize(n, Node::Leaf);
+}
+
+// Restores the invariant that a node other than the root holds a boundary or has at least two children, after
+// something was removed from *ref
+void compress(Node** ref) {
+	Node* n = *ref;
+	if (n->hasValue || n->childCount > 1)
+		return;
+	if (n->childCount == 0) {
+		freeNode(n);
+		*ref = nullptr;
+		return;
+	}
+
+	// Merge n into its only child. The child's max version is kept, since n's might come from n's own boundary.
+	uint8_t c = 0;
+	Node* child = nullptr;
+	forEachChild(n, 0, 255, [&](int b, Node* ch) {
+		c = b;
+		child = ch;
+		return false;
+	});
+	std::string prefix;
+	prefix.reserve(n->prefixLength + 1 + child->prefixLength);
+	prefix.append((const char*)n->prefix(), n->prefixLength);
+	prefix.push_back(c);
+	prefix.append((const char*)child->prefix(), child->prefixLength);
+	freeNode(n);
+	*ref = replacePrefix(child, (const uint8_t*)prefix.data(), prefix.size());
+}
+
+// Compares the prefix of n, found at the given depth of a key, with bound. Returns -1 if every key of n's subtree
+// sorts before bound, +1 if every key sorts after it, and 0 otherwise (bound extends past the end of the prefix, or
+// ends right at it).
+int comparePrefix(const Node* n, int depth, const StringRef& bound) {
+	const int length = std::min(n->prefixLength, bound.size() - depth);
+	const int p = commonPrefixLength(n->prefix(), bound.begin() + depth, length);
+	if (p < length)
+		return n->prefix()[p] < bound[depth + p] ? -1 : +1;
+	// bound ends inside the prefix
+	return p < n->prefixLength ? +1 : 0;
+}
+
+// Returns true if a boundary in n's subtree that is in [*begin, *end) has a version greater than the given one. A
+// null begin or end means that bound is already satisfied by every key of the subtree.
+bool anyNewer(const Node* n, int depth, const StringRef* begin, const StringRef* end, Version version) {
+	if (n->maxVersion <= version)
+		return false;
+	if (begin) {
+		const int c = comparePrefix(n, depth, *begin);
+		if (c < 0)
+			return false;
+		if (c > 0)
+			begin = nullptr;
+	}
+	if (end) {
+		const int c = comparePrefix(n, depth, *end);
+		if (c > 0)
+			return false;
+		if (c < 0)
+			end = nullptr;
+	}
+	if (!begin && !end)
+		return true;
+
+	depth += n->prefixLength;
+	if (end && end->size() == depth)
+		return false;
+	if (begin && begin->size() == depth)
+		begin = nullptr;
+	if (!begin && n->hasValue && n->value > version)
+		return true;
+
+	const int from = begin ? (*begin)[depth] : 0;
+	const int to = end ? (*end)[depth] : 255;
+	bool found = false;
+	forEachChild(n, from, to, [&](int c, const Node* child) {
+		found = anyNewer(child, depth + 1, c == from ? begin : nullptr, c == to ? end : nullptr, version);
+		return !found;
+	});
+	return found;
+}
+
+// Returns the version of the greatest boundary that is not after key
+Version floorVersion(const Node* root, const StringRef& key) {
+	// The greatest boundary is either on key's path, or the last boundary of a subtree just before the path. Every
+	// candidate found while descending is greater than the previous one.
+	const Node* best = nullptr;
+	bool bestIsSubtree = false;
+	const Node* n = root;
+	int depth = 0;
+	while (true) {
+		const int c = comparePrefix(n, depth, key);
+		if (c < 0) {
+			best = n;
+			bestIsSubtree = true;
+		}
+		if (c != 0)
+			break;
+		depth += n->prefixLength;
+		if (n->hasValue) {
+			best = n;
+			bestIsSubtree = false;
+		}
+		if (key.size() == depth)
+			break;
+		if (const Node* left = lastChildBefore(n, key[depth])) {
+			best = left;
+			bestIsSubtree = true;
+		}
+		const Node* next = findChild(n, key[depth]);
+		if (!next)
+			break;
+		n = next;
+		depth++;
+	}
+	if (bestIsSubtree) {
+		while (best->childCount)
+			best = lastChildBefore(best, 256);
+	}
+	return best->value;
+}
+
+// Sets the boundary at key, adding it if it does not exist
+void insert(Node** ref, const StringRef& key, Version version) {
+	int depth = 0;
+	while (true) {
+		Node* n = *ref;
+		const int length = std::min(n->prefixLength, key.size() - depth);
+		const int p = commonPrefixLength(n->prefix(), key.begin() + depth, length);
+		if (p < n->prefixLength) {
+			// key leaves the prefix of n, so a new node takes n's place with the common part as its prefix
+			Node* parent = newNode(Node::Node4, n->prefix(), p);
+			parent->maxVersion = std::max(n->maxVersion, version);
+			const uint8_t c = n->prefix()[p];
+			addChild(&parent, c, replacePrefix(n, n->prefix() + p + 1, n->prefixLength - p - 1));
+			if (depth + p == key.size()) {
+				parent->hasValue = true;
+				parent->value = version;
+			} else {
+				addChild(&parent,
+				         key[depth + p],
+				         newLeaf(key.begin() + depth + p + 1, key.size() - depth - p - 1, version));
+			}
+			*ref = parent;
+			return;
+		}
+
+		n->maxVersion = std::max(n->maxVersion, version);
+		depth += p;
+		if (depth == key.size()) {
+			n->hasValue = true;
+			n->value = version;
+			return;
+		}
+		Node** child = findChild(n, key[depth]);
+		if (!child) {
+			addChild(ref, key[depth], newLeaf(key.begin() + depth + 1, key.size() - depth - 1, version));
+			return;
+		}
+		ref = child;
+		depth++;
+	}
+}
+
+// Removes the boundaries in [*begin, *end) from the subtree at *ref, with null bounds as in anyNewer(). The root is
+// never removed or merged into a child.
+void removeRange(Node** ref, int depth, const StringRef* begin, const StringRef* end, bool isRoot) {
+	Node* n = *ref;
+	if (begin) {
+		const int c = comparePrefix(n, depth, *begin);
+		if (c < 0)
+			return;
+		if (c > 0)
+			begin = nullptr;
+	}
+	if (end) {
+		const int c = comparePrefix(n, depth, *end);
+		if (c > 0)
+			return;
+		if (c < 0)
+			end = nullptr;
+	}
+	if (!begin && !end && !isRoot) {
+		freeTree(n);
+		*ref = nullptr;
+		return;
+	}
+
+	depth += n->prefixLength;
+	if (end && end->size() == depth)
+		return;
+	if (begin && begin->size() == depth)
+		begin = nullptr;
+	if (!begin)
+		n->hasValue = false;
+
+	const int from = begin ? (*begin)[depth] : 0;
+	const int to = end ? (*end)[depth] : 255;
+	uint8_t bytes[256];
+	int count = 0;
+	forEachChild(n, from, to, [&](int c, Node*) {
+		bytes[count++] = c;
+		return true;
+	});
+	for (int i = 0; i < count; i++) {
+		const uint8_t c = bytes[i];
+		Node** child = findChild(*ref, c);
+		removeRange(child, depth + 1, c == from ? begin : nullptr, c == to ? end : nullptr, false);
+		if (!*child)
+			removeChild(ref, c);
+	}
+	if (!isRoot)
+		compress(ref);
+}
+
+// Appends the boundaries of n's subtree that are not before *begin to out, in order, until it holds limit entries.
+// path holds the key of n's parent, followed by the byte selecting n.
+void collect(const Node* n,
+             std::string& path,
+             const StringRef* begin,
+             Arena& arena,
+             std::vector<std::pair<StringRef, Version>>& out,
+             int limit) {
+	const int depth = path.size();
+	if (begin) {
+		const int c = comparePrefix(n, depth, *begin);
+		if (c < 0)
+			return;
+		if (c > 0)
+			begin = nullptr;
+	}
+	path.append((const char*)n->prefix(), n->prefixLength);
+	if (begin && begin->size() == path.size())
+		begin = nullptr;
+	if (!begin && n->hasValue)
+		out.emplace_back(StringRef(arena, StringRef(path)), n->value);
+
+	const int from = begin ? (*begin)[path.size()] : 0;
+	forEachChild(n, from, 255, [&](int c, const Node* child) {
+		if (out.size() >= limit)
+			return false;
+		path.push_back(c);
+		collect(child, path, c == from ? begin : nullptr, arena, out, limit);
+		path.pop_back();
+		return true;
+	});
+	path.resize(depth);
+}
+
+int countBoundaries(const Node* n) {
+	int count = n->hasValue;
+	forEachChild(n, 0, 255, [&](int, const Node* child) {
+		count += countBoundaries(child);
+		return true;
+	});
+	return count;
+}
+
+} // namespace
+
+uint8_t* ArtVersionHistory::Node::prefix() {
+	return (uint8_t*)this + nodeSize(type);
+}
+
+ArtVersionHistory::ArtVersionHistory(Version version) {
+	root = newLeaf(nullptr, 0, version);
+}
+
+ArtVersionHistory::~ArtVersionHistory() {
+	if (root)
+		freeTree(root);
+}
+
+bool ArtVersionHistory::detectConflict(const StringRef& begin, const StringRef& end, Version version) const {
+	// The range [begin, end) is covered by the boundary at or before begin, and those after it up to end
+	return floorVersion(root, begin) > version || anyNewer(root, 0, &begin, &end, version);
+}
+
+void ArtVersionHistory::addConflictRange(const StringRef& begin, const StringRef& end, Version version) {
+	// The keys from end on keep the version they had
+	insert(&root, end, floorVersion(root, end));
+	removeRange(&root, 0, &begin, &end, true);
+	insert(&root, begin, version);
+}
+
+int ArtVersionHistory::removeBefore(Version version, Key& removalKey, int nodeCount) {
+	Arena arena;
+	std::vector<std::pair<StringRef, Version>> boundaries;
+	std::string path;
+	StringRef begin = removalKey;
+	collect(root, path, &begin, arena, boundaries, nodeCount + 1);
+
+	int removedCount = 0;
+	bool wasAbove = true;
+	const int visited = std::min<int>(nodeCount, boundaries.size());
+	for (int i = 0; i < visited; i++) {
+		const bool isAbove = boundaries[i].second >= version;
+		if (!isAbove && !wasAbove) {
+			const StringRef& key = boundaries[i].first;
+			const StringRef after = keyAfter(key, arena);
+			removeRange(&root, 0, &key, &after, true);
+			removedCount++;
+		}
+		wasAbove = isAbove;
+	}
+	removalKey = visited < boundaries.size() ? Key(boundaries[visited].first) : Key();
+	return removedCount;
+}
+
+int ArtVersionHistory::count() const {
+	return countBoundaries(root);
+}
+
+// Checks random writes, conflict checks and removals against a std::map of boundaries
+TEST_CASE("/fdbserver/ArtVersionHistory/model") {
+	// Small alphabets make for deep paths and shared prefixes, large ones for wide nodes
+	const int alphabet = deterministicRandom()->coinflip() ? 3 : 256;
+	const int maxLength = alphabet == 3 ? 6 : 3;
+	auto randomKey = [&](Arena& arena) {
+		int length = deterministicRandom()->randomInt(0, maxLength + 1);
+		uint8_t* s = new (arena) uint8_t[length];
+		for (int i = 0; i < length; i++)
+			s[i] = alphabet == 3 ? 'a' + deterministicRandom()->randomInt(0, 3)
+			                     : deterministicRandom()->randomInt(0, 256);
+		return StringRef(s, length);
+	};
+
+	ArtVersionHistory history(1);
+	std::map<Key, Version> model = { { Key(), 1 } };
+	auto floor = [&](const StringRef& key) { return std::prev(model.upper_bound(key))->second; };
+
+	Version version = 1;
+	Version oldestVersion = 0; // As in the conflict set, reads older than this are not checked
+	Key removalKey;
+	for (int i = 0; i < 20000; i++) {
+		Arena arena;
+		StringRef a = randomKey(arena), b = randomKey(arena);
+		if (b < a)
+			std::swap(a, b);
+		if (a == b)
+			b = keyAfter(a, arena);
+
+		const int op = deterministicRandom()->randomInt(0, 10);
+		if (op < 5) {
+			version += deterministicRandom()->randomInt(0, 3);
+			Version end = floor(b);
+			model.erase(model.lower_bound(a), model.lower_bound(b));
+			model[b] = end;
+			model[a] = version;
+			history.addConflictRange(a, b, version);
+		} else if (op < 9) {
+			const Version readVersion = deterministicRandom()->randomInt64(oldestVersion, version + 1);
+			bool expected = floor(a) > readVersion;
+			for (auto it = model.upper_bound(a); it != model.end() && it->first < b; ++it)
+				expected = expected || it->second > readVersion;
+			ASSERT_EQ(history.detectConflict(a, b, readVersion), expected);
+		} else {
+			// Unlike the conflict set, this compares the boundaries exactly, so removals are decided by the model
+			oldestVersion = std::max(oldestVersion, version - deterministicRandom()->randomInt(0, 20));
+			const Version oldest = oldestVersion;
+			const int nodeCount = deterministicRandom()->randomInt(1, 20);
+			Key expectedRemovalKey;
+			int expectedRemoved = 0;
+			bool wasAbove = true;
+			auto it = model.lower_bound(removalKey);
+			for (int n = 0; n < nodeCount && it != model.end(); n++) {
+				const bool isAbove = it->second >= oldest;
+				if (!isAbove && !wasAbove) {
+					it = model.erase(it);
+					expectedRemoved++;
+				} else {
+					++it;
+				}
+				wasAbove = isAbove;
+			}
+			if (it != model.end())
+				expectedRemovalKey = it->first;
+			ASSERT_EQ(history.removeBefore(oldest, removalKey, nodeCount), expectedRemoved);
+			ASSERT(removalKey == expectedRemovalKey);
+		}
+		if (i % 1000 == 0)
+			ASSERT_EQ(history.count(), model.size());
+	}
+	ASSERT_EQ(history.count(), model.size());
+	return Void();
+}
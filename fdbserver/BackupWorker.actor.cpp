@@ -33,9 +33,12 @@
 #include "fdbserver/ServerDBInfo.h"
 #include "fdbserver/WaitFailure.h"
 #include "fdbserver/WorkerInterface.actor.h"
+#include "flow/CompressionUtils.h"
+#include "flow/Deque.h"
 #include "flow/Error.h"
 
 #include "flow/IRandom.h"
+#include "flow/UnitTest.h"
 #include "fdbclient/Tracing.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
@@ -274,7 +277,11 @@ struct BackupData {
 	AsyncTrigger changedTrigger;
 	AsyncTrigger doneTrigger;
 
+	int uploadsInFlight = 0; // Version ranges being written to backup containers
+
 	CounterCollection cc;
+	Counter uploadedBytes; // Bytes of mutation log files written
+	Counter uploadedMutations;
 	Future<Void> logger;
 
 	explicit BackupData(UID id, Reference<AsyncVar<ServerDBInfo> const> db, const InitializeBackupRequest& req)
@@ -282,11 +289,16 @@ struct BackupData {
 	    endVersion(req.endVersion), recruitedEpoch(req.recruitedEpoch), backupEpoch(req.backupEpoch),
 	    minKnownCommittedVersion(invalidVersion), savedVersion(req.startVersion - 1), popVersion(req.startVersion - 1),
 	    db(db), pulledVersion(0), paused(false), lock(new FlowLock(SERVER_KNOBS->BACKUP_LOCK_BYTES)),
-	    cc("BackupWorker", myId.toString()) {
+	    cc("BackupWorker", myId.toString()), uploadedBytes("UploadedBytes", cc),
+	    uploadedMutations("UploadedMutations", cc) {
 		cx = openDBOnServer(db, TaskPriority::DefaultEndpoint, LockAware::True);
 
 		specialCounter(cc, "SavedVersion", [this]() { return this->savedVersion; });
 		specialCounter(cc, "MinKnownCommittedVersion", [this]() { return this->minKnownCommittedVersion; });
+		specialCounter(cc, "VersionLag", [this]() {
+			return std::max<Version>(0, this->minKnownCommittedVersion - this->savedVersion);
+		});
+		specialCounter(cc, "UploadsInFlight", [this]() { return this->uploadsInFlight; });
 		specialCounter(cc, "MsgQ", [this]() { return this->messages.size(); });
 		specialCounter(cc, "BufferedBytes", [this]() { return this->lock->activePermits(); });
 		specialCounter(cc, "AvailableBytes", [this]() { return this->lock->available(); });
@@ -701,6 +713,110 @@ ACTOR Future<Void> addMutation(Reference<IBackupFile> logFile,
 	return Void();
 }
 
+// Writes the mutations of a partitioned log file as PARTITIONED_MLOG_COMPRESSED_VERSION blocks. Mutations are buffered
+// until they are expected to fill a block once compressed, going by the ratio of the previous block. Mutations that do
+// not compress into a block are written as a PARTITIONED_MLOG_VERSION block instead.
+struct CompressedLogFileWriter : ReferenceCounted<CompressedLogFileWriter> {
+	// Block version, compression filter and compressed size
+	static constexpr int headerBytes = sizeof(uint32_t) + 2 * sizeof(int32_t);
+	static constexpr double maxRatio = 8.0;
+
+	Reference<IBackupFile> file;
+	const int blockSize;
+	const CompressionFilter filter;
+	std::string pending; // Serialized mutations not written yet
+	std::vector<int> pendingEnds; // End offset of each mutation in pending
+	double ratio = 1.0;
+
+	CompressedLogFileWriter(Reference<IBackupFile> file, int blockSize, CompressionFilter filter)
+	  : file(file), blockSize(blockSize), filter(filter) {}
+
+	// Adds a mutation in the format of addMutation(), writing out blocks once enough mutations are buffered.
+	Future<Void> add(const VersionedMessage& message, StringRef mutation) {
+		const uint64_t version = bigEndian64(message.version.version);
+		const uint32_t sub = bigEndian32(message.version.sub);
+		const uint32_t size = bigEndian32(mutation.size());
+		pending.append((const char*)&version, sizeof(version));
+		pending.append((const char*)&sub, sizeof(sub));
+		pending.append((const char*)&size, sizeof(size));
+		pending.append((const char*)mutation.begin(), mutation.size());
+		pendingEnds.push_back(pending.size());
+
+		if (pending.size() < (blockSize - headerBytes) * ratio) {
+			return Void();
+		}
+		return writeBlocks(this, false);
+	}
+
+	// Writes out the remaining mutations and finishes the file.
+	Future<Void> finish() { return _finish(this); }
+
+private:
+	// Returns the number of pending mutations that fit in "bytes", which is at least one.
+	int mutationsWithin(double bytes) const {
+		int n = std::upper_bound(pendingEnds.begin(), pendingEnds.end(), bytes) - pendingEnds.begin();
+		return std::max(n, 1);
+	}
+
+	// Builds the next block out of the pending mutations and removes them from pending. Only the last block of the
+	// file is not padded.
+	Standalone<StringRef> nextBlock(bool final) {
+		const int capacity = blockSize - headerBytes;
+		int n = mutationsWithin(capacity * ratio);
+		Arena arena;
+		StringRef compressed =
+		    CompressionUtils::compress(filter, StringRef((uint8_t*)pending.data(), pendingEnds[n - 1]), arena);
+		if (compressed.size() > capacity && n > 1) {
+			// Retry with the share of the mutations that should fit at the ratio just seen
+			n = mutationsWithin(0.9 * pendingEnds[n - 1] * capacity / compressed.size());
+			compressed =
+			    CompressionUtils::compress(filter, StringRef((uint8_t*)pending.data(), pendingEnds[n - 1]), arena);
+		}
+
+		BinaryWriter wr(Unversioned());
+		if (compressed.size() <= capacity) {
+			ratio = std::clamp((double)pendingEnds[n - 1] / std::max(compressed.size(), 1), 1.0, maxRatio);
+			wr << PARTITIONED_MLOG_COMPRESSED_VERSION << (int32_t)filter << (int32_t)compressed.size();
+			wr.serializeBytes(compressed);
+		} else {
+			ratio = 1.0;
+			n = mutationsWithin(blockSize - sizeof(PARTITIONED_MLOG_VERSION));
+			wr << PARTITIONED_MLOG_VERSION;
+			wr.serializeBytes(pending.data(), pendingEnds[n - 1]);
+		}
+
+		const int used = pendingEnds[n - 1];
+		pending.erase(0, used);
+		pendingEnds.erase(pendingEnds.begin(), pendingEnds.begin() + n);
+		for (int& end : pendingEnds) {
+			end -= used;
+		}
+		if (!final || !pendingEnds.empty()) {
+			const int bytesLeft = blockSize - wr.getLength();
+			if (bytesLeft > 0) {
+				wr.serializeBytes(fileBackup::makePadding(bytesLeft));
+			}
+		}
+		return wr.toValue();
+	}
+
+	ACTOR static Future<Void> writeBlocks(CompressedLogFileWriter* self, bool final) {
+		state Standalone<StringRef> block;
+		while (!self->pendingEnds.empty() &&
+		       (final || self->pending.size() >= (self->blockSize - self->headerBytes) * self->ratio)) {
+			block = self->nextBlock(final);
+			wait(self->file->append(block.begin(), block.size()));
+		}
+		return Void();
+	}
+
+	ACTOR static Future<Void> _finish(CompressedLogFileWriter* self) {
+		wait(writeBlocks(self, true));
+		wait(self->file->finish());
+		return Void();
+	}
+};
+
 ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
                                                 std::vector<UID> backupUids,
                                                 std::vector<Reference<IBackupFile>> logFiles) {
@@ -725,16 +841,20 @@ ACTOR static Future<Void> updateLogBytesWritten(BackupData* self,
 	}
 }
 
-// Saves messages in the range of [0, numMsg) to a file and then remove these
-// messages. The file content format is a sequence of (Version, sub#, msgSize, message).
-// Note only ready backups are saved.
+// Saves messages up to popVersion to a file. The file content format is a sequence of
+// (Version, sub#, msgSize, message), compressed per block if BACKUP_LOG_COMPRESSION_FILTER is set.
+// beginVersion is the first version of the range being saved, or invalidVersion if no earlier range is still being
+// uploaded. Note only ready backups are saved.
 ACTOR Future<Void> saveMutationsToFile(BackupData* self,
+                                       Version beginVersion,
                                        Version popVersion,
-                                       int numMsg,
+                                       std::vector<VersionedMessage> messages,
                                        std::unordered_set<BlobCipherDetails> cipherDetails) {
 	state int blockSize = SERVER_KNOBS->BACKUP_FILE_BLOCK_BYTES;
+	state CompressionFilter filter = CompressionUtils::fromFilterString(SERVER_KNOBS->BACKUP_LOG_COMPRESSION_FILTER);
 	state std::vector<Future<Reference<IBackupFile>>> logFileFutures;
 	state std::vector<Reference<IBackupFile>> logFiles;
+	state std::vector<Reference<CompressedLogFileWriter>> writers; // Used instead of addMutation() if compressing
 	state std::vector<int64_t> blockEnds;
 	state std::vector<UID> activeUids; // active Backups' UIDs
 	state std::vector<Version> beginVersions; // logFiles' begin versions
@@ -759,9 +879,12 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		self->insertRanges(keyRangeMap, it->second.ranges.get(), index);
 
 		if (it->second.lastSavedVersion == invalidVersion) {
-			if (it->second.startVersion > self->startVersion && !self->messages.empty()) {
+			if (it->second.startVersion > self->startVersion && !messages.empty()) {
 				// True-up first mutation log's begin version
-				it->second.lastSavedVersion = self->messages[0].getVersion();
+				it->second.lastSavedVersion = messages[0].getVersion();
+			} else if (beginVersion != invalidVersion) {
+				// Uploads still in flight own the versions before this range, which savedVersion doesn't cover yet
+				it->second.lastSavedVersion = std::max(beginVersion, self->startVersion);
 			} else {
 				it->second.lastSavedVersion = std::max({ self->popVersion, self->savedVersion, self->startVersion });
 			}
@@ -773,6 +896,8 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 
 		logFileFutures.push_back(it->second.container.get().get()->writeTaggedLogFile(
 		    it->second.lastSavedVersion, popVersion + 1, blockSize, self->tag.id, self->totalTags));
+		// The next version range may be saved before this one finishes.
+		it->second.lastSavedVersion = popVersion + 1;
 		it++;
 	}
 
@@ -799,9 +924,14 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		cipherKeys = getCipherKeysResult;
 	}
 
+	if (filter != CompressionFilter::NONE) {
+		for (const auto& file : logFiles) {
+			writers.push_back(makeReference<CompressedLogFileWriter>(file, blockSize, filter));
+		}
+	}
 	blockEnds = std::vector<int64_t>(logFiles.size(), 0);
-	for (idx = 0; idx < numMsg; idx++) {
-		auto& message = self->messages[idx];
+	for (idx = 0; idx < messages.size(); idx++) {
+		auto& message = messages[idx];
 		MutationRef m;
 		if (!message.isCandidateBackupMessage(&m, cipherKeys))
 			continue;
@@ -815,7 +945,9 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 			for (int index : keyRangeMap[m.param1]) {
 				if (message.getVersion() >= beginVersions[index]) {
 					adds.push_back(
-					    addMutation(logFiles[index], message, message.message, &blockEnds[index], blockSize));
+					    writers.empty()
+					        ? addMutation(logFiles[index], message, message.message, &blockEnds[index], blockSize)
+					        : writers[index]->add(message, message.message));
 				}
 			}
 		} else {
@@ -833,19 +965,22 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 				for (int index : range.value()) {
 					if (message.getVersion() >= beginVersions[index]) {
 						adds.push_back(
-						    addMutation(logFiles[index], message, mutations.back(), &blockEnds[index], blockSize));
+						    writers.empty()
+						        ? addMutation(logFiles[index], message, mutations.back(), &blockEnds[index], blockSize)
+						        : writers[index]->add(message, mutations.back()));
 					}
 				}
 			}
 		}
+		self->uploadedMutations += adds.size();
 		wait(waitForAll(adds));
 		mutations.clear();
 	}
 
 	std::vector<Future<Void>> finished;
-	std::transform(logFiles.begin(), logFiles.end(), std::back_inserter(finished), [](const Reference<IBackupFile>& f) {
-		return f->finish();
-	});
+	for (int i = 0; i < logFiles.size(); i++) {
+		finished.push_back(writers.empty() ? logFiles[i]->finish() : writers[i]->finish());
+	}
 
 	wait(waitForAll(finished));
 
@@ -853,19 +988,28 @@ ACTOR Future<Void> saveMutationsToFile(BackupData* self,
 		TraceEvent("CloseMutationFile", self->myId)
 		    .detail("FileSize", file->size())
 		    .detail("TagId", self->tag.id)
-		    .detail("File", file->getFileName());
-	}
-	for (const UID& uid : activeUids) {
-		self->backups[uid].lastSavedVersion = popVersion + 1;
+		    .detail("File", file->getFileName())
+		    .detail("Compression", CompressionUtils::toString(filter));
+		self->uploadedBytes += file->size();
 	}
 
 	wait(updateLogBytesWritten(self, activeUids, logFiles));
 	return Void();
 }
 
-// Uploads self->messages to cloud storage and updates savedVersion.
+// A version range of self->messages being written to backup containers by saveMutationsToFile()
+struct PendingUpload {
+	Future<Void> done;
+	Version version; // Last version of the range
+	int numMsg; // Number of messages of the range, which follow the messages of earlier pending uploads
+};
+
+// Uploads self->messages to cloud storage and updates savedVersion. Up to BACKUP_MAX_CONCURRENT_UPLOADS version ranges
+// are written at once, and their messages are erased and progress saved in version order.
 ACTOR Future<Void> uploadData(BackupData* self) {
 	state Version popVersion = invalidVersion;
+	state Deque<PendingUpload> uploads;
+	state int uploadingMsgs = 0; // Messages at the front of self->messages that belong to "uploads"
 
 	loop {
 		// Too large uploadDelay will delay popping tLog data for too long.
@@ -873,18 +1017,20 @@ ACTOR Future<Void> uploadData(BackupData* self) {
 
 		state int numMsg = 0;
 		state std::unordered_set<BlobCipherDetails> cipherDetails;
+		state Version progressVersion = invalidVersion;
 		Version lastPopVersion = popVersion;
 		// index of last version's end position in self->messages
 		int lastVersionIndex = 0;
 		Version lastVersion = invalidVersion;
 
-		if (self->messages.empty()) {
-			// Even though messages is empty, we still want to advance popVersion.
+		if (self->messages.size() == uploadingMsgs) {
+			// Even though there are no new messages, we still want to advance popVersion.
 			if (!self->endVersion.present()) {
 				popVersion = std::max(popVersion, self->minKnownCommittedVersion);
 			}
 		} else {
-			for (auto& message : self->messages) {
+			for (int i = uploadingMsgs; i < self->messages.size(); i++) {
+				auto& message = self->messages[i];
 				// message may be prefetched in peek; uncommitted message should not be uploaded.
 				const Version version = message.getVersion();
 				if (version > self->maxPopVersion())
@@ -907,7 +1053,7 @@ ACTOR Future<Void> uploadData(BackupData* self) {
 
 			// If we aren't able to process any messages and the lock is blocking us from
 			// queuing more, then we are stuck. This could suggest the lock capacity is too small.
-			ASSERT(numMsg > 0 || self->lock->waiters() == 0);
+			ASSERT(numMsg > 0 || !uploads.empty() || self->lock->waiters() == 0);
 		}
 		if (((numMsg > 0 || popVersion > lastPopVersion) && self->pulling) || self->pullFinished()) {
 			TraceEvent("BackupWorkerSave", self->myId)
@@ -916,24 +1062,51 @@ ACTOR Future<Void> uploadData(BackupData* self) {
 			    .detail("Pulling", self->pulling)
 			    .detail("SavedVersion", self->savedVersion)
 			    .detail("NumMsg", numMsg)
-			    .detail("MsgQ", self->messages.size());
+			    .detail("MsgQ", self->messages.size())
+			    .detail("UploadsInFlight", uploads.size());
+			// Files are opened in version order when the upload starts, which needs all backups to be ready.
+			while (!self->isAllInfoReady()) {
+				wait(self->waitAllInfoReady());
+			}
+			std::vector<VersionedMessage> messages(self->messages.begin() + uploadingMsgs,
+			                                       self->messages.begin() + uploadingMsgs + numMsg);
+			const Version beginVersion = uploads.empty() ? invalidVersion : uploads.back().version + 1;
 			// save an empty file for old epochs so that log file versions are continuous
-			wait(saveMutationsToFile(self, popVersion, numMsg, cipherDetails));
-			self->eraseMessages(numMsg);
+			uploads.push_back(
+			    PendingUpload{ saveMutationsToFile(self, beginVersion, popVersion, std::move(messages), cipherDetails),
+			                   popVersion,
+			                   numMsg });
+			uploadingMsgs += numMsg;
+		}
+
+		// Wait for the oldest upload if too many are in flight, or for all of them if no more uploads follow.
+		state bool drain = !self->pulling || self->pullFinished() || self->stopped || self->exitEarly;
+		while (!uploads.empty() && (drain || uploads.front().done.isReady() ||
+		                            uploads.size() >= SERVER_KNOBS->BACKUP_MAX_CONCURRENT_UPLOADS)) {
+			self->uploadsInFlight = uploads.size();
+			wait(uploads.front().done);
+			self->eraseMessages(uploads.front().numMsg);
+			uploadingMsgs -= uploads.front().numMsg;
+			progressVersion = uploads.front().version;
+			uploads.pop_front();
+		}
+		self->uploadsInFlight = uploads.size();
+		if (uploads.empty()) {
+			progressVersion = std::max(progressVersion, popVersion);
 		}
 
 		// If transition into NOOP mode, should clear messages
-		if (!self->pulling && self->backupEpoch == self->recruitedEpoch) {
+		if (!self->pulling && self->backupEpoch == self->recruitedEpoch && uploads.empty()) {
 			self->eraseMessages(self->messages.size());
 		}
 
-		if (popVersion > self->savedVersion && popVersion > self->popVersion) {
-			wait(saveProgress(self, popVersion));
+		if (progressVersion > self->savedVersion && progressVersion > self->popVersion) {
+			wait(saveProgress(self, progressVersion));
 			TraceEvent("BackupWorkerSavedProgress", self->myId)
 			    .detail("Tag", self->tag.toString())
-			    .detail("Version", popVersion)
+			    .detail("Version", progressVersion)
 			    .detail("MsgQ", self->messages.size());
-			self->savedVersion = std::max(popVersion, self->savedVersion);
+			self->savedVersion = std::max(progressVersion, self->savedVersion);
 			self->pop();
 		}
 
@@ -1177,3 +1350,83 @@ ACTOR Future<Void> backupWorker(BackupInterface interf,
 	}
 	return Void();
 }
+
+// Holds the contents of a backup file in memory
+class MemoryBackupFile final : public IBackupFile, ReferenceCounted<MemoryBackupFile> {
+public:
+	MemoryBackupFile() : IBackupFile("MemoryBackupFile") {}
+
+	Future<Void> append(const void* data, int len) override {
+		contents.append((const char*)data, len);
+		return Void();
+	}
+	Future<Void> finish() override { return Void(); }
+	int64_t size() const override { return contents.size(); }
+	void addref() override { ReferenceCounted<MemoryBackupFile>::addref(); }
+	void delref() override { ReferenceCounted<MemoryBackupFile>::delref(); }
+
+	std::string contents;
+};
+
+TEST_CASE("/BackupWorker/CompressedLogFileRoundTrip") {
+	state int blockSize = 4096;
+	state std::vector<CompressionFilter> filters;
+	for (auto filter : CompressionUtils::supportedFilters) {
+		if (filter != CompressionFilter::NONE) {
+			filters.push_back(filter);
+		}
+	}
+
+	// Mutations of repeated bytes compress well, random ones hardly at all
+	state std::vector<std::tuple<Version, uint32_t, std::string>> expected;
+	for (int i = 0; i < 1000; i++) {
+		const int size = deterministicRandom()->randomInt(1, 500);
+		std::string mutation(size, 'a' + i % 26);
+		if (deterministicRandom()->random01() < 0.3) {
+			for (char& c : mutation) {
+				c = deterministicRandom()->randomInt(0, 256);
+			}
+		}
+		expected.emplace_back(100 + i / 4, i % 4, std::move(mutation));
+	}
+
+	state int f = 0;
+	for (; f < filters.size(); f++) {
+		state Reference<MemoryBackupFile> file = makeReference<MemoryBackupFile>();
+		state Reference<CompressedLogFileWriter> writer =
+		    makeReference<CompressedLogFileWriter>(file, blockSize, filters[f]);
+		state int i = 0;
+		for (; i < expected.size(); i++) {
+			const auto& [version, sub, mutation] = expected[i];
+			VersionedMessage message(LogMessageVersion(version, sub), StringRef(), VectorRef<Tag>(), Arena(), 0);
+			wait(writer->add(message, StringRef(mutation)));
+		}
+		wait(writer->finish());
+
+		// Decode each block the way restore does and compare the mutations
+		int compressedBlocks = 0;
+		int next = 0;
+		for (int offset = 0; offset < file->contents.size(); offset += blockSize) {
+			const int length = std::min<int>(blockSize, file->contents.size() - offset);
+			Standalone<StringRef> block(StringRef((const uint8_t*)file->contents.data() + offset, length));
+			if (*(const uint32_t*)block.begin() == PARTITIONED_MLOG_COMPRESSED_VERSION) {
+				compressedBlocks++;
+			} else {
+				ASSERT(*(const uint32_t*)block.begin() == PARTITIONED_MLOG_VERSION);
+			}
+			Standalone<StringRef> decoded = fileBackup::decodePartitionedLogBlock(block);
+			StringRefReader reader(decoded, restore_corrupted_data());
+			while (!reader.eof() && *reader.rptr != 0xFF) {
+				ASSERT(next < expected.size());
+				const auto& [version, sub, mutation] = expected[next++];
+				ASSERT_EQ((Version)reader.consumeNetworkUInt64(), version);
+				ASSERT_EQ(reader.consumeNetworkUInt32(), sub);
+				const uint32_t size = reader.consumeNetworkUInt32();
+				ASSERT(StringRef(reader.consume(size), size) == StringRef(mutation));
+			}
+		}
+		ASSERT_EQ(next, (int)expected.size());
+		ASSERT(compressedBlocks > 0);
+	}
+	return Void();
+}
@@ -1046,7 +1046,8 @@ ACTOR Future<BlobFileIndex> writeSnapshot(Reference<BlobWorkerData> bwData,
 	                                                  snapshot,
 	                                                  SERVER_KNOBS->BG_SNAPSHOT_FILE_TARGET_CHUNK_BYTES,
 	                                                  compressFilter,
-	                                                  cipherKeysCtx);
+	                                                  cipherKeysCtx,
+	                                                  SERVER_KNOBS->BG_SNAPSHOT_COLUMNAR_FORMAT);
 	state size_t serializedSize = serialized.size();
 	bwData->stats.compressionBytesRaw += snapshot.expectedSize();
 	bwData->stats.compressionBytesFinal += serializedSize;
@@ -173,7 +173,8 @@ public:
 	  : basename(basename), fileExtension(fileExtension), dbgid(dbgid), dbg_file0BeginSeq(0),
 	    fileSizeWarningLimit(fileSizeWarningLimit), onError(delayed(error.getFuture())), onStopped(stopped.getFuture()),
 	    readyToPush(Void()), lastCommit(Void()), isFirstCommit(true), readingBuffer(dbgid), readingFile(-1),
-	    readingPage(-1), writingPos(-1), fileExtensionBytes(SERVER_KNOBS->DISK_QUEUE_FILE_EXTENSION_BYTES),
+	    readingPage(-1), readAheadBuffer(dbgid), readAheadFile(-1), readAheadPage(-1), writingPos(-1),
+	    fileExtensionBytes(SERVER_KNOBS->DISK_QUEUE_FILE_EXTENSION_BYTES),
 	    fileShrinkBytes(SERVER_KNOBS->DISK_QUEUE_FILE_SHRINK_BYTES) {
 		if (BUGGIFY)
 			fileExtensionBytes = _PAGE_SIZE * deterministicRandom()->randomSkewedUInt32(1, 10 << 10);
@@ -288,6 +289,13 @@ public:
 	                 // files[readingFile]. readingFile = 2 if recovery is complete (all files have been read).
 	int64_t readingPage; // Page within readingFile that is the next page after readingBuffer
 
+	// While recovery consumes readingBuffer, the chunk after it is already being read into readAheadBuffer, starting at
+	// page readAheadPage of files[readAheadFile]. readAhead is invalid when no such read is outstanding.
+	StringBuffer readAheadBuffer;
+	int readAheadFile;
+	int64_t readAheadPage;
+	Future<int> readAhead;
+
 	int64_t writingPos; // Position within files[1] that will be next written
 
 	int64_t fileExtensionBytes;
@@ -760,31 +768,67 @@ public:
 		return result;
 	}
 
-	Future<int> fillReadingBuffer() {
+	// Starts reading the chunk that follows readingBuffer into readAheadBuffer. A read of zero bytes is started at the
+	// end of the files; readAheadFile is 2 if both files have been read.
+	void startReadAhead() {
+		readAheadFile = readingFile;
+		readAheadPage = readingPage;
+		readAheadBuffer.clear();
+
 		// If we're right at the end of a file...
-		if (readingPage * sizeof(Page) >= (size_t)files[readingFile].size) {
-			readingFile++;
-			readingPage = 0;
-			if (readingFile >= 2) {
-				// Recovery complete
-				readingBuffer.clear();
-				writingPos = files[1].size;
-				return 0;
+		if (readAheadPage * sizeof(Page) >= (size_t)files[readAheadFile].size) {
+			readAheadFile++;
+			readAheadPage = 0;
+			if (readAheadFile >= 2) {
+				readAhead = 0;
+				return;
 			}
 		}
 
-		// Read up to 1MB into readingBuffer
-		int len = std::min<int64_t>((files[readingFile].size / sizeof(Page) - readingPage) * sizeof(Page),
+		// Read up to 1MB into readAheadBuffer
+		int len = std::min<int64_t>((files[readAheadFile].size / sizeof(Page) - readAheadPage) * sizeof(Page),
 		                            BUGGIFY_WITH_PROB(1.0) ? sizeof(Page) * deterministicRandom()->randomInt(1, 4)
 		                                                   : (1 << 20));
-		readingBuffer.clear();
-		readingBuffer.alignReserve(sizeof(Page), len);
-		void* p = readingBuffer.append(len);
-
-		auto pos = readingPage * sizeof(Page);
-		readingPage += len / sizeof(Page);
+		readAheadBuffer.alignReserve(sizeof(Page), len);
+		void* p = readAheadBuffer.append(len);
 		ASSERT(int64_t(p) % sizeof(Page) == 0);
-		return files[readingFile].f->read(p, len, pos);
+		readAhead =
+		    readChunk(this, files[readAheadFile].f, readAheadBuffer.get(), p, len, readAheadPage * sizeof(Page));
+	}
+
+	// The read keeps the queue and the buffer it reads into alive, since nobody may be waiting for it when the queue is
+	// closed.
+	ACTOR static UNCANCELLABLE Future<int> readChunk(RawDiskQueue_TwoFiles* self,
+	                                                 Reference<IAsyncFile> f,
+	                                                 Standalone<StringRef> buffer,
+	                                                 void* p,
+	                                                 int len,
+	                                                 int64_t pos) {
+		state TrackMe trackMe(self);
+		int read = wait(f->read(p, len, pos));
+		return read;
+	}
+
+	// Moves the chunk read ahead into readingBuffer, and starts reading the chunk after it.
+	ACTOR static Future<Void> fillReadingBuffer(RawDiskQueue_TwoFiles* self) {
+		if (!self->readAhead.isValid()) {
+			self->startReadAhead();
+		}
+		int read = wait(self->readAhead);
+		ASSERT(read == self->readAheadBuffer.size());
+		self->readAhead = Future<int>();
+
+		std::swap(self->readingBuffer, self->readAheadBuffer);
+		self->readAheadBuffer.clear();
+		self->readingFile = self->readAheadFile;
+		self->readingPage = self->readAheadPage + read / sizeof(Page);
+		if (self->readingFile >= 2) {
+			// Recovery complete
+			self->writingPos = self->files[1].size;
+		} else if (read && SERVER_KNOBS->DISK_QUEUE_RECOVERY_READ_AHEAD) {
+			self->startReadAhead();
+		}
+		return Void();
 	}
 
 	ACTOR static UNCANCELLABLE Future<Standalone<StringRef>> readNextPage(RawDiskQueue_TwoFiles* self) {
@@ -798,8 +842,7 @@ public:
 				state Future<Void> f = Void();
 				// if (BUGGIFY) f = delay( deterministicRandom()->random01() * 0.1 );
 
-				int read = wait(self->fillReadingBuffer());
-				ASSERT(read == self->readingBuffer.size());
+				wait(fillReadingBuffer(self));
 
 				wait(f);
 			}
@@ -852,6 +895,13 @@ public:
 			self->readingBuffer.clear();
 			self->writingPos = pos;
 
+			// Pages read ahead are past the end of the queue and are about to be zeroed
+			if (self->readAhead.isValid()) {
+				wait(success(errorOr(self->readAhead)));
+				self->readAhead = Future<int>();
+				self->readAheadBuffer.clear();
+			}
+
 			while (file < 2) {
 				commits.push_back(self->truncateFile(self, file, pos));
 				file++;
@@ -22,6 +22,7 @@
 #include "fdbrpc/Stats.h"
 #include "fdbserver/Knobs.h"
 #include "fdbserver/LogSystem.h"
+#include "fdbserver/PeekReplyCompressionCache.h"
 #include "fdbserver/WorkerInterface.actor.h"
 #include "fdbserver/RecoveryState.h"
 #include "fdbserver/TLogInterface.h"
@@ -108,6 +109,7 @@ struct LogRouterData {
 	};
 
 	std::map<UID, PeekTrackerData> peekTracker;
+	PeekReplyCompressionCache peekCompressionCache;
 
 	CounterCollection cc;
 	Counter getMoreCount; // Increase by 1 when LR tries to pull data from satellite tLog.
@@ -444,7 +446,8 @@ Future<Void> logRouterPeekMessages(PromiseType replyPromise,
                                    Tag reqTag,
                                    bool reqReturnIfBlocked = false,
                                    bool reqOnlySpilled = false,
-                                   Optional<std::pair<UID, int>> reqSequence = Optional<std::pair<UID, int>>()) {
+                                   Optional<std::pair<UID, int>> reqSequence = Optional<std::pair<UID, int>>(),
+                                   Optional<CompressionFilter> reqCompression = Optional<CompressionFilter>()) {
 	state BinaryWriter messages(Unversioned());
 	state int sequence = -1;
 	state UID peekId;
@@ -615,6 +618,10 @@ Future<Void> logRouterPeekMessages(PromiseType replyPromise,
 		reply.begin = reqBegin;
 	}
 
+	if (reqCompression.present()) {
+		self->peekCompressionCache.compress(reply, reqTag, reqBegin, reqCompression.get());
+	}
+
 	replyPromise.send(reply);
 	DebugLogTraceEvent("LogRouterPeek4", self->dbgid)
 	    .detail("Tag", reqTag.toString())
@@ -638,7 +645,14 @@ ACTOR Future<Void> logRouterPeekStream(LogRouterData* self, TLogPeekStreamReques
 		state Future<TLogPeekReply> future(promise.getFuture());
 		try {
 			wait(req.reply.onReady() && store(reply.rep, future) &&
-			     logRouterPeekMessages(promise, self, begin, req.tag, req.returnIfBlocked, onlySpilled));
+			     logRouterPeekMessages(promise,
+			                           self,
+			                           begin,
+			                           req.tag,
+			                           req.returnIfBlocked,
+			                           onlySpilled,
+			                           Optional<std::pair<UID, int>>(),
+			                           req.compressionFilter));
 
 			reply.rep.begin = begin;
 			req.reply.send(reply);
@@ -744,8 +758,14 @@ ACTOR Future<Void> logRouterCore(TLogInterface interf,
 			logRouterData.logSystem->set(ILogSystem::fromServerDBInfo(logRouterData.dbgid, db->get(), true));
 		}
 		when(TLogPeekRequest req = waitNext(interf.peekMessages.getFuture())) {
-			addActor.send(logRouterPeekMessages(
-			    req.reply, &logRouterData, req.begin, req.tag, req.returnIfBlocked, req.onlySpilled, req.sequence));
+			addActor.send(logRouterPeekMessages(req.reply,
+			                                    &logRouterData,
+			                                    req.begin,
+			                                    req.tag,
+			                                    req.returnIfBlocked,
+			                                    req.onlySpilled,
+			                                    req.sequence,
+			                                    req.compressionFilter));
 		}
 		when(TLogPeekStreamRequest req = waitNext(interf.peekStreamMessages.getFuture())) {
 			TraceEvent(SevDebug, "LogRouterPeekStream", logRouterData.dbgid)
@@ -20,6 +20,7 @@
 
 #include "fdbserver/LogSystem.h"
 #include "fdbclient/FDBTypes.h"
+#include "fdbserver/Knobs.h"
 #include "fdbserver/OTELSpanContextMessage.h"
 #include "fdbserver/SpanContextMessage.h"
 #include "flow/serialize.h"
@@ -272,13 +273,17 @@ void LogSet::getPushLocations(VectorRef<Tag> tags, std::vector<int>& locations,
 	//	.detail("Included", alsoServers.size()).detail("Duration", timer() - t);
 }
 
-LogPushData::LogPushData(Reference<ILogSystem> logSystem, int tlogCount) : logSystem(logSystem), subsequence(1) {
+LogPushData::LogPushData(Reference<ILogSystem> logSystem, int tlogCount)
+  : logSystem(logSystem), indexTags(SERVER_KNOBS->PUSH_TAG_MESSAGE_INDEX), subsequence(1) {
 	ASSERT(tlogCount > 0);
 	messagesWriter.reserve(tlogCount);
 	for (int i = 0; i < tlogCount; i++) {
 		messagesWriter.emplace_back(AssumeVersion(g_network->protocolVersion()));
 	}
 	messagesWritten = std::vector<bool>(tlogCount, false);
+	if (indexTags) {
+		tagMessageOffsets.resize(tlogCount);
+	}
 }
 
 void LogPushData::addTxsTag() {
@@ -314,6 +319,7 @@ void LogPushData::writeMessage(StringRef rawMessageWithoutLength, bool usePrevio
 	    rawMessageWithoutLength.size() + sizeof(subseq) + sizeof(uint16_t) + sizeof(Tag) * prev_tags.size();
 	for (int loc : msg_locations) {
 		BinaryWriter& wr = messagesWriter[loc];
+		recordTags(loc, wr.getLength());
 		wr << msgsize << subseq << uint16_t(prev_tags.size());
 		for (auto& tag : prev_tags)
 			wr << tag;
@@ -321,6 +327,30 @@ void LogPushData::writeMessage(StringRef rawMessageWithoutLength, bool usePrevio
 	}
 }
 
+VectorRef<TagMessagesRef> LogPushData::getTagMessages(int loc, Arena& arena) const {
+	VectorRef<TagMessagesRef> result;
+	if (!indexTags) {
+		return result;
+	}
+
+	// Sorting by tag and then offset keeps the messages of each tag in the order they were written
+	std::vector<std::pair<Tag, int>> offsets = tagMessageOffsets[loc];
+	std::sort(offsets.begin(), offsets.end());
+	for (int i = 0; i < offsets.size();) {
+		int end = i;
+		while (end < offsets.size() && offsets[end].first == offsets[i].first) {
+			end++;
+		}
+		TagMessagesRef& tagMessages = result.emplace_back(arena);
+		tagMessages.tag = offsets[i].first;
+		tagMessages.messageOffsets.reserve(arena, end - i);
+		for (; i < end; i++) {
+			tagMessages.messageOffsets.push_back(arena, offsets[i].second);
+		}
+	}
+	return result;
+}
+
 std::vector<Standalone<StringRef>> LogPushData::getAllMessages() const {
 	std::vector<Standalone<StringRef>> results;
 	results.reserve(messagesWriter.size());
@@ -357,6 +387,7 @@ bool LogPushData::writeTransactionInfo(int location, uint32_t subseq) {
 
 	BinaryWriter& wr = messagesWriter[location];
 	int offset = wr.getLength();
+	recordTags(location, offset);
 	wr << uint32_t(0) << subseq << uint16_t(prev_tags.size());
 	for (auto& tag : prev_tags)
 		wr << tag;
@@ -398,6 +429,19 @@ void LogPushData::setMutations(uint32_t totalMutations, VectorRef<StringRef> mut
 	const int header = v.size();
 	for (int i = 0; i < mutations.size(); i++) {
 		BinaryWriter& wr = messagesWriter[i];
-		wr.serializeBytes(mutations[i].substr(header));
+		StringRef messages = mutations[i].substr(header);
+		if (indexTags) {
+			// The messages were written by another LogPushData, so their tags have to be read back
+			BinaryReader rd(messages, AssumeVersion(g_network->protocolVersion()));
+			while (!rd.empty()) {
+				TagsAndMessage tagsAndMessage;
+				tagsAndMessage.loadFromArena(&rd, nullptr);
+				int offset = wr.getLength() + (tagsAndMessage.message.begin() - messages.begin());
+				for (auto& tag : tagsAndMessage.tags) {
+					tagMessageOffsets[i].emplace_back(tag, offset);
+				}
+			}
+		}
+		wr.serializeBytes(messages);
 	}
 }
@@ -24,8 +24,18 @@
 #include "fdbserver/MutationTracking.h"
 #include "fdbrpc/ReplicationUtils.h"
 #include "flow/DebugTrace.h"
+#include "flow/UnitTest.h"
 #include "flow/actorcompiler.h" // has to be last include
 
+// The compression peek cursors ask TLogs and log routers to apply to their replies, if any
+static Optional<CompressionFilter> peekCompressionFilter() {
+	CompressionFilter filter = CompressionUtils::fromFilterString(SERVER_KNOBS->PEEK_COMPRESSION_FILTER);
+	if (filter == CompressionFilter::NONE || !CompressionUtils::supportedFilters.count(filter)) {
+		return Optional<CompressionFilter>();
+	}
+	return filter;
+}
+
 // create a peek stream for cursor when it's possible
 ACTOR Future<Void> tryEstablishPeekStream(ILogSystem::ServerPeekCursor* self) {
 	if (self->peekReplyStream.present())
@@ -37,8 +47,11 @@ ACTOR Future<Void> tryEstablishPeekStream(ILogSystem::ServerPeekCursor* self) {
 	wait(IFailureMonitor::failureMonitor().onStateEqual(self->interf->get().interf().peekStreamMessages.getEndpoint(),
 	                                                    FailureStatus(false)));
 
-	auto req = TLogPeekStreamRequest(
-	    self->messageVersion.version, self->tag, self->returnIfBlocked, std::numeric_limits<int>::max());
+	auto req = TLogPeekStreamRequest(self->messageVersion.version,
+	                                 self->tag,
+	                                 self->returnIfBlocked,
+	                                 std::numeric_limits<int>::max(),
+	                                 peekCompressionFilter());
 	self->peekReplyStream = self->interf->get().interf().peekStreamMessages.getReplyStream(req);
 	DebugLogTraceEvent(SevDebug, "SPC_StreamCreated", self->randomID)
 	    .detail("Tag", self->tag)
@@ -57,7 +70,8 @@ ILogSystem::ServerPeekCursor::ServerPeekCursor(Reference<AsyncVar<OptionalInterf
     poppedVersion(0), hasMsg(false), randomID(deterministicRandom()->randomUniqueID()),
     returnIfBlocked(returnIfBlocked), onlySpilled(false), parallelGetMore(parallelGetMore),
     usePeekStream(SERVER_KNOBS->PEEK_USING_STREAMING), sequence(0), lastReset(0), resetCheck(Void()), slowReplies(0),
-    fastReplies(0), unknownReplies(0) {
+    fastReplies(0), unknownReplies(0), messageIndexValid(false), messageIndexSorted(true),
+    messageIndexReachedEnd(false) {
 	this->results.maxKnownVersion = 0;
 	this->results.minKnownCommittedVersion = 0;
 	DebugLogTraceEvent(SevDebug, "SPC_Starting", randomID)
@@ -80,7 +94,8 @@ ILogSystem::ServerPeekCursor::ServerPeekCursor(TLogPeekReply const& results,
     end(end), poppedVersion(poppedVersion), messageAndTags(message), hasMsg(hasMsg),
     randomID(deterministicRandom()->randomUniqueID()), returnIfBlocked(false), onlySpilled(false),
     parallelGetMore(false), usePeekStream(false), sequence(0), lastReset(0), resetCheck(Void()), slowReplies(0),
-    fastReplies(0), unknownReplies(0) {
+    fastReplies(0), unknownReplies(0), messageIndexValid(false), messageIndexSorted(true),
+    messageIndexReachedEnd(false) {
 	//TraceEvent("SPC_Clone", randomID);
 	this->results.maxKnownVersion = 0;
 	this->results.minKnownCommittedVersion = 0;
@@ -169,8 +184,80 @@ VectorRef<Tag> ILogSystem::ServerPeekCursor::getTags() const {
 	return messageAndTags.tags;
 }
 
+void ILogSystem::ServerPeekCursor::buildMessageIndex() {
+	messageIndex.clear();
+	messageIndexSorted = true;
+	messageIndexReachedEnd = false;
+	const uint8_t* begin = results.messages.begin();
+	const uint8_t* p = begin;
+	Version ver = 0;
+	while (p < results.messages.end()) {
+		int32_t header;
+		memcpy(&header, p, sizeof(header));
+		if (header == VERSION_HEADER) {
+			memcpy(&ver, p + sizeof(header), sizeof(ver));
+			p += sizeof(header) + sizeof(ver);
+			if (LogMessageVersion(ver) >= end) {
+				messageIndexReachedEnd = true;
+				break;
+			}
+			continue;
+		}
+		uint32_t sub;
+		memcpy(&sub, p + sizeof(header), sizeof(sub));
+		if (!messageIndex.empty() && LogMessageVersion(ver, sub) < messageIndex.back().first) {
+			messageIndexSorted = false;
+		}
+		messageIndex.emplace_back(LogMessageVersion(ver, sub), p - begin);
+		p += sizeof(header) + uint32_t(header);
+	}
+	messageIndexValid = true;
+}
+
+bool ILogSystem::ServerPeekCursor::seekMessage(LogMessageVersion n) {
+	if (!messageIndexValid) {
+		buildMessageIndex();
+	}
+	auto byVersion = [](std::pair<LogMessageVersion, int> const& entry, LogMessageVersion const& version) {
+		return entry.first < version;
+	};
+	if (!messageIndexSorted) {
+		return false;
+	}
+
+	auto it = std::lower_bound(messageIndex.begin(), messageIndex.end(), n, byVersion);
+	const uint8_t* current = (const uint8_t*)rd.peekBytes(0);
+	if (it == messageIndex.end()) {
+		rd.readBytes(rd.remainingBytes());
+		if (messageIndexReachedEnd) {
+			messageVersion = end;
+		} else {
+			messageVersion.reset(std::min(results.end, end.version));
+		}
+		hasMsg = false;
+		return true;
+	}
+
+	ASSERT(results.messages.begin() + it->second >= current);
+	rd.readBytes(results.messages.begin() + it->second - current);
+	messageVersion.reset(it->first.version);
+	messageAndTags.loadFromArena(&rd, &messageVersion.sub);
+	// Rewind and consume the header so that reader() starts from the message.
+	rd.rewind();
+	rd.readBytes(messageAndTags.getHeaderSize());
+	hasMsg = true;
+	return true;
+}
+
 void ILogSystem::ServerPeekCursor::advanceTo(LogMessageVersion n) {
 	//TraceEvent("SPC_AdvanceTo", randomID).detail("N", n.toString());
+	if (messageVersion < n && hasMessage()) {
+		getMessage();
+		nextMessage();
+	}
+	if (messageVersion < n && hasMessage()) {
+		seekMessage(n);
+	}
 	while (messageVersion < n && hasMessage()) {
 		getMessage();
 		nextMessage();
@@ -190,10 +277,12 @@ void ILogSystem::ServerPeekCursor::advanceTo(LogMessageVersion n) {
 // in getMore helper functions.
 void updateCursorWithReply(ILogSystem::ServerPeekCursor* self, const TLogPeekReply& res) {
 	self->results = res;
+	self->results.decompress();
 	self->onlySpilled = res.onlySpilled;
 	if (res.popped.present())
 		self->poppedVersion = std::min(std::max(self->poppedVersion, res.popped.get()), self->end.version);
 	self->rd = ArenaReader(self->results.arena, self->results.messages, Unversioned());
+	self->messageIndexValid = false;
 	LogMessageVersion skipSeq = self->messageVersion;
 	self->hasMsg = true;
 	self->nextMessage();
@@ -231,6 +320,8 @@ ACTOR Future<TLogPeekReply> recordRequestMetrics(ILogSystem::ServerPeekCursor* s
 	try {
 		state double startTime = now();
 		TLogPeekReply t = wait(in);
+		// A compressed reply is classified by the size of the messages it carries
+		t.decompress();
 		if (now() - self->lastReset > SERVER_KNOBS->PEEK_RESET_INTERVAL) {
 			if (now() - startTime > SERVER_KNOBS->PEEK_MAX_LATENCY) {
 				if (t.messages.size() >= SERVER_KNOBS->DESIRED_TOTAL_BYTES || SERVER_KNOBS->PEEK_COUNT_SMALL_MESSAGES) {
@@ -287,7 +378,8 @@ ACTOR Future<Void> serverPeekParallelGetMore(ILogSystem::ServerPeekCursor* self,
 					                        self->tag,
 					                        self->returnIfBlocked,
 					                        self->onlySpilled,
-					                        std::make_pair(self->randomID, self->sequence++)),
+					                        std::make_pair(self->randomID, self->sequence++),
+					                        peekCompressionFilter()),
 					        taskID)));
 				}
 				if (self->sequence == std::numeric_limits<decltype(self->sequence)>::max()) {
@@ -441,7 +533,9 @@ ACTOR Future<Void> serverPeekGetMore(ILogSystem::ServerPeekCursor* self, TaskPri
 				                        TLogPeekRequest(self->messageVersion.version,
 				                                        self->tag,
 				                                        self->returnIfBlocked,
-				                                        self->onlySpilled),
+				                                        self->onlySpilled,
+				                                        Optional<std::pair<UID, int>>(),
+				                                        peekCompressionFilter()),
 				                        taskID))
 				                  : Never())) {
 					updateCursorWithReply(self, res);
@@ -637,9 +731,8 @@ void ILogSystem::MergedPeekCursor::calcHasMessage() {
 			currentCursor = bestServer;
 			hasNextMessage = true;
 
-			for (auto& c : serverCursors)
-				c->advanceTo(messageVersion);
-
+			// The other cursors are only looked at once the best server runs out of messages, and are all advanced to
+			// its version below before that. Advancing them here too would parse every message once per cursor.
 			return;
 		}
 
@@ -920,12 +1013,7 @@ void ILogSystem::SetPeekCursor::calcHasMessage() {
 
 			//TraceEvent("LPC_Calc1").detail("Ver", messageVersion.toString()).detail("Tag", tag.toString()).detail("HasNextMessage", hasNextMessage);
 
-			for (auto& cursors : serverCursors) {
-				for (auto& c : cursors) {
-					c->advanceTo(messageVersion);
-				}
-			}
-
+			// As in MergedPeekCursor, the other cursors catch up to the best server once it runs out of messages
 			return;
 		}
 
@@ -1579,3 +1667,68 @@ Version ILogSystem::BufferedCursor::popped() const {
 	}
 	return poppedVersion;
 }
+
+// A peek reply of versions 1 to versionCount with one to three messages each. If sorted is false, the messages of each
+// version are in descending sub order, which the message index cannot binary search.
+static TLogPeekReply makeTestPeekReply(int versionCount, bool sorted) {
+	BinaryWriter wr(Unversioned());
+	for (Version v = 1; v <= versionCount; v++) {
+		wr << VERSION_HEADER << v;
+		int messages = deterministicRandom()->randomInt(1, 4);
+		for (int i = 0; i < messages; i++) {
+			uint32_t sub = sorted ? i + 1 : messages - i;
+			int offset = wr.getLength();
+			wr << uint32_t(0) << sub << uint16_t(1) << Tag(0, deterministicRandom()->randomInt(0, 10));
+			wr.serializeBytes(deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 20)));
+			*(uint32_t*)((uint8_t*)wr.getData() + offset) = wr.getLength() - offset - sizeof(uint32_t);
+		}
+	}
+	TLogPeekReply reply;
+	reply.messages = StringRef(reply.arena, wr.toValue());
+	reply.end = versionCount + 1;
+	return reply;
+}
+
+TEST_CASE("/fdbserver/LogSystemPeekCursor/SeekMessage") {
+	const Tag tag(0, 0);
+	for (int trial = 0; trial < 100; trial++) {
+		const int versionCount = deterministicRandom()->randomInt(1, 50);
+		TLogPeekReply reply = makeTestPeekReply(versionCount, deterministicRandom()->random01() < 0.8);
+		LogMessageVersion end(deterministicRandom()->randomInt(1, versionCount + 3));
+		auto indexed = makeReference<ILogSystem::ServerPeekCursor>(
+		    reply, LogMessageVersion(), end, TagsAndMessage(), true, 0, tag);
+		auto linear = makeReference<ILogSystem::ServerPeekCursor>(
+		    reply, LogMessageVersion(), end, TagsAndMessage(), true, 0, tag);
+
+		// Both cursors must stop at the same message of the same reply, whether by consuming messages or advancing
+		LogMessageVersion target;
+		while (indexed->hasMessage() || linear->hasMessage()) {
+			if (deterministicRandom()->coinflip()) {
+				ASSERT(indexed->getMessage() == linear->getMessage());
+				indexed->nextMessage();
+				linear->nextMessage();
+			} else {
+				target = LogMessageVersion(deterministicRandom()->randomInt(target.version, versionCount + 3),
+				                           deterministicRandom()->randomInt(0, 5));
+				indexed->advanceTo(target);
+				// The linear advance advanceTo() did before the message index
+				while (linear->messageVersion < target && linear->hasMessage()) {
+					linear->getMessage();
+					linear->nextMessage();
+				}
+				if (!linear->hasMessage() && linear->messageVersion < target) {
+					linear->messageVersion = target;
+				}
+			}
+
+			ASSERT(indexed->hasMessage() == linear->hasMessage());
+			ASSERT(indexed->version() == linear->version());
+			if (linear->hasMessage()) {
+				ASSERT(indexed->messageAndTags.getRawMessage().begin() ==
+				       linear->messageAndTags.getRawMessage().begin());
+				ASSERT(indexed->reader()->peekBytes(0) == linear->reader()->peekBytes(0));
+			}
+		}
+	}
+	return Void();
+}
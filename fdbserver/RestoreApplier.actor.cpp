@@ -34,6 +34,7 @@
 #include "fdbserver/RestoreApplier.actor.h"
 
 #include "flow/network.h"
+#include "flow/UnitTest.h"
 
 #include "flow/actorcompiler.h" // This must be the last #include.
 
@@ -364,10 +365,83 @@ ACTOR static Future<Void> getAndComputeStagingKeys(
 	return Void();
 }
 
+// Merges sorted runs into one sequence of their mutations, ordered by key and version. Each run is released once all of
+// its mutations have been consumed.
+class SortedRunMerger {
+	std::vector<Standalone<VectorRef<RunMutation>>> runs;
+	// Position (run index, mutation index) of the next mutation of each run that has any left, smallest first
+	std::vector<std::pair<int, int>> heap;
+
+	auto greater() const {
+		return [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+			return runs[b.first][b.second] < runs[a.first][a.second];
+		};
+	}
+
+public:
+	SortedRunMerger() = default;
+	explicit SortedRunMerger(std::vector<Standalone<VectorRef<RunMutation>>> sortedRuns)
+	  : runs(std::move(sortedRuns)) {
+		for (int i = 0; i < runs.size(); i++) {
+			if (!runs[i].empty()) {
+				heap.emplace_back(i, 0);
+			}
+		}
+		std::make_heap(heap.begin(), heap.end(), greater());
+	}
+
+	int runCount() const { return runs.size(); }
+	bool empty() const { return heap.empty(); }
+
+	// Returns the smallest mutation not consumed yet. pre: !empty()
+	const RunMutation& top() const { return runs[heap.front().first][heap.front().second]; }
+
+	// Consumes the smallest mutation. pre: !empty()
+	void pop() {
+		std::pop_heap(heap.begin(), heap.end(), greater());
+		std::pair<int, int>& pos = heap.back();
+		if (++pos.second < runs[pos.first].size()) {
+			std::push_heap(heap.begin(), heap.end(), greater());
+		} else {
+			runs[pos.first] = Standalone<VectorRef<RunMutation>>(); // Release the run's memory
+			heap.pop_back();
+		}
+	}
+};
+
+// Adds the next point mutations of merger to the empty stagingKeys, until at least maxMutations were added and the
+// next mutation is of another key. Keys come out of the merge in order, so each new key is inserted at the end of
+// stagingKeys instead of being searched for.
+ACTOR static Future<Void> mergeSortedRuns(Reference<ApplierBatchData> batchData,
+                                          SortedRunMerger* merger,
+                                          int maxMutations) {
+	state std::map<Key, StagingKey>::iterator stagingKey = batchData->stagingKeys.end();
+	state int mutations = 0;
+	ASSERT(batchData->stagingKeys.empty());
+
+	while (!merger->empty()) {
+		const RunMutation& m = merger->top();
+		if (stagingKey == batchData->stagingKeys.end() || stagingKey->first != m.mutation.param1) {
+			if (mutations >= maxMutations) {
+				break;
+			}
+			stagingKey = batchData->stagingKeys.emplace_hint(
+			    batchData->stagingKeys.end(), m.mutation.param1, StagingKey(m.mutation.param1));
+		}
+		stagingKey->second.add(m.mutation, m.version);
+		merger->pop();
+		mutations++;
+		wait(yield(TaskPriority::RestoreApplierWriteDB));
+	}
+	return Void();
+}
+
+// Clear range mutations are applied to the destination DB only if clearRangesToDB is set
 ACTOR static Future<Void> precomputeMutationsResult(Reference<ApplierBatchData> batchData,
                                                     UID applierID,
                                                     int64_t batchIndex,
-                                                    Database cx) {
+                                                    Database cx,
+                                                    bool clearRangesToDB) {
 	// Apply range mutations (i.e., clearRange) to database cx
 	TraceEvent("FastRestoreApplerPhasePrecomputeMutationsResultStart", applierID)
 	    .detail("BatchIndex", batchIndex)
@@ -376,7 +450,7 @@ ACTOR static Future<Void> precomputeMutationsResult(Reference<ApplierBatchData>
 	state std::vector<Future<Void>> fClearRanges;
 	Standalone<VectorRef<KeyRangeRef>> clearRanges;
 	double curTxnSize = 0;
-	{
+	if (clearRangesToDB) {
 		double delayTime = 0;
 		for (auto& rangeMutation : batchData->stagingKeyRanges) {
 			KeyRangeRef range(rangeMutation.mutation.param1, rangeMutation.mutation.param2);
@@ -610,7 +684,8 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
 	TraceEvent("FastRestoreApplerPhaseApplyStagingKeysStart", applierID)
 	    .detail("BatchIndex", batchIndex)
 	    .detail("StagingKeys", batchData->stagingKeys.size());
-	batchData->totalBytesToWrite = 0;
+	// Bytes to write add up over the chunks of a version batch applied from sorted runs
+	batchData->totalBytesToWrite = std::max(0.0, batchData->totalBytesToWrite);
 	while (cur != batchData->stagingKeys.end()) {
 		txnSize += cur->second.totalSize(); // should be consistent with receivedBytes accounting method
 		if (txnSize > SERVER_KNOBS->FASTRESTORE_TXN_BATCH_MAX_BYTES) {
@@ -654,15 +729,50 @@ ACTOR static Future<Void> applyStagingKeys(Reference<ApplierBatchData> batchData
 	return Void();
 }
 
+// Merges the sorted runs into stagingKeys FASTRESTORE_APPLIER_MERGE_MUTATIONS mutations at a time, and precomputes and
+// applies each chunk of keys before merging the next, so that stagingKeys never holds the whole version batch.
+ACTOR static Future<Void> applySortedRuns(Reference<ApplierBatchData> batchData,
+                                          UID applierID,
+                                          int64_t batchIndex,
+                                          Database cx) {
+	batchData->sealCurrentRun();
+	state SortedRunMerger merger(std::move(batchData->sortedRuns));
+	state int chunks = 0;
+	batchData->sortedRuns.clear();
+	TraceEvent("FastRestoreApplierApplySortedRunsStart", applierID)
+	    .detail("BatchIndex", batchIndex)
+	    .detail("Runs", merger.runCount());
+
+	// Clear ranges are applied to the DB with the first chunk, which is applied even if there are no point mutations
+	loop {
+		wait(mergeSortedRuns(batchData, &merger, SERVER_KNOBS->FASTRESTORE_APPLIER_MERGE_MUTATIONS));
+		wait(precomputeMutationsResult(batchData, applierID, batchIndex, cx, chunks == 0));
+		wait(applyStagingKeys(batchData, applierID, batchIndex, cx));
+		batchData->stagingKeys.clear();
+		chunks++;
+		if (merger.empty()) {
+			break;
+		}
+	}
+
+	TraceEvent("FastRestoreApplierApplySortedRunsDone", applierID)
+	    .detail("BatchIndex", batchIndex)
+	    .detail("Chunks", chunks);
+	return Void();
+}
+
 // Write mutations to the destination DB
 ACTOR Future<Void> writeMutationsToDB(UID applierID,
                                       int64_t batchIndex,
                                       Reference<ApplierBatchData> batchData,
                                       Database cx) {
 	TraceEvent("FastRestoreApplierPhaseApplyTxnStart", applierID).detail("BatchIndex", batchIndex);
-	wait(precomputeMutationsResult(batchData, applierID, batchIndex, cx));
-
-	wait(applyStagingKeys(batchData, applierID, batchIndex, cx));
+	if (SERVER_KNOBS->FASTRESTORE_APPLIER_SORTED_RUNS) {
+		wait(applySortedRuns(batchData, applierID, batchIndex, cx));
+	} else {
+		wait(precomputeMutationsResult(batchData, applierID, batchIndex, cx, true));
+		wait(applyStagingKeys(batchData, applierID, batchIndex, cx));
+	}
 	TraceEvent("FastRestoreApplierPhaseApplyTxnDone", applierID)
 	    .detail("BatchIndex", batchIndex)
 	    .detail("AppliedBytes", batchData->appliedBytes)
@@ -825,3 +935,60 @@ Value applyAtomicOp(Optional<StringRef> existingValue, Value value, MutationRef:
 	}
 	return Value();
 }
+
+TEST_CASE("/FastRestore/RestoreApplier/SortedRunMerger") {
+	// Sets of a few keys at random versions spread over runs, with some mutations repeated in a second run as
+	// overlapping mutation logs do
+	const int runCount = deterministicRandom()->randomInt(1, 10);
+	std::vector<Standalone<VectorRef<RunMutation>>> runs(runCount);
+	std::vector<std::tuple<Key, LogMessageVersion, Value>> expected;
+	std::map<Key, std::pair<LogMessageVersion, Value>> latest;
+	for (int i = 0; i < 1000; i++) {
+		Key key = StringRef(format("key%02d", deterministicRandom()->randomInt(0, 20)));
+		LogMessageVersion version(deterministicRandom()->randomInt(1, 100000), deterministicRandom()->randomInt(0, 4));
+		if (std::any_of(expected.begin(), expected.end(), [&](const auto& e) {
+			    return std::get<0>(e) == key && std::get<1>(e) == version;
+		    })) {
+			continue;
+		}
+		Value value = StringRef(version.toString());
+		MutationRef m(MutationRef::SetValue, key, value);
+		const int copies = deterministicRandom()->random01() < 0.1 ? 2 : 1;
+		for (int c = 0; c < copies; c++) {
+			auto& run = runs[deterministicRandom()->randomInt(0, runCount)];
+			run.push_back(run.arena(), RunMutation{ MutationRef(run.arena(), m), version });
+			expected.emplace_back(key, version, value);
+		}
+		auto it = latest.find(key);
+		if (it == latest.end() || it->second.first < version) {
+			latest[key] = std::make_pair(version, value);
+		}
+	}
+	for (auto& run : runs) {
+		std::sort(run.begin(), run.end());
+	}
+	std::sort(expected.begin(), expected.end());
+
+	// The merge yields every mutation, ordered by key and version
+	SortedRunMerger merger(std::move(runs));
+	std::map<Key, StagingKey> stagingKeys;
+	int i = 0;
+	for (; !merger.empty(); merger.pop(), i++) {
+		const RunMutation& m = merger.top();
+		ASSERT(i < expected.size());
+		ASSERT(m.mutation.param1 == std::get<0>(expected[i]));
+		ASSERT(m.version == std::get<1>(expected[i]));
+		ASSERT(m.mutation.param2 == std::get<2>(expected[i]));
+		stagingKeys.emplace(m.mutation.param1, StagingKey(m.mutation.param1))
+		    .first->second.add(m.mutation, m.version);
+	}
+	ASSERT_EQ(i, (int)expected.size());
+
+	// Each key ends up with the value set at its latest version
+	ASSERT_EQ(stagingKeys.size(), latest.size());
+	for (auto& [key, stagingKey] : stagingKeys) {
+		ASSERT(stagingKey.version == latest[key].first);
+		ASSERT(stagingKey.val == latest[key].second);
+	}
+	return Void();
+}
@@ -406,11 +406,11 @@ ACTOR static Future<Void> _parsePartitionedLogFileOnLoader(
 	    .detail("Length", asset.len);
 
 	state Arena tempArena;
-	state StringRefReader reader(buf, restore_corrupted_data());
+	state StringRefReader reader;
 	try {
-		// Read block header
-		if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-			throw restore_unsupported_file_version();
+		// Read block header and decompress the block if needed
+		buf = fileBackup::decodePartitionedLogBlock(buf);
+		reader = StringRefReader(buf, restore_corrupted_data());
 
 		state VersionedMutationsMap* kvOps = &kvOpsIter->second;
 		while (1) {
@@ -22,16 +22,21 @@
 #include <memory.h>
 #include <stdio.h>
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
 
 #include "flow/Platform.h"
+#include "flow/ThreadPrimitives.h"
+#include "flow/UnitTest.h"
 #include "fdbrpc/fdbrpc.h"
 #include "fdbrpc/PerfMetric.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/SystemData.h"
+#include "fdbserver/ArtVersionHistory.h"
 #include "fdbserver/ConflictSet.h"
 
 static std::vector<PerfDoubleCounter*> skc;
@@ -60,6 +65,19 @@ static force_inline int compare(const StringRef& a, const StringRef& b) {
 	return +1;
 }
 
+// Whether skip list searches decide from the partial keys kept next to each node's pointers, or compare full keys at
+// every step. Partial keys are maintained either way. Build with -DCONFLICT_SET_PARTIAL_KEY_SEARCH=0 to benchmark the
+// full key search.
+#ifndef CONFLICT_SET_PARTIAL_KEY_SEARCH
+#define CONFLICT_SET_PARTIAL_KEY_SEARCH 1
+#endif
+static constexpr bool partialKeySearch = CONFLICT_SET_PARTIAL_KEY_SEARCH;
+
+// Returns the byte of a key at the given position plus one, or 0 if the key ends there
+static force_inline int keyByte(const uint8_t* key, int length, int position) {
+	return position < length ? key[position] + 1 : 0;
+}
+
 struct ReadConflictRange {
 	StringRef begin, end;
 	Version version;
@@ -236,15 +254,36 @@ private:
 
 	// Represent a node in the SkipList. The node has multiple (i.e., level) pointers to
 	// other nodes, and keeps a record of the max versions for each level.
+	//
+	// Next to each pointer the node also keeps a partial key of the next node: the length of the
+	// prefix the two keys have in common, and the next key's first differing byte (see keyByte()).
+	// A search which knows how much of its key it shares with the current node can usually decide
+	// from the partial key alone whether to advance, without touching the next node's cache line.
 	struct Node {
 		int level() const { return nPointers - 1; }
-		uint8_t* value() { return end() + nPointers * (sizeof(Node*) + sizeof(Version)); }
+		uint8_t* value() { return end() + nPointers * (sizeof(Node*) + sizeof(Version) + sizeof(uint64_t)); }
 		int length() const { return valueLength; }
 
 		// Returns the next node pointer at the given level.
 		Node* getNext(int level) { return *((Node**)end() + level); }
+		// Returns the partial key of the next node at the given level.
+		uint64_t getNextPartialKey(int level) const { return partialKeys()[level]; }
 		// Sets the next node pointer at the given level.
-		void setNext(int level, Node* n) { *((Node**)end() + level) = n; }
+		void setNext(int level, Node* n) { setNext(level, n, n ? partialKeyOf(n) : 0); }
+		// Sets the next node pointer at the given level, when n's partial key relative to this node is known.
+		void setNext(int level, Node* n, uint64_t partialKey) {
+			*((Node**)end() + level) = n;
+			partialKeys()[level] = partialKey;
+		}
+
+		static int partialKeyPrefixLength(uint64_t partialKey) { return partialKey >> 16; }
+		static int partialKeyByte(uint64_t partialKey) { return partialKey & 0xffff; }
+
+		// Returns the partial key of n, which must sort after this node.
+		uint64_t partialKeyOf(Node* n) {
+			int prefixLength = commonPrefixLengthSIMD(value(), n->value(), std::min(length(), n->length()));
+			return (uint64_t(prefixLength) << 16) | keyByte(n->value(), n->length(), prefixLength);
+		}
 
 		// Returns the max version at the given level.
 		Version getMaxVersion(int i) const { return ((Version*)(end() + nPointers * sizeof(Node*)))[i]; }
@@ -252,9 +291,10 @@ private:
 		void setMaxVersion(int i, Version v) { ((Version*)(end() + nPointers * sizeof(Node*)))[i] = v; }
 
 		// Return a node with initialized value but uninitialized pointers
-		// Memory layout: *this, (level+1) Node*, (level+1) Version, value
+		// Memory layout: *this, (level+1) Node*, (level+1) Version, (level+1) partial keys, value
 		static Node* create(const StringRef& value, int level) {
-			int nodeSize = sizeof(Node) + value.size() + (level + 1) * (sizeof(Node*) + sizeof(Version));
+			int nodeSize =
+			    sizeof(Node) + value.size() + (level + 1) * (sizeof(Node*) + sizeof(Version) + sizeof(uint64_t));
 
 			Node* n;
 			if (nodeSize <= 64) {
@@ -301,7 +341,13 @@ private:
 		}
 
 	private:
-		int getNodeSize() const { return sizeof(Node) + valueLength + nPointers * (sizeof(Node*) + sizeof(Version)); }
+		int getNodeSize() const {
+			return sizeof(Node) + valueLength + nPointers * (sizeof(Node*) + sizeof(Version) + sizeof(uint64_t));
+		}
+		uint64_t* partialKeys() { return (uint64_t*)(end() + nPointers * (sizeof(Node*) + sizeof(Version))); }
+		uint64_t const* partialKeys() const {
+			return (uint64_t const*)(end() + nPointers * (sizeof(Node*) + sizeof(Version)));
+		}
 		// Returns the first Node* pointer
 		uint8_t* end() { return (uint8_t*)(this + 1); }
 		uint8_t const* end() const { return (uint8_t const*)(this + 1); }
@@ -338,6 +384,7 @@ public:
 		Node* x = nullptr;
 		Node* alreadyChecked = nullptr;
 		StringRef value;
+		int prefixLength = 0; // Length of the common prefix of value and x's key
 
 		Finger() = default;
 		Finger(Node* header, const StringRef& ptr) : x(header), value(ptr) {}
@@ -345,6 +392,7 @@ public:
 		void init(const StringRef& value, Node* header) {
 			this->value = value;
 			x = header;
+			prefixLength = 0;
 			alreadyChecked = nullptr;
 			level = MaxLevels;
 		}
@@ -364,18 +412,61 @@ public:
 		// Returns true if we have advanced to the next level
 		force_inline bool advance() {
 			Node* next = x->getNext(level - 1);
+			int nextPrefixLength;
 
-			if (next == alreadyChecked || !less(next->value(), next->length(), value.begin(), value.size())) {
+			if (next == alreadyChecked || !nextIsLess(next, level - 1, nextPrefixLength)) {
 				alreadyChecked = next;
 				level--;
 				finger[level] = x;
 				return true;
 			} else {
 				x = next;
+				prefixLength = nextPrefixLength;
 				return false;
 			}
 		}
 
+		// Returns true if next (which is x->getNext(l)) has a key less than value, and if so sets
+		// nextPrefixLength to the length of their common prefix. Relies on x's key being less than value
+		// (or x being the header), and only dereferences next if the partial key does not decide.
+		force_inline bool nextIsLess(Node* next, int l, int& nextPrefixLength) const {
+			if (!partialKeySearch) {
+				nextPrefixLength = 0;
+				return less(next->value(), next->length(), value.begin(), value.size());
+			}
+			const uint64_t partialKey = x->getNextPartialKey(l);
+			const int diffPosition = Node::partialKeyPrefixLength(partialKey);
+			nextPrefixLength = prefixLength;
+			// value diverges (upwards) from x before next does
+			if (prefixLength < diffPosition)
+				return true;
+			// value matches x where next diverges (upwards) from x
+			if (prefixLength > diffPosition)
+				return false;
+
+			const int nextByte = Node::partialKeyByte(partialKey);
+			const int valueByte = keyByte(value.begin(), value.size(), diffPosition);
+			if (valueByte != nextByte)
+				return valueByte > nextByte;
+			if (!valueByte)
+				return false; // Equal keys
+
+			const int start = diffPosition + 1;
+			const int cl = std::min(next->length(), value.size());
+			const int p = start + commonPrefixLengthSIMD(next->value() + start, value.begin() + start, cl - start);
+			nextPrefixLength = p;
+			if (p < cl)
+				return next->value()[p] < value[p];
+			return next->length() < value.size();
+		}
+
+		// Positions this finger at n, which must have a key less than value (or be the header).
+		void setX(Node* n) {
+			x = n;
+			if (partialKeySearch)
+				prefixLength = commonPrefixLengthSIMD(value.begin(), n->value(), std::min(value.size(), n->length()));
+		}
+
 		// pre: !finished()
 		force_inline void nextLevel() {
 			while (!advance())
@@ -490,7 +581,6 @@ public:
 	//   partitions.  In between, operations on each partition must not touch any keys outside
 	//   the partition.  Specifically, the partition to the left of 'key' must not have a range
 	//	 [...,key) inserted, since that would insert an entry at 'key'.
-	// Note this function is not used.
 	void partition(StringRef* begin, int splitCount, SkipList* output) {
 		for (int i = splitCount - 1; i >= 0; i--) {
 			Finger f(header, begin[i]);
@@ -501,8 +591,7 @@ public:
 		swap(output[0]);
 	}
 
-	// Concatenates multiple SkipList objects into one and stores in input[0].
-	// Note this function is not used.
+	// Concatenates multiple SkipList objects into one and stores it in this SkipList.
 	void concatenate(SkipList* input, int count) {
 		std::vector<Finger> ends(count - 1);
 		for (int i = 0; i < ends.size(); i++)
@@ -542,9 +631,9 @@ public:
 		Node* x = startLevel < MaxLevels ? results[0].finger[startLevel] : header;
 		for (int i = 1; i < count; i++) {
 			results[i].level = startLevel;
-			results[i].x = x;
 			results[i].alreadyChecked = nullptr;
 			results[i].value = values[i];
+			results[i].setX(x);
 			for (int j = startLevel; j < MaxLevels; j++)
 				results[i].finger[j] = results[0].finger[j];
 		}
@@ -595,8 +684,17 @@ public:
 					f.finger[l] = x;
 			} else { // f.eraseItem
 				removedCount++;
-				for (int l = 0; l <= x->level(); l++)
-					f.finger[l]->setNext(l, x->getNext(l));
+				for (int l = 0; l <= x->level(); l++) {
+					// The common prefix of finger and x's next is the shorter of finger's with x and x's with next,
+					// so the new partial key is already known to one of them.
+					uint64_t fingerToX = f.finger[l]->getNextPartialKey(l);
+					uint64_t xToNext = x->getNextPartialKey(l);
+					f.finger[l]->setNext(l,
+					                     x->getNext(l),
+					                     Node::partialKeyPrefixLength(fingerToX) < Node::partialKeyPrefixLength(xToNext)
+					                         ? fingerToX
+					                         : xToNext);
+				}
 				for (int i = 1; i <= x->level(); i++)
 					f.finger[i]->setMaxVersion(i, std::max(f.finger[i]->getMaxVersion(i), x->getMaxVersion(i)));
 				x->destroy();
@@ -660,6 +758,7 @@ private:
 
 	struct CheckMax {
 		Finger start, end;
+		int startEndPrefixLength; // Length of the common prefix of start.value and end.value
 		Version version;
 		bool* result;
 		int state;
@@ -675,6 +774,10 @@ private:
 		          Arena* cKRArena) {
 			this->start.init(r.begin, header);
 			this->end.init(r.end, header);
+			this->startEndPrefixLength =
+			    partialKeySearch
+			        ? commonPrefixLengthSIMD(r.begin.begin(), r.end.begin(), std::min(r.begin.size(), r.end.size()))
+			        : 0;
 			this->version = r.version;
 			this->indexInTx = indexInTx;
 			this->cKRArena = cKRArena;
@@ -701,7 +804,10 @@ private:
 						start.prefetch();
 						return false;
 					}
+					// start.x < start.value <= end.value, so end.value shares with start.x the shorter of
+					// the two prefixes
 					end.x = start.x;
+					end.prefixLength = std::min(start.prefixLength, startEndPrefixLength);
 					while (!end.advance())
 						;
 
@@ -760,6 +866,8 @@ private:
 	};
 
 	// Splits the SkipLists so that those after finger is moved to "right".
+	// The max versions of the nodes on either side of the split are recomputed, so that both halves
+	// answer conflict checks exactly as the original list would have for keys in their range.
 	void split(const Finger& f, SkipList& right) {
 		ASSERT(!right.header->getNext(0)); // right must be empty
 		right.header->setMaxVersion(0, f.finger[0]->getMaxVersion(0));
@@ -767,6 +875,10 @@ private:
 			right.header->setNext(l, f.finger[l]->getNext(l));
 			f.finger[l]->setNext(l, nullptr);
 		}
+		for (int l = 1; l < MaxLevels; l++) {
+			f.finger[l]->calcVersionForLevel(l);
+			right.header->calcVersionForLevel(l);
+		}
 	}
 
 	// Sets end's finger to the last nodes at all levels.
@@ -782,20 +894,101 @@ private:
 	}
 };
 
+// A fixed set of threads which run one task per key-range partition of a ConflictSet. Partition 0 is always
+// processed by the calling thread, so a set created for N partitions starts N-1 threads.
+class ConflictSetWorkers : NonCopyable {
+public:
+	explicit ConflictSetWorkers(int partitionCount) {
+		for (int i = 1; i < partitionCount; i++) {
+			workers.push_back(std::make_unique<Worker>(this, i));
+			workers.back()->handle = startThread(&Worker::start, workers.back().get(), 0, "fdb-resolver-cs");
+		}
+	}
+	~ConflictSetWorkers() {
+		for (auto& w : workers) {
+			w->stop = true;
+			w->ready.set();
+		}
+		for (auto& w : workers) {
+			waitThread(w->handle);
+		}
+	}
+
+	int partitionCount() const { return workers.size() + 1; }
+
+	// Calls task(p) for each partition p in [0, count) and returns once all of them are done.
+	void run(int count, const std::function<void(int)>& task) {
+		ASSERT(count <= partitionCount());
+		this->task = &task;
+		for (int i = 1; i < count; i++) {
+			workers[i - 1]->ready.set();
+		}
+		task(0);
+		for (int i = 1; i < count; i++) {
+			workers[i - 1]->done.block();
+		}
+		this->task = nullptr;
+	}
+
+private:
+	struct Worker {
+		ConflictSetWorkers* owner;
+		int partition;
+		THREAD_HANDLE handle;
+		Event ready, done;
+		bool stop = false;
+
+		Worker(ConflictSetWorkers* owner, int partition) : owner(owner), partition(partition) {}
+
+		THREAD_FUNC start(void* arg) {
+			Worker* self = (Worker*)arg;
+			while (true) {
+				self->ready.block();
+				if (self->stop)
+					break;
+				(*self->owner->task)(self->partition);
+				self->done.set();
+			}
+			THREAD_RETURN;
+		}
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	const std::function<void(int)>* task = nullptr;
+};
+
 struct ConflictSet {
-	ConflictSet() : removalKey(makeString(0)), oldestVersion(0) {}
+	ConflictSet(int threadCount, int minParallelRanges, bool useArt)
+	  : removalKey(makeString(0)), oldestVersion(0), minParallelRanges(minParallelRanges) {
+		if (useArt)
+			artHistory = std::make_unique<ArtVersionHistory>();
+		else if (threadCount > 1)
+			workers = std::make_unique<ConflictSetWorkers>(threadCount);
+	}
 	~ConflictSet() {}
 
 	SkipList versionHistory;
 	Key removalKey;
 	Version oldestVersion;
+
+	// Non-null if the history is kept here instead of in versionHistory
+	std::unique_ptr<ArtVersionHistory> artHistory;
+
+	// Non-null if batches are resolved by splitting versionHistory into key-range partitions
+	std::unique_ptr<ConflictSetWorkers> workers;
+	int minParallelRanges;
+
+	bool useParallel(int rangeCount) const { return workers && rangeCount >= std::max(minParallelRanges, 2); }
 };
 
-ConflictSet* newConflictSet() {
-	return new ConflictSet;
+ConflictSet* newConflictSet(int threadCount, int minParallelRanges, bool useArt) {
+	return new ConflictSet(threadCount, minParallelRanges, useArt);
 }
 void clearConflictSet(ConflictSet* cs, Version v) {
-	SkipList(v).swap(cs->versionHistory);
+	if (cs->artHistory)
+		ArtVersionHistory(v).swap(*cs->artHistory);
+	else
+		SkipList(v).swap(cs->versionHistory);
 }
 void destroyConflictSet(ConflictSet* cs) {
 	delete cs;
@@ -946,11 +1139,16 @@ void ConflictBatch::detectConflicts(Version now,
 	t = timer();
 	if (newOldestVersion > cs->oldestVersion) {
 		cs->oldestVersion = newOldestVersion;
-		SkipList::Finger finger;
-		int temp;
-		cs->versionHistory.find(&cs->removalKey, &finger, &temp, 1);
-		cs->versionHistory.removeBefore(cs->oldestVersion, finger, combinedWriteConflictRanges.size() * 3 + 10);
-		cs->removalKey = finger.getValue();
+		if (cs->artHistory) {
+			cs->artHistory->removeBefore(
+			    cs->oldestVersion, cs->removalKey, combinedWriteConflictRanges.size() * 3 + 10);
+		} else {
+			SkipList::Finger finger;
+			int temp;
+			cs->versionHistory.find(&cs->removalKey, &finger, &temp, 1);
+			cs->versionHistory.removeBefore(cs->oldestVersion, finger, combinedWriteConflictRanges.size() * 3 + 10);
+			cs->removalKey = finger.getValue();
+		}
 	}
 	g_removeBefore += timer() - t;
 }
@@ -959,10 +1157,87 @@ void ConflictBatch::checkReadConflictRanges() {
 	if (combinedReadConflictRanges.empty())
 		return;
 
+	if (cs->artHistory) {
+		for (const ReadConflictRange& range : combinedReadConflictRanges) {
+			if (cs->artHistory->detectConflict(range.begin, range.end, range.version)) {
+				transactionConflictStatus[range.transaction] = true;
+				if (range.conflictingKeyRange != nullptr)
+					range.conflictingKeyRange->push_back(*range.cKRArena, range.indexInTx);
+			}
+		}
+		return;
+	}
+
+	if (cs->useParallel(combinedReadConflictRanges.size())) {
+		checkReadConflictRangesParallel();
+		return;
+	}
+
 	cs->versionHistory.detectConflicts(
 	    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
 }
 
+// Splits the version history at (roughly) evenly spaced points of the batch, checks each read conflict range
+// against every partition it overlaps, and then combines the per-partition results in read range order so
+// that the outcome, including the order of reported conflicting key ranges, does not depend on thread timing.
+void ConflictBatch::checkReadConflictRangesParallel() {
+	const int partitionCount = cs->workers->partitionCount();
+	std::vector<StringRef> splits;
+	for (int s = 1; s < partitionCount; s++) {
+		const StringRef& key = points[s * points.size() / partitionCount].key;
+		if (compare(key, splits.empty() ? StringRef() : splits.back()) > 0)
+			splits.push_back(key);
+	}
+	if (splits.empty()) {
+		cs->versionHistory.detectConflicts(
+		    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
+		return;
+	}
+	const int parts = splits.size() + 1;
+	auto splitLess = [](const StringRef& a, const StringRef& b) { return compare(a, b) < 0; };
+
+	// Each partition's ranges are clipped to the partition, and their transaction field is the index of the
+	// original range in combinedReadConflictRanges.
+	std::vector<std::vector<ReadConflictRange>> partRanges(parts);
+	for (int r = 0; r < combinedReadConflictRanges.size(); r++) {
+		const ReadConflictRange& range = combinedReadConflictRanges[r];
+		int p = std::upper_bound(splits.begin(), splits.end(), range.begin, splitLess) - splits.begin();
+		StringRef begin = range.begin;
+		while (true) {
+			bool last = p == parts - 1 || compare(range.end, splits[p]) <= 0;
+			partRanges[p].emplace_back(begin, last ? range.end : splits[p], range.version, r, range.indexInTx);
+			if (last)
+				break;
+			begin = splits[p++];
+		}
+	}
+
+	std::vector<SkipList> partLists(parts);
+	cs->versionHistory.partition(&splits[0], splits.size(), &partLists[0]);
+
+	const int rangeCount = combinedReadConflictRanges.size();
+	std::unique_ptr<bool[]> rangeConflict(new bool[parts * rangeCount]);
+	memset(rangeConflict.get(), 0, parts * rangeCount * sizeof(bool));
+	cs->workers->run(parts, [&](int p) {
+		if (!partRanges[p].empty())
+			partLists[p].detectConflicts(&partRanges[p][0], partRanges[p].size(), &rangeConflict[p * rangeCount]);
+	});
+
+	cs->versionHistory.concatenate(&partLists[0], parts);
+
+	for (int r = 0; r < rangeCount; r++) {
+		bool conflict = false;
+		for (int p = 0; p < parts && !conflict; p++)
+			conflict = rangeConflict[p * rangeCount + r];
+		if (conflict) {
+			const ReadConflictRange& range = combinedReadConflictRanges[r];
+			transactionConflictStatus[range.transaction] = true;
+			if (range.conflictingKeyRange != nullptr)
+				range.conflictingKeyRange->push_back(*range.cKRArena, range.indexInTx);
+		}
+	}
+}
+
 void ConflictBatch::addConflictRanges(Version now,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -990,9 +1265,58 @@ void ConflictBatch::mergeWriteConflictRanges(Version now) {
 	if (combinedWriteConflictRanges.empty())
 		return;
 
+	if (cs->artHistory) {
+		for (const auto& [begin, end] : combinedWriteConflictRanges)
+			cs->artHistory->addConflictRange(begin, end, now);
+		return;
+	}
+
+	if (cs->useParallel(combinedWriteConflictRanges.size())) {
+		mergeWriteConflictRangesParallel(now);
+		return;
+	}
+
 	addConflictRanges(now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
 }
 
+// Splits the version history at the beginning of some of the (sorted, disjoint) combined write conflict ranges
+// and inserts each partition's ranges concurrently. A split key is never the end of the preceding range, so no
+// partition inserts an entry at the first key of the next partition (see SkipList::partition()).
+void ConflictBatch::mergeWriteConflictRangesParallel(Version now) {
+	const int partitionCount = cs->workers->partitionCount();
+	const int rangeCount = combinedWriteConflictRanges.size();
+	std::vector<int> firstRange(1, 0);
+	std::vector<StringRef> splits;
+	for (int s = 1; s < partitionCount; s++) {
+		int r = std::max<int>(s * rangeCount / partitionCount, firstRange.back() + 1);
+		while (r < rangeCount && combinedWriteConflictRanges[r - 1].second == combinedWriteConflictRanges[r].first)
+			r++;
+		if (r >= rangeCount)
+			break;
+		firstRange.push_back(r);
+		splits.push_back(combinedWriteConflictRanges[r].first);
+	}
+	firstRange.push_back(rangeCount);
+	if (splits.empty()) {
+		addConflictRanges(
+		    now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
+		return;
+	}
+	const int parts = splits.size() + 1;
+
+	std::vector<SkipList> partLists(parts);
+	cs->versionHistory.partition(&splits[0], splits.size(), &partLists[0]);
+
+	cs->workers->run(parts, [&](int p) {
+		addConflictRanges(now,
+		                  combinedWriteConflictRanges.begin() + firstRange[p],
+		                  combinedWriteConflictRanges.begin() + firstRange[p + 1],
+		                  &partLists[p]);
+	});
+
+	cs->versionHistory.concatenate(&partLists[0], parts);
+}
+
 void ConflictBatch::combineWriteConflictRanges() {
 	int activeWriteCount = 0;
 	for (const KeyInfo& point : points) {
@@ -1175,3 +1499,170 @@ void skipListTest() {
 
 	printf("%d entries in version history\n", cs->versionHistory.count());
 }
+
+namespace {
+// Keys from a small key space, some sharing prefixes longer than 16 bytes
+StringRef randomConflictKey(Arena& arena) {
+	static const StringRef prefixes[] = { ""_sr, "tenant\x00\x01"_sr, "\x15\x02tenant/subspace/\x01\x02"_sr };
+	const StringRef& prefix = prefixes[deterministicRandom()->randomInt(0, 3)];
+	int length = prefix.size() + deterministicRandom()->randomInt(0, 4);
+	uint8_t* s = new (arena) uint8_t[length];
+	memcpy(s, prefix.begin(), prefix.size());
+	for (int i = prefix.size(); i < length; i++)
+		s[i] = 'a' + deterministicRandom()->randomInt(0, 4);
+	return StringRef(s, length);
+}
+
+// Conflict ranges are never empty
+KeyRangeRef randomConflictRange(Arena& arena) {
+	StringRef a = randomConflictKey(arena), b = randomConflictKey(arena);
+	if (a == b)
+		return KeyRangeRef(a, keyAfter(a, arena));
+	return a < b ? KeyRangeRef(a, b) : KeyRangeRef(b, a);
+}
+} // namespace
+
+namespace {
+// Resolves the same random batches with both conflict sets, and checks that the results are identical
+void checkSameResults(ConflictSet* expected, ConflictSet* actual) {
+	Version version = 100;
+	for (int b = 0; b < 500; b++) {
+		Arena arena;
+		std::vector<CommitTransactionRef> trs(deterministicRandom()->randomInt(1, 50));
+		for (auto& tr : trs) {
+			tr.read_snapshot = version - deterministicRandom()->randomInt(0, 60);
+			tr.report_conflicting_keys = deterministicRandom()->coinflip();
+			for (int r = deterministicRandom()->randomInt(0, 4); r > 0; r--)
+				tr.read_conflict_ranges.push_back(arena, randomConflictRange(arena));
+			for (int w = deterministicRandom()->randomInt(0, 4); w > 0; w--)
+				tr.write_conflict_ranges.push_back(arena, randomConflictRange(arena));
+		}
+		version += deterministicRandom()->randomInt(1, 20);
+		const Version newOldestVersion = version - 50;
+
+		std::vector<int> nonConflicting[2], tooOld[2];
+		std::map<int, VectorRef<int>> conflictingKeys[2];
+		Arena replyArena[2];
+		ConflictSet* sets[2] = { expected, actual };
+		for (int i = 0; i < 2; i++) {
+			ConflictBatch batch(sets[i], &conflictingKeys[i], &replyArena[i]);
+			for (const auto& tr : trs)
+				batch.addTransaction(tr, newOldestVersion);
+			batch.detectConflicts(version, newOldestVersion, nonConflicting[i], &tooOld[i]);
+		}
+
+		ASSERT(nonConflicting[0] == nonConflicting[1]);
+		ASSERT(tooOld[0] == tooOld[1]);
+		ASSERT_EQ(conflictingKeys[0].size(), conflictingKeys[1].size());
+		for (auto& [t, ranges] : conflictingKeys[0]) {
+			std::set<int> expectedRanges(ranges.begin(), ranges.end());
+			std::set<int> actualRanges(conflictingKeys[1][t].begin(), conflictingKeys[1][t].end());
+			ASSERT(expectedRanges == actualRanges);
+		}
+	}
+}
+} // namespace
+
+// Compares a single-threaded and a partitioned conflict set
+TEST_CASE("/fdbserver/ConflictSet/partitioned") {
+	const int threadCount = deterministicRandom()->randomInt(2, 6);
+	ConflictSet* serial = newConflictSet();
+	ConflictSet* parallel = newConflictSet(threadCount, 0);
+
+	checkSameResults(serial, parallel);
+	ASSERT_EQ(serial->versionHistory.count(), parallel->versionHistory.count());
+
+	destroyConflictSet(serial);
+	destroyConflictSet(parallel);
+	return Void();
+}
+
+// Compares conflict sets using the skip list and the adaptive radix tree
+TEST_CASE("/fdbserver/ConflictSet/art") {
+	ConflictSet* skipList = newConflictSet();
+	ConflictSet* art = newConflictSet(1, 0, true);
+
+	checkSameResults(skipList, art);
+
+	destroyConflictSet(skipList);
+	destroyConflictSet(art);
+	return Void();
+}
+
+// Checks the results of resolving random batches against a brute force model of the conflict history.
+TEST_CASE("/fdbserver/ConflictSet/model") {
+	ConflictSet* cs = newConflictSet();
+
+	struct Write {
+		Key begin, end;
+		Version version;
+	};
+	std::vector<Write> history;
+	auto intersects = [](const KeyRangeRef& a, const KeyRef& begin, const KeyRef& end) {
+		return a.begin < end && begin < a.end;
+	};
+
+	Version version = 100;
+	for (int b = 0; b < 500; b++) {
+		Arena arena;
+		std::vector<CommitTransactionRef> trs(deterministicRandom()->randomInt(1, 30));
+		for (auto& tr : trs) {
+			tr.read_snapshot = version - deterministicRandom()->randomInt(0, 60);
+			for (int r = deterministicRandom()->randomInt(0, 4); r > 0; r--)
+				tr.read_conflict_ranges.push_back(arena, randomConflictRange(arena));
+			for (int w = deterministicRandom()->randomInt(0, 4); w > 0; w--)
+				tr.write_conflict_ranges.push_back(arena, randomConflictRange(arena));
+		}
+		version += deterministicRandom()->randomInt(1, 20);
+		const Version newOldestVersion = version - 50;
+
+		std::vector<int> nonConflicting, tooOld;
+		ConflictBatch batch(cs);
+		for (const auto& tr : trs)
+			batch.addTransaction(tr, newOldestVersion);
+		batch.detectConflicts(version, newOldestVersion, nonConflicting, &tooOld);
+
+		std::vector<int> expectedNonConflicting, expectedTooOld;
+		std::vector<Write> batchWrites;
+		for (int t = 0; t < trs.size(); t++) {
+			const CommitTransactionRef& tr = trs[t];
+			if (tr.read_snapshot < newOldestVersion && tr.read_conflict_ranges.size()) {
+				expectedTooOld.push_back(t);
+				continue;
+			}
+			bool conflict = false;
+			for (const auto& r : tr.read_conflict_ranges) {
+				for (const auto& w : history)
+					conflict = conflict || (w.version > tr.read_snapshot && intersects(r, w.begin, w.end));
+				for (const auto& w : batchWrites)
+					conflict = conflict || intersects(r, w.begin, w.end);
+			}
+			if (!conflict) {
+				expectedNonConflicting.push_back(t);
+				for (const auto& w : tr.write_conflict_ranges)
+					batchWrites.push_back(Write{ w.begin, w.end, version });
+			}
+		}
+		history.insert(history.end(), batchWrites.begin(), batchWrites.end());
+
+		ASSERT(nonConflicting == expectedNonConflicting);
+		ASSERT(tooOld == expectedTooOld);
+
+		// Every level of a finger must point at the last node before its value
+		for (int i = 0; i < 10; i++) {
+			StringRef value = randomConflictKey(arena);
+			SkipList::Finger f;
+			int temp;
+			cs->versionHistory.find(&value, &f, &temp, 1);
+			for (int l = 0; l < 26; l++) {
+				auto node = f.finger[l];
+				auto next = node->getNext(l);
+				ASSERT(node == f.finger[25] || compare(StringRef(node->value(), node->length()), value) < 0);
+				ASSERT(!next || compare(StringRef(next->value(), next->length()), value) >= 0);
+			}
+		}
+	}
+
+	destroyConflictSet(cs);
+	return Void();
+}
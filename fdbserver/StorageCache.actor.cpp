@@ -2250,6 +2250,10 @@ ACTOR Future<Void> storageCacheServer(StorageServerInterface ssi,
 				// actors.add(self->readGuard(req , getValueQ));
 				actors.add(getValueQ(&self, req));
 			}
+			when(GetValuesRequest req = waitNext(ssi.getValues.getFuture())) {
+				// Clients read cached ranges one key at a time
+				req.reply.sendError(unsupported_operation());
+			}
 			when(WatchValueRequest req = waitNext(ssi.watchValue.getFuture())) { ASSERT(false); }
 			when(GetKeyRequest req = waitNext(ssi.getKey.getFuture())) { actors.add(getKey(&self, req)); }
 			when(GetKeyValuesRequest req = waitNext(ssi.getKeyValues.getFuture())) {
@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 
+#include "flow/CompressionUtils.h"
 #include "flow/Hash3.h"
 #include "flow/UnitTest.h"
 #include "fdbclient/NativeAPI.actor.h"
@@ -35,11 +36,13 @@
 #include "flow/ActorCollection.h"
 #include "fdbrpc/FailureMonitor.h"
 #include "fdbserver/IDiskQueue.h"
+#include "fdbserver/FifoCache.h"
 #include "fdbrpc/sim_validation.h"
 #include "fdbrpc/simulator.h"
 #include "fdbrpc/Stats.h"
 #include "fdbserver/ServerDBInfo.h"
 #include "fdbserver/LogSystem.h"
+#include "fdbserver/PeekReplyCompressionCache.h"
 #include "fdbserver/WaitFailure.h"
 #include "fdbserver/RecoveryState.h"
 #include "fdbserver/FDBExecHelper.actor.h"
@@ -108,6 +111,8 @@ public:
 	//    uint32_t payloadSize
 	//    uint8_t payload[payloadSize]  (begins with uint64_t protocolVersion via IncludeVersion)
 	//    uint8_t validFlag
+	// A validFlag of compressedPacketFlag instead means the payload is a CompressionFilter followed by the compressed
+	// bytes of the payload above. Only logs of TLogVersion::V8 and later write such packets.
 
 	// TLogQueue is a durable queue of TLogQueueEntry objects with an interface similar to IDiskQueue
 
@@ -128,6 +133,39 @@ public:
 	void pop(IDiskQueue::location upToLocation);
 	Future<Void> commit() { return queue->commit(); }
 
+	static constexpr uint8_t compressedPacketFlag = 2;
+
+	template <class T>
+	static Standalone<StringRef> encodePacket(T const& qe, CompressionFilter filter);
+
+	// Returns packet compressed with filter, or packet itself if it is too small or doesn't compress
+	static Standalone<StringRef> compressPacket(Standalone<StringRef> packet, CompressionFilter filter) {
+		const uint32_t payloadSize = packet.size() - sizeof(uint32_t) - sizeof(uint8_t);
+		if (filter == CompressionFilter::NONE || payloadSize < SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_MIN_BYTES) {
+			return packet;
+		}
+		Arena arena;
+		StringRef compressed = CompressionUtils::compress(filter, packet.substr(sizeof(uint32_t), payloadSize), arena);
+		if (compressed.size() + sizeof(uint8_t) >= payloadSize) {
+			return packet;
+		}
+		BinaryWriter wr(Unversioned());
+		wr << uint32_t(compressed.size() + sizeof(uint8_t)) << static_cast<uint8_t>(filter);
+		wr.serializeBytes(compressed);
+		wr << compressedPacketFlag;
+		return wr.toValue();
+	}
+
+	// Returns the payload of a packet, decompressed into arena if it is compressed
+	static StringRef decodePayload(StringRef payload, uint8_t validFlag, Arena& arena) {
+		if (validFlag == compressedPacketFlag) {
+			auto filter = static_cast<CompressionFilter>(payload[0]);
+			return CompressionUtils::decompress(filter, payload.substr(sizeof(uint8_t)), arena);
+		}
+		ASSERT(validFlag == 1);
+		return payload;
+	}
+
 	// Implements IClosable
 	Future<Void> getError() const override { return queue->getError(); }
 	Future<Void> onClosed() const override { return queue->onClosed(); }
@@ -178,9 +216,8 @@ private:
 			}
 
 			if (e[payloadSize]) {
-				ASSERT(e[payloadSize] == 1);
 				Arena a = e.arena();
-				ArenaReader ar(a, e.substr(0, payloadSize), IncludeVersion());
+				ArenaReader ar(a, decodePayload(e.substr(0, payloadSize), e[payloadSize], a), IncludeVersion());
 				ar >> result;
 				const IDiskQueue::location endloc = self->queue->getNextReadLocation();
 				self->updateVersionSizes(result, tLog, startloc, endloc);
@@ -205,6 +242,8 @@ static const KeyValueRef persistFormat("Format"_sr, "FoundationDB/LogServer/3/0"
 static const KeyRangeRef persistFormatReadableRange("FoundationDB/LogServer/3/0"_sr, "FoundationDB/LogServer/4/0"_sr);
 static const KeyRangeRef persistProtocolVersionKeys("ProtocolVersion/"_sr, "ProtocolVersion0"_sr);
 static const KeyRangeRef persistTLogSpillTypeKeys("TLogSpillType/"_sr, "TLogSpillType0"_sr);
+// Absent for logs written before TLogVersion::V8
+static const KeyRangeRef persistTLogVersionKeys("TLogVersion/"_sr, "TLogVersion0"_sr);
 static const KeyRangeRef persistRecoveryCountKeys = KeyRangeRef("DbRecoveryCount/"_sr, "DbRecoveryCount0"_sr);
 
 // Updated on updatePersistentData()
@@ -269,6 +308,35 @@ static Version decodeTagMessagesKey(StringRef key) {
 	return bigEndian64(BinaryReader::fromStringRef<Version>(stripTagMessagesKey(key), Unversioned()));
 }
 
+// An uncompressed spilled-by-value entry is a sequence of length prefixed messages, so its first four bytes are never
+// this marker. A compressed entry is the marker, the CompressionFilter and then the compressed messages.
+static constexpr uint32_t compressedTagMessagesMarker = std::numeric_limits<uint32_t>::max();
+
+static Value persistTagMessagesValue(Value const& messages, CompressionFilter filter) {
+	if (filter == CompressionFilter::NONE) {
+		return messages;
+	}
+	Arena arena;
+	StringRef compressed = CompressionUtils::compress(filter, messages, arena);
+	if (compressed.size() + sizeof(compressedTagMessagesMarker) + sizeof(uint8_t) >= messages.size()) {
+		return messages;
+	}
+	BinaryWriter wr(Unversioned());
+	wr << compressedTagMessagesMarker << static_cast<uint8_t>(filter);
+	wr.serializeBytes(compressed);
+	return wr.toValue();
+}
+
+static StringRef decodeTagMessagesValue(StringRef value, Arena& arena) {
+	if (value.size() < sizeof(compressedTagMessagesMarker) ||
+	    *reinterpret_cast<const uint32_t*>(value.begin()) != compressedTagMessagesMarker) {
+		return value;
+	}
+	const int headerSize = sizeof(compressedTagMessagesMarker) + sizeof(uint8_t);
+	auto filter = static_cast<CompressionFilter>(value[sizeof(compressedTagMessagesMarker)]);
+	return CompressionUtils::decompress(filter, value.substr(headerSize), arena);
+}
+
 struct SpilledData {
 	SpilledData() = default;
 	SpilledData(Version version, IDiskQueue::location start, uint32_t length, uint32_t mutationBytes)
@@ -285,6 +353,30 @@ struct SpilledData {
 	uint32_t mutationBytes = 0;
 };
 
+// Peek results read from spilled data, keyed by log, tag and begin version. Spilled messages never change once durable,
+// so storage server replicas, backup workers and log routers catching up on the same tag share one disk read. The logs
+// of all generations a TLog holds share one cache and its TLOG_PEEK_CACHE_BYTES.
+class SpilledPeekCache {
+public:
+	struct Block {
+		Standalone<StringRef> messages;
+		Version end;
+	};
+
+	explicit SpilledPeekCache(int64_t capacityBytes) : cache(capacityBytes) {}
+
+	Optional<Block> get(UID logId, Tag tag, Version begin) const {
+		return cache.get(std::make_tuple(logId, tag, begin));
+	}
+	void insert(UID logId, Tag tag, Version begin, Block const& block) {
+		cache.insert(std::make_tuple(logId, tag, begin), block, block.messages.size());
+	}
+	int64_t getBytes() const { return cache.getBytes(); }
+
+private:
+	FifoCache<std::tuple<UID, Tag, Version>, Block> cache;
+};
+
 struct TLogData : NonCopyable {
 	AsyncTrigger newLogData;
 	// A process has only 1 SharedTLog, which holds data for multiple logs, so that it obeys its assigned memory limit.
@@ -339,6 +431,7 @@ struct TLogData : NonCopyable {
 
 	WorkerCache<TLogInterface> tlogCache;
 	FlowLock peekMemoryLimiter;
+	SpilledPeekCache spilledPeekCache;
 
 	PromiseStream<Future<Void>> sharedActors;
 	Promise<Void> terminated;
@@ -360,6 +453,11 @@ struct TLogData : NonCopyable {
 
 	Reference<Histogram> commitLatencyDist;
 
+	// Compression applied to messages spilled by value into persistentData, by logs of TLogVersion::V8 and later
+	CompressionFilter spillCompressionFilter;
+	// Compression applied to commits pushed into persistentQueue, by logs of TLogVersion::V8 and later
+	CompressionFilter queueCompressionFilter;
+
 	TLogData(UID dbgid,
 	         UID workerID,
 	         IKeyValueStore* persistentData,
@@ -373,9 +471,23 @@ struct TLogData : NonCopyable {
 	    instanceID(deterministicRandom()->randomUniqueID().first()), bytesInput(0), bytesDurable(0),
 	    targetVolatileBytes(SERVER_KNOBS->TLOG_SPILL_THRESHOLD), overheadBytesInput(0), overheadBytesDurable(0),
 	    peekMemoryLimiter(SERVER_KNOBS->TLOG_SPILL_REFERENCE_MAX_PEEK_MEMORY_BYTES),
+	    spilledPeekCache(SERVER_KNOBS->TLOG_PEEK_CACHE_BYTES),
 	    concurrentLogRouterReads(SERVER_KNOBS->CONCURRENT_LOG_ROUTER_READS), ignorePopDeadline(0), dataFolder(folder),
 	    degraded(degraded),
-	    commitLatencyDist(Histogram::getHistogram("tLog"_sr, "commit"_sr, Histogram::Unit::milliseconds)) {
+	    commitLatencyDist(Histogram::getHistogram("tLog"_sr, "commit"_sr, Histogram::Unit::milliseconds)),
+	    spillCompressionFilter(
+	        CompressionUtils::fromFilterString(SERVER_KNOBS->TLOG_SPILL_BY_VALUE_COMPRESSION_FILTER)),
+	    queueCompressionFilter(CompressionUtils::fromFilterString(SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_FILTER)) {
+		if (!CompressionUtils::supportedFilters.count(spillCompressionFilter)) {
+			TraceEvent(SevWarnAlways, "TLogSpillCompressionUnsupported", dbgid)
+			    .detail("Filter", SERVER_KNOBS->TLOG_SPILL_BY_VALUE_COMPRESSION_FILTER);
+			spillCompressionFilter = CompressionFilter::NONE;
+		}
+		if (!CompressionUtils::supportedFilters.count(queueCompressionFilter)) {
+			TraceEvent(SevWarnAlways, "TLogQueueCompressionUnsupported", dbgid)
+			    .detail("Filter", SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_FILTER);
+			queueCompressionFilter = CompressionFilter::NONE;
+		}
 		cx = openDBOnServer(dbInfo, TaskPriority::DefaultEndpoint, LockAware::True);
 	}
 };
@@ -545,6 +657,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	Counter blockingPeekTimeouts;
 	Counter emptyPeeks;
 	Counter nonEmptyPeeks;
+	Counter peekCacheHits;
+	Counter peekCacheMisses;
 	std::map<Tag, LatencySample> blockingPeekLatencies;
 	std::map<Tag, LatencySample> peekVersionCounts;
 
@@ -600,6 +714,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	};
 
 	std::map<UID, PeekTrackerData> peekTracker;
+	PeekReplyCompressionCache peekCompressionCache;
 
 	Reference<AsyncVar<Reference<ILogSystem>>> logSystem;
 	Tag remoteTag;
@@ -609,6 +724,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	int8_t locality;
 	UID recruitmentID;
 	TLogSpillType logSpillType;
+	TLogVersion logVersion;
 	std::set<Tag> allTags;
 	Future<Void> terminated;
 	FlowLock execOpLock;
@@ -627,6 +743,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	                 UID recruitmentID,
 	                 ProtocolVersion protocolVersion,
 	                 TLogSpillType logSpillType,
+	                 TLogVersion logVersion,
 	                 std::vector<Tag> tags,
 	                 std::string context)
 	  : initialized(false), queueCommittingVersion(0), knownCommittedVersion(0), durableKnownCommittedVersion(0),
@@ -634,13 +751,15 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	    unpoppedRecoveredTagCount(0), cc("TLog", interf.id().toString()), bytesInput("BytesInput", cc),
 	    bytesDurable("BytesDurable", cc), blockingPeeks("BlockingPeeks", cc),
 	    blockingPeekTimeouts("BlockingPeekTimeouts", cc), emptyPeeks("EmptyPeeks", cc),
-	    nonEmptyPeeks("NonEmptyPeeks", cc), logId(interf.id()), protocolVersion(protocolVersion),
-	    newPersistentDataVersion(invalidVersion), tLogData(tLogData), unrecoveredBefore(1), recoveredAt(1),
-	    recoveryTxnVersion(1), logSystem(new AsyncVar<Reference<ILogSystem>>()), remoteTag(remoteTag),
-	    isPrimary(isPrimary), logRouterTags(logRouterTags), logRouterPoppedVersion(0), logRouterPopToVersion(0),
-	    locality(tagLocalityInvalid), recruitmentID(recruitmentID), logSpillType(logSpillType),
-	    allTags(tags.begin(), tags.end()), terminated(tLogData->terminated.getFuture()), execOpCommitInProgress(false),
-	    txsTags(txsTags) {
+	    nonEmptyPeeks("NonEmptyPeeks", cc), peekCacheHits("PeekCacheHits", cc), peekCacheMisses("PeekCacheMisses", cc),
+	    logId(interf.id()), protocolVersion(protocolVersion), newPersistentDataVersion(invalidVersion),
+	    tLogData(tLogData), unrecoveredBefore(1), recoveredAt(1), recoveryTxnVersion(1),
+	    logSystem(new AsyncVar<Reference<ILogSystem>>()),
+	    remoteTag(remoteTag), isPrimary(isPrimary),
+	    logRouterTags(logRouterTags), logRouterPoppedVersion(0), logRouterPopToVersion(0), locality(tagLocalityInvalid),
+	    recruitmentID(recruitmentID), logSpillType(logSpillType), logVersion(logVersion),
+	    allTags(tags.begin(), tags.end()),
+	    terminated(tLogData->terminated.getFuture()), execOpCommitInProgress(false), txsTags(txsTags) {
 		startRole(Role::TRANSACTION_LOG,
 		          interf.id(),
 		          tLogData->workerID,
@@ -671,6 +790,11 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 		specialCounter(cc, "SharedOverheadBytesDurable", [tLogData]() { return tLogData->overheadBytesDurable; });
 		specialCounter(cc, "PeekMemoryReserved", [tLogData]() { return tLogData->peekMemoryLimiter.activePermits(); });
 		specialCounter(cc, "PeekMemoryRequestsStalled", [tLogData]() { return tLogData->peekMemoryLimiter.waiters(); });
+		specialCounter(cc, "SharedPeekCacheBytes", [tLogData]() { return tLogData->spilledPeekCache.getBytes(); });
+		specialCounter(cc, "PeekCacheHitPercent", [this]() {
+			int64_t lookups = this->peekCacheHits.getValue() + this->peekCacheMisses.getValue();
+			return lookups ? 100 * this->peekCacheHits.getValue() / lookups : 0;
+		});
 		specialCounter(cc, "Generation", [this]() { return this->recoveryCount; });
 		specialCounter(cc, "ActivePeekStreams", [tLogData]() { return tLogData->activePeekStreams; });
 	}
@@ -698,6 +822,7 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 			tLogData->persistentData->clear(singleKeyRange(logIdKey.withPrefix(persistRecoveryCountKeys.begin)));
 			tLogData->persistentData->clear(singleKeyRange(logIdKey.withPrefix(persistProtocolVersionKeys.begin)));
 			tLogData->persistentData->clear(singleKeyRange(logIdKey.withPrefix(persistTLogSpillTypeKeys.begin)));
+			tLogData->persistentData->clear(singleKeyRange(logIdKey.withPrefix(persistTLogVersionKeys.begin)));
 			tLogData->persistentData->clear(singleKeyRange(logIdKey.withPrefix(persistRecoveryLocationKey)));
 			Key msgKey = logIdKey.withPrefix(persistTagMessagesKeys.begin);
 			tLogData->persistentData->clear(KeyRangeRef(msgKey, strinc(msgKey)));
@@ -732,6 +857,17 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 
 	bool shouldSpillByReference(Tag t) const { return !shouldSpillByValue(t); }
 
+	// Binaries older than TLogVersion::V8 cannot read compressed spilled messages, and they never recruit or restore
+	// a log of that version, so only such logs compress.
+	CompressionFilter spillCompressionFilter() const {
+		return logVersion >= TLogVersion::V8 ? tLogData->spillCompressionFilter : CompressionFilter::NONE;
+	}
+
+	// Likewise for compressed packets in the disk queue
+	CompressionFilter queueCompressionFilter() const {
+		return logVersion >= TLogVersion::V8 ? tLogData->queueCompressionFilter : CompressionFilter::NONE;
+	}
+
 	void unblockWaitingPeeks() {
 		if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
 			for (auto& iter : waitingTags) {
@@ -755,16 +891,22 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 };
 
 template <class T>
-void TLogQueue::push(T const& qe, Reference<LogData> logData) {
+Standalone<StringRef> TLogQueue::encodePacket(T const& qe, CompressionFilter filter) {
 	BinaryWriter wr(Unversioned()); // outer framing is not versioned
 	wr << uint32_t(0);
 	IncludeVersion(ProtocolVersion::withTLogQueueEntryRef()).write(wr); // payload is versioned
 	wr << qe;
 	wr << uint8_t(1);
 	*(uint32_t*)wr.getData() = wr.getLength() - sizeof(uint32_t) - sizeof(uint8_t);
+	return compressPacket(wr.toValue(), filter);
+}
+
+template <class T>
+void TLogQueue::push(T const& qe, Reference<LogData> logData) {
+	const Standalone<StringRef> packet = encodePacket(qe, logData->queueCompressionFilter());
 	const IDiskQueue::location startloc = queue->getNextPushLocation();
 	// FIXME: push shouldn't return anything.  We should call getNextPushLocation() again.
-	const IDiskQueue::location endloc = queue->push(wr.toValue());
+	const IDiskQueue::location endloc = queue->push(packet);
 	//TraceEvent("TLogQueueVersionWritten", dbgid).detail("Size", wr.getLength() - sizeof(uint32_t) - sizeof(uint8_t)).detail("Loc", loc);
 	logData->versionLocation[qe.version] = std::make_pair(startloc, endloc);
 }
@@ -1019,8 +1161,9 @@ ACTOR Future<Void> updatePersistentData(TLogData* self, Reference<LogData> logDa
 						for (; msg != tagData->versionMessages.end() && msg->first == currentVersion; ++msg) {
 							wr << msg->second.toStringRef();
 						}
-						self->persistentData->set(KeyValueRef(
-						    persistTagMessagesKey(logData->logId, tagData->tag, currentVersion), wr.toValue()));
+						self->persistentData->set(
+						    KeyValueRef(persistTagMessagesKey(logData->logId, tagData->tag, currentVersion),
+						                persistTagMessagesValue(wr.toValue(), logData->spillCompressionFilter())));
 					} else {
 						// spill everything else by reference
 						const IDiskQueue::location begin = logData->versionLocation[currentVersion].first;
@@ -1448,6 +1591,33 @@ ACTOR Future<Void> updateStorageLoop(TLogData* self) {
 	loop { wait(updateStorage(self)); }
 }
 
+// Maps a tag of a pushed message to the tag logData keeps the message under. Returns false if logData does not keep
+// messages of the tag.
+bool mapPushedTag(Reference<LogData> const& logData, Tag& tag) {
+	if (logData->locality == tagLocalitySatellite) {
+		if (!(tag.locality == tagLocalityTxs || tag.locality == tagLocalityLogRouter || tag == txsTag)) {
+			return false;
+		}
+	} else if (!(logData->locality == tagLocalitySpecial || logData->locality == tag.locality || tag.locality < 0)) {
+		return false;
+	}
+
+	if (tag.locality == tagLocalityLogRouter) {
+		if (!logData->logRouterTags) {
+			return false;
+		}
+		tag.id = tag.id % logData->logRouterTags;
+	}
+	if (tag.locality == tagLocalityTxs) {
+		if (logData->txsTags > 0) {
+			tag.id = tag.id % logData->txsTags;
+		} else {
+			tag = txsTag;
+		}
+	}
+	return true;
+}
+
 void commitMessages(TLogData* self,
                     Reference<LogData> logData,
                     Version version,
@@ -1493,28 +1663,9 @@ void commitMessages(TLogData* self,
 		    .detail("DebugID", self->dbgid);
 		block.append(block.arena(), msg.message.begin(), msg.message.size());
 		for (auto tag : msg.tags) {
-			if (logData->locality == tagLocalitySatellite) {
-				if (!(tag.locality == tagLocalityTxs || tag.locality == tagLocalityLogRouter || tag == txsTag)) {
-					continue;
-				}
-			} else if (!(logData->locality == tagLocalitySpecial || logData->locality == tag.locality ||
-			             tag.locality < 0)) {
+			if (!mapPushedTag(logData, tag)) {
 				continue;
 			}
-
-			if (tag.locality == tagLocalityLogRouter) {
-				if (!logData->logRouterTags) {
-					continue;
-				}
-				tag.id = tag.id % logData->logRouterTags;
-			}
-			if (tag.locality == tagLocalityTxs) {
-				if (logData->txsTags > 0) {
-					tag.id = tag.id % logData->txsTags;
-				} else {
-					tag = txsTag;
-				}
-			}
 			Reference<LogData::TagData> tagData = logData->getTagData(tag);
 			if (!tagData) {
 				tagData = logData->createTagData(tag, 0, true, true, false);
@@ -1564,6 +1715,110 @@ void commitMessages(TLogData* self,
 	//TraceEvent("TLogPushed", self->dbgid).detail("Bytes", addedBytes).detail("MessageBytes", messages.size()).detail("Tags", tags.size()).detail("ExpectedBytes", expectedBytes).detail("MCount", mCount).detail("TCount", tCount);
 }
 
+// Commits messages which the proxy indexed by tag in tagMessages, without parsing the tags of each message.
+void commitMessages(TLogData* self,
+                    Reference<LogData> logData,
+                    Version version,
+                    StringRef messages,
+                    VectorRef<TagMessagesRef> tagMessages) {
+	int64_t addedBytes = 0;
+	int64_t overheadBytes = 0;
+	int expectedBytes = 0;
+	int txsBytes = 0;
+
+	if (!messages.size()) {
+		return;
+	}
+
+	// All messages of the version go into one block, so each tag's messages can be located by their offsets
+	Standalone<VectorRef<uint8_t>> block;
+	if (!logData->messageBlocks.empty()) {
+		block = logData->messageBlocks.back().second;
+		block.pop_front(block.size());
+	}
+	if (messages.size() > block.capacity() - block.size()) {
+		block = Standalone<VectorRef<uint8_t>>();
+		block.reserve(block.arena(), std::max<int64_t>(SERVER_KNOBS->TLOG_MESSAGE_BLOCK_BYTES, messages.size()));
+	}
+	block.append(block.arena(), messages.begin(), messages.size());
+	uint8_t* blockMessages = block.end() - messages.size();
+
+	// Traces each message as the unindexed commitMessages() does. Only mutation tracking builds parse the messages.
+	if (MUTATION_TRACKING_ENABLED) {
+		ArenaReader rd(block.arena(), StringRef(blockMessages, messages.size()), Unversioned());
+		while (!rd.empty()) {
+			TagsAndMessage tagsAndMsg;
+			tagsAndMsg.loadFromArena(&rd, nullptr);
+			DEBUG_TAGS_AND_MESSAGE("TLogCommitMessages", version, tagsAndMsg.getRawMessage(), logData->logId)
+			    .detail("DebugID", self->dbgid);
+		}
+	}
+
+	for (auto& pushed : tagMessages) {
+		Tag tag = pushed.tag;
+		if (!mapPushedTag(logData, tag)) {
+			continue;
+		}
+		Reference<LogData::TagData> tagData = logData->getTagData(tag);
+		if (!tagData) {
+			tagData = logData->createTagData(tag, 0, true, true, false);
+		}
+		if (version < tagData->popped) {
+			continue;
+		}
+
+		// Several pushed tags can map to the same tag here, e.g. log router tags when there are fewer log routers than
+		// in the proxy's configuration. Their messages of this version are merged back into push order.
+		auto& versionMessages = tagData->versionMessages;
+		int mergeWith = 0;
+		while (mergeWith < versionMessages.size() && versionMessages.rbegin()[mergeWith].first == version) {
+			mergeWith++;
+		}
+
+		for (int offset : pushed.messageOffsets) {
+			ASSERT(offset >= 0 && offset + sizeof(uint32_t) <= messages.size());
+			versionMessages.emplace_back(version, LengthPrefixedStringRef((uint32_t*)(blockMessages + offset)));
+			int messageSize = versionMessages.back().second.expectedSize();
+			ASSERT(offset + sizeof(uint32_t) + messageSize <= messages.size());
+			if (messageSize > SERVER_KNOBS->MAX_MESSAGE_SIZE) {
+				TraceEvent(SevWarnAlways, "LargeMessage").detail("Size", messageSize);
+			}
+			if (tag.locality != tagLocalityTxs && tag != txsTag) {
+				expectedBytes += messageSize;
+			} else {
+				txsBytes += messageSize;
+			}
+			overheadBytes += SERVER_KNOBS->VERSION_MESSAGES_ENTRY_BYTES_WITH_OVERHEAD;
+		}
+
+		if (mergeWith) {
+			CODE_PROBE(true, "Merging indexed messages of pushed tags which map to the same TLog tag");
+			auto added = versionMessages.end() - pushed.messageOffsets.size();
+			std::inplace_merge(added - mergeWith, added, versionMessages.end(), [](auto const& a, auto const& b) {
+				return a.second.getLengthPtr() < b.second.getLengthPtr();
+			});
+		}
+
+		if (SERVER_KNOBS->ENABLE_VERSION_VECTOR && pushed.messageOffsets.size()) {
+			auto iter = logData->waitingTags.find(tag);
+			if (iter != logData->waitingTags.end()) {
+				auto promise = iter->second;
+				logData->waitingTags.erase(iter);
+				promise.send(Void());
+			}
+		}
+	}
+
+	logData->messageBlocks.emplace_back(version, block);
+	addedBytes += int64_t(block.size()) * SERVER_KNOBS->TLOG_MESSAGE_BLOCK_OVERHEAD_FACTOR;
+	addedBytes += overheadBytes;
+
+	logData->version_sizes[version] = std::make_pair(expectedBytes, txsBytes);
+	logData->bytesInput += addedBytes;
+	self->bytesInput += addedBytes;
+	self->overheadBytesInput += overheadBytes;
+}
+
 void commitMessages(TLogData* self, Reference<LogData> logData, Version version, Arena arena, StringRef messages) {
 	ArenaReader rd(arena, messages, Unversioned());
 	self->tempTagMessages.clear();
@@ -1682,7 +1937,8 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
                               Tag reqTag,
                               bool reqReturnIfBlocked = false,
                               bool reqOnlySpilled = false,
-                              Optional<std::pair<UID, int>> reqSequence = Optional<std::pair<UID, int>>()) {
+                              Optional<std::pair<UID, int>> reqSequence = Optional<std::pair<UID, int>>(),
+                              Optional<CompressionFilter> reqCompression = Optional<CompressionFilter>()) {
 	state BinaryWriter messages(Unversioned());
 	state BinaryWriter messages2(Unversioned());
 	state int sequence = -1;
@@ -1897,7 +2153,14 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				peekMessagesFromMemory(logData, reqTag, reqBegin, messages2, endVersion);
 			}
 
-			if (logData->shouldSpillByValue(reqTag)) {
+			auto cachedBlock = self->spilledPeekCache.get(logData->logId, reqTag, reqBegin);
+			if (cachedBlock.present()) {
+				++logData->peekCacheHits;
+				messages.serializeBytes(cachedBlock.get().messages);
+				endVersion = cachedBlock.get().end;
+				onlySpilled = true;
+			} else if (logData->shouldSpillByValue(reqTag)) {
+				++logData->peekCacheMisses;
 				RangeResult kvs = wait(self->persistentData->readRange(
 				    KeyRangeRef(
 				        persistTagMessagesKey(logData->logId, reqTag, reqBegin),
@@ -1908,16 +2171,18 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				for (auto& kv : kvs) {
 					auto ver = decodeTagMessagesKey(kv.key);
 					messages << VERSION_HEADER << ver;
-					messages.serializeBytes(kv.value);
+					messages.serializeBytes(decodeTagMessagesValue(kv.value, kvs.arena()));
 				}
 
 				if (kvs.expectedSize() >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
 					endVersion = decodeTagMessagesKey(kvs.end()[-1].key) + 1;
 					onlySpilled = true;
+					self->spilledPeekCache.insert(logData->logId, reqTag, reqBegin, { messages.toValue(), endVersion });
 				} else {
 					messages.serializeBytes(messages2.toValue());
 				}
 			} else {
+				++logData->peekCacheMisses;
 				// FIXME: Limit to approximately DESIRED_TOTATL_BYTES somehow.
 				RangeResult kvrefs = wait(self->persistentData->readRange(
 				    KeyRangeRef(
@@ -1972,14 +2237,14 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 					if (index >= messageReads.size())
 						break;
 					Standalone<StringRef> queueEntryData = messageReads[index].get();
-					uint8_t valid;
 					const uint32_t length = *(uint32_t*)queueEntryData.begin();
-					queueEntryData = queueEntryData.substr(4, queueEntryData.size() - 4);
-					BinaryReader rd(queueEntryData, IncludeVersion());
+					ASSERT(sizeof(length) + length + sizeof(uint8_t) == queueEntryData.size());
+					Arena arena = queueEntryData.arena();
+					StringRef payload = TLogQueue::decodePayload(
+					    queueEntryData.substr(sizeof(length), length), queueEntryData[sizeof(length) + length], arena);
+					ArenaReader rd(arena, payload, IncludeVersion());
 					state TLogQueueEntry entry;
-					rd >> entry >> valid;
-					ASSERT(valid == 0x01);
-					ASSERT(length + sizeof(valid) == queueEntryData.size());
+					rd >> entry;
 
 					messages << VERSION_HEADER << entry.version;
 
@@ -2002,6 +2267,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				if (earlyEnd) {
 					endVersion = lastRefMessageVersion + 1;
 					onlySpilled = true;
+					self->spilledPeekCache.insert(logData->logId, reqTag, reqBegin, { messages.toValue(), endVersion });
 				} else {
 					messages.serializeBytes(messages2.toValue());
 				}
@@ -2100,6 +2366,10 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 		reply.begin = reqBegin;
 	}
 
+	if (reqCompression.present()) {
+		logData->peekCompressionCache.compress(reply, reqTag, reqBegin, reqCompression.get());
+	}
+
 	replyPromise.send(reply);
 	return Void();
 }
@@ -2117,7 +2387,15 @@ ACTOR Future<Void> tLogPeekStream(TLogData* self, TLogPeekStreamRequest req, Ref
 		state Future<TLogPeekReply> future(promise.getFuture());
 		try {
 			wait(req.reply.onReady() && store(reply.rep, future) &&
-			     tLogPeekMessages(promise, self, logData, begin, req.tag, req.returnIfBlocked, onlySpilled));
+			     tLogPeekMessages(promise,
+			                      self,
+			                      logData,
+			                      begin,
+			                      req.tag,
+			                      req.returnIfBlocked,
+			                      onlySpilled,
+			                      Optional<std::pair<UID, int>>(),
+			                      req.compressionFilter));
 
 			reply.rep.begin = begin;
 			req.reply.send(reply);
@@ -2316,7 +2594,11 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
 			g_traceBatch.addEvent("CommitDebug", tlogDebugID.get().first(), "TLog.tLogCommit.Before");
 
 		//TraceEvent("TLogCommit", logData->logId).detail("Version", req.version);
-		commitMessages(self, logData, req.version, req.arena, req.messages);
+		if (req.tagMessages.size()) {
+			commitMessages(self, logData, req.version, req.messages, req.tagMessages);
+		} else {
+			commitMessages(self, logData, req.version, req.arena, req.messages);
+		}
 
 		logData->knownCommittedVersion = std::max(logData->knownCommittedVersion, req.knownCommittedVersion);
 
@@ -2394,6 +2676,9 @@ ACTOR Future<Void> initPersistentState(TLogData* self, Reference<LogData> logDat
 	storage->set(
 	    KeyValueRef(BinaryWriter::toValue(logData->logId, Unversioned()).withPrefix(persistTLogSpillTypeKeys.begin),
 	                BinaryWriter::toValue(logData->logSpillType, AssumeVersion(logData->protocolVersion))));
+	storage->set(
+	    KeyValueRef(BinaryWriter::toValue(logData->logId, Unversioned()).withPrefix(persistTLogVersionKeys.begin),
+	                BinaryWriter::toValue(logData->logVersion, Unversioned())));
 
 	for (auto tag : logData->allTags) {
 		ASSERT(!logData->getTagData(tag));
@@ -2688,8 +2973,15 @@ ACTOR Future<Void> serveTLogInterface(TLogData* self,
 			logData->addActor.send(tLogPeekStream(self, req, logData));
 		}
 		when(TLogPeekRequest req = waitNext(tli.peekMessages.getFuture())) {
-			logData->addActor.send(tLogPeekMessages(
-			    req.reply, self, logData, req.begin, req.tag, req.returnIfBlocked, req.onlySpilled, req.sequence));
+			logData->addActor.send(tLogPeekMessages(req.reply,
+			                                        self,
+			                                        logData,
+			                                        req.begin,
+			                                        req.tag,
+			                                        req.returnIfBlocked,
+			                                        req.onlySpilled,
+			                                        req.sequence,
+			                                        req.compressionFilter));
 		}
 		when(TLogPopRequest req = waitNext(tli.popMessages.getFuture())) {
 			logData->addActor.send(tLogPop(self, req, logData));
@@ -3025,6 +3317,7 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
                                           Promise<Void> recovered,
                                           PromiseStream<InitializeTLogRequest> tlogRequests) {
 	state double startt = now();
+	state double startTimer = timer_monotonic();
 	state Reference<LogData> logData;
 	state KeyRange tagKeys;
 	// PERSIST: Read basic state from persistentData; replay persistentQueue but don't erase it
@@ -3043,6 +3336,7 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 	state Future<RangeResult> fRecoverCounts = storage->readRange(persistRecoveryCountKeys);
 	state Future<RangeResult> fProtocolVersions = storage->readRange(persistProtocolVersionKeys);
 	state Future<RangeResult> fTLogSpillTypes = storage->readRange(persistTLogSpillTypeKeys);
+	state Future<RangeResult> fTLogVersions = storage->readRange(persistTLogVersionKeys);
 
 	// FIXME: metadata in queue?
 
@@ -3054,7 +3348,8 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 	                             fTxsTags,
 	                             fRecoverCounts,
 	                             fProtocolVersions,
-	                             fTLogSpillTypes }));
+	                             fTLogSpillTypes,
+	                             fTLogVersions }));
 
 	if (fEncryptionAtRestMode.get().present()) {
 		self->encryptionAtRestMode =
@@ -3113,6 +3408,13 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 		    BinaryReader::fromStringRef<int>(it.value, Unversioned());
 	}
 
+	state std::map<UID, TLogVersion> id_logVersion;
+	for (auto it : fTLogVersions.get()) {
+		id_logVersion[BinaryReader::fromStringRef<UID>(it.key.removePrefix(persistTLogVersionKeys.begin),
+		                                               Unversioned())] =
+		    BinaryReader::fromStringRef<TLogVersion>(it.value, Unversioned());
+	}
+
 	state std::map<UID, Version> id_knownCommitted;
 	for (auto it : fKnownCommitted.get()) {
 		id_knownCommitted[BinaryReader::fromStringRef<UID>(it.key.removePrefix(persistKnownCommittedVersionKeys.begin),
@@ -3168,6 +3470,7 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 		                                 UID(),
 		                                 protocolVersion,
 		                                 logSpillType,
+		                                 id_logVersion[id1],
 		                                 std::vector<Tag>(),
 		                                 "Restored");
 		logData->locality = id_locality[id1];
@@ -3224,6 +3527,15 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 
 	state Future<Void> allRemoved = waitForAll(removed);
 	state UID lastId = UID(1, 1); // initialized so it will not compare equal to a default UID
+
+	// Time spent in each phase of the recovery, reported by TLogRestorePersistentStatePhases
+	state double persistentDataSeconds = timer_monotonic() - startTimer;
+	state double queueReadSeconds = 0;
+	state double commitMessagesSeconds = 0;
+	state double flushSeconds = 0;
+	state double phaseStart = 0;
+	state int64_t queueEntries = 0;
+	state int64_t queueBytes = 0;
 	state double recoverMemoryLimit = SERVER_KNOBS->TLOG_RECOVER_MEMORY_LIMIT;
 	if (BUGGIFY)
 		recoverMemoryLimit =
@@ -3238,8 +3550,12 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 				CODE_PROBE(true, "all tlogs removed during queue recovery");
 				throw worker_removed();
 			}
+			phaseStart = timer_monotonic();
 			choose {
 				when(TLogQueueEntry qe = wait(self->persistentQueue->readNext(self))) {
+					queueReadSeconds += timer_monotonic() - phaseStart;
+					queueEntries++;
+					queueBytes += qe.expectedSize();
 					if (qe.id != lastId) {
 						lastId = qe.id;
 						auto it = self->id_data.find(qe.id);
@@ -3261,9 +3577,11 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 						logData->knownCommittedVersion =
 						    std::max(logData->knownCommittedVersion, qe.knownCommittedVersion);
 						if (qe.version > logData->version.get()) {
+							double commitStart = timer_monotonic();
 							commitMessages(self, logData, qe.version, qe.arena(), qe.messages);
 							logData->version.set(qe.version);
 							logData->queueCommittedVersion.set(qe.version);
+							commitMessagesSeconds += timer_monotonic() - commitStart;
 
 							while (self->bytesInput - self->bytesDurable >= recoverMemoryLimit) {
 								CODE_PROBE(true, "Flush excess data during TLog queue recovery");
@@ -3274,10 +3592,12 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 								    .detail("Version", logData->version.get())
 								    .detail("PVer", logData->persistentDataVersion);
 
+								phaseStart = timer_monotonic();
 								choose {
 									when(wait(updateStorage(self))) {}
 									when(wait(allRemoved)) { throw worker_removed(); }
 								}
+								flushSeconds += timer_monotonic() - phaseStart;
 							}
 						} else {
 							// Updating persistRecoveryLocation and persistCurrentVersion at the same time,
@@ -3296,6 +3616,13 @@ ACTOR Future<Void> restorePersistentState(TLogData* self,
 	}
 
 	TraceEvent("TLogRestorePersistentStateDone", self->dbgid).detail("Took", now() - startt);
+	TraceEvent("TLogRestorePersistentStatePhases", self->dbgid)
+	    .detail("ReadPersistentData", persistentDataSeconds)
+	    .detail("ReadQueue", queueReadSeconds)
+	    .detail("CommitMessages", commitMessagesSeconds)
+	    .detail("FlushToPersistentData", flushSeconds)
+	    .detail("QueueEntries", queueEntries)
+	    .detail("QueueBytes", queueBytes);
 	CODE_PROBE(now() - startt >= 1.0, "TLog recovery took more than 1 second");
 
 	for (auto it : self->id_data) {
@@ -3429,6 +3756,7 @@ ACTOR Future<Void> tLogStart(TLogData* self, InitializeTLogRequest req, Locality
 	                                                          req.recruitmentID,
 	                                                          g_network->protocolVersion(),
 	                                                          req.spillType,
+	                                                          req.logVersion,
 	                                                          req.allTags,
 	                                                          recovering ? "Recovered" : "Recruited");
 	self->id_data[recruited.id()] = logData;
@@ -3739,3 +4067,169 @@ TEST_CASE("Lfdbserver/tlogserver/VersionMessagesOverheadFactor") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbserver/tlogserver/SpilledMessagesCompression") {
+	BinaryWriter wr(Unversioned());
+	for (int i = 0; i < 100; i++) {
+		wr << StringRef(std::string(deterministicRandom()->randomInt(1, 100), 'a' + i % 26));
+	}
+	Value messages = wr.toValue();
+
+	for (auto filter : CompressionUtils::supportedFilters) {
+		Value value = persistTagMessagesValue(messages, filter);
+		if (filter != CompressionFilter::NONE) {
+			ASSERT_LT(value.size(), messages.size());
+		}
+		Arena arena;
+		ASSERT(decodeTagMessagesValue(value, arena) == messages);
+	}
+	return Void();
+}
+
+TEST_CASE("/fdbserver/tlogserver/QueuePacketCompression") {
+	TLogQueueEntryRef qe;
+	Arena arena;
+	qe.id = deterministicRandom()->randomUniqueID();
+	qe.version = 100;
+	qe.knownCommittedVersion = 50;
+	qe.messages = StringRef(arena, std::string(std::max(SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_MIN_BYTES, 10000), 'm'));
+
+	// Decodes a packet the way recovery and spilled peeks read it back
+	auto decode = [](Standalone<StringRef> packet) {
+		const uint32_t length = *(uint32_t*)packet.begin();
+		ASSERT(sizeof(length) + length + sizeof(uint8_t) == packet.size());
+		Arena a = packet.arena();
+		StringRef payload =
+		    TLogQueue::decodePayload(packet.substr(sizeof(length), length), packet[sizeof(length) + length], a);
+		ArenaReader rd(a, payload, IncludeVersion());
+		TLogQueueEntry entry;
+		rd >> entry;
+		return entry;
+	};
+
+	const Standalone<StringRef> uncompressed = TLogQueue::encodePacket(qe, CompressionFilter::NONE);
+	ASSERT(uncompressed[uncompressed.size() - 1] == 1);
+	for (auto filter : CompressionUtils::supportedFilters) {
+		Standalone<StringRef> packet = TLogQueue::encodePacket(qe, filter);
+		if (filter != CompressionFilter::NONE) {
+			ASSERT_LT(packet.size(), uncompressed.size());
+			ASSERT(packet[packet.size() - 1] == TLogQueue::compressedPacketFlag);
+		}
+		TLogQueueEntry entry = decode(packet);
+		ASSERT(entry.id == qe.id);
+		ASSERT(entry.version == qe.version);
+		ASSERT(entry.knownCommittedVersion == qe.knownCommittedVersion);
+		ASSERT(entry.messages == qe.messages);
+	}
+
+	// Commits below TLOG_QUEUE_COMPRESSION_MIN_BYTES are written uncompressed
+	if (SERVER_KNOBS->TLOG_QUEUE_COMPRESSION_MIN_BYTES > 100) {
+		qe.messages = qe.messages.substr(0, 1);
+		Standalone<StringRef> packet = TLogQueue::encodePacket(qe, CompressionUtils::getRandomFilter());
+		ASSERT(packet[packet.size() - 1] == 1);
+		ASSERT(decode(packet).messages == qe.messages);
+	}
+	return Void();
+}
+
+TEST_CASE("/fdbserver/tlogserver/SpilledPeekCache") {
+	const int blockBytes = 1000;
+	auto block = [](Version end) {
+		const std::string messages(blockBytes, 'a' + end % 26);
+		return SpilledPeekCache::Block{ Standalone<StringRef>(StringRef(messages)), end };
+	};
+	SpilledPeekCache cache(3 * blockBytes);
+	const UID oldLog = deterministicRandom()->randomUniqueID();
+	const UID newLog = deterministicRandom()->randomUniqueID();
+	const Tag tag(0, 1);
+
+	ASSERT(!cache.get(oldLog, tag, 100).present());
+	cache.insert(oldLog, tag, 100, block(200));
+	Optional<SpilledPeekCache::Block> hit = cache.get(oldLog, tag, 100);
+	ASSERT(hit.present() && hit.get().end == 200 && hit.get().messages == block(200).messages);
+	ASSERT(!cache.get(oldLog, Tag(0, 2), 100).present());
+	ASSERT(!cache.get(oldLog, tag, 101).present());
+
+	// Another generation's log caches the same tag and version separately, out of the same budget
+	ASSERT(!cache.get(newLog, tag, 100).present());
+	cache.insert(newLog, tag, 100, block(300));
+	ASSERT_EQ(cache.get(newLog, tag, 100).get().end, 300);
+	ASSERT_EQ(cache.get(oldLog, tag, 100).get().end, 200);
+	ASSERT_EQ(cache.getBytes(), 2 * blockBytes);
+
+	// Going over the budget evicts the oldest block first
+	cache.insert(newLog, tag, 300, block(400));
+	cache.insert(newLog, tag, 400, block(500));
+	ASSERT_EQ(cache.getBytes(), 3 * blockBytes);
+	ASSERT(!cache.get(oldLog, tag, 100).present());
+	ASSERT_EQ(cache.get(newLog, tag, 100).get().end, 300);
+	ASSERT_EQ(cache.get(newLog, tag, 300).get().end, 400);
+	ASSERT_EQ(cache.get(newLog, tag, 400).get().end, 500);
+
+	// With TLOG_PEEK_CACHE_BYTES of 0 nothing is cached
+	SpilledPeekCache disabled(0);
+	disabled.insert(oldLog, tag, 100, block(200));
+	ASSERT(!disabled.get(oldLog, tag, 100).present());
+	ASSERT_EQ(disabled.getBytes(), 0);
+	return Void();
+}
+
+TEST_CASE("/fdbserver/tlogserver/PeekReplyCompression") {
+	const std::string messages(std::max(SERVER_KNOBS->PEEK_COMPRESSION_MIN_BYTES, 10000), 'm');
+	const Tag tag(0, 1);
+	auto peekReply = [&](Version begin) {
+		TLogPeekReply reply;
+		reply.messages = StringRef(reply.arena, messages);
+		reply.end = begin + 10;
+		return reply;
+	};
+
+	for (auto filter : CompressionUtils::supportedFilters) {
+		if (filter == CompressionFilter::NONE) {
+			continue;
+		}
+
+		// Size the cache to hold two compressed replies
+		TLogPeekReply reply = peekReply(0);
+		PeekReplyCompressionCache(0).compress(reply, tag, 0, filter);
+		ASSERT(reply.compressionFilter.present() && reply.compressionFilter.get() == filter);
+		ASSERT_LT(reply.messages.size(), messages.size());
+		PeekReplyCompressionCache cache(reply.messages.size() * 5 / 2);
+
+		auto compressed = [&](Version begin) {
+			TLogPeekReply reply = peekReply(begin);
+			cache.compress(reply, tag, begin, filter);
+			return reply;
+		};
+		auto shared = [](TLogPeekReply const& a, TLogPeekReply const& b) {
+			return a.messages.begin() == b.messages.begin();
+		};
+
+		// Peekers of the same range share one compressed copy until it is evicted, oldest first. The replies are kept
+		// alive so that an evicted copy's memory cannot be reused for its replacement.
+		TLogPeekReply first = compressed(0);
+		ASSERT(shared(compressed(0), first));
+		TLogPeekReply second = compressed(10);
+		TLogPeekReply third = compressed(20);
+		ASSERT(shared(compressed(10), second));
+		ASSERT(shared(compressed(20), third));
+		ASSERT(!shared(compressed(0), first));
+		ASSERT(shared(compressed(20), third));
+		ASSERT(!shared(compressed(10), second));
+
+		// The round trip restores the original messages
+		reply.decompress();
+		ASSERT(!reply.compressionFilter.present());
+		ASSERT(reply.messages == StringRef(messages));
+	}
+
+	// Replies below PEEK_COMPRESSION_MIN_BYTES are left uncompressed
+	if (SERVER_KNOBS->PEEK_COMPRESSION_MIN_BYTES > 0) {
+		TLogPeekReply reply;
+		reply.messages = StringRef(reply.arena, messages.substr(0, SERVER_KNOBS->PEEK_COMPRESSION_MIN_BYTES - 1));
+		reply.end = 10;
+		PeekReplyCompressionCache().compress(reply, tag, 0, CompressionUtils::getRandomFilter());
+		ASSERT(!reply.compressionFilter.present());
+	}
+	return Void();
+}
@@ -560,6 +560,7 @@ Future<Version> TagPartitionedLogSystem::push(Version prevVersion,
 					}
 				}
 				Standalone<StringRef> msg = data.getMessages(location);
+				VectorRef<TagMessagesRef> tagMessages = data.getTagMessages(location, msg.arena());
 				data.recordEmptyMessage(location, msg);
 				allReplies.push_back(recordPushMetrics(
 				    it->connectionResetTrackers[loc],
@@ -573,7 +574,8 @@ Future<Version> TagPartitionedLogSystem::push(Version prevVersion,
 				                                                                          minKnownCommittedVersion,
 				                                                                          msg,
 				                                                                          tLogCount[logGroupLocal],
-				                                                                          debugID),
+				                                                                          debugID,
+				                                                                          tagMessages),
 				                                                        TaskPriority::ProxyTLogCommitReply)));
 				Future<Void> commitSuccess = success(allReplies.back());
 				addActor.get().send(commitSuccess);
@@ -1475,7 +1475,9 @@ struct RedwoodMetrics {
 		unsigned int pagerCacheMiss;
 		unsigned int pagerProbeHit;
 		unsigned int pagerProbeMiss;
+		unsigned int pagerEvict;
 		unsigned int pagerEvictUnhit;
+		unsigned int pagerEvictSkip;
 		unsigned int pagerEvictFail;
 		unsigned int btreeLeafPreload;
 		unsigned int btreeLeafPreloadExt;
@@ -1647,19 +1649,23 @@ ACTOR Future<Void> redwoodMetricsLogger() {
 //   // Ready when object destruction is safe
 //   // Should cancel pending async operations that are safe to cancel when cache is being destroyed
 //   Future<Void> cancel() const;
+//
+// Entries are individually allocated and found through an open addressing hash index of entry pointers, and are
+// evicted with SIEVE: a hit only sets the entry's visited bit, and the evictor's hand sweeps the insertion order,
+// clearing visited bits and evicting the first unvisited entry it finds. This keeps a cache hit free of any list
+// manipulation, and keeps pages that are read repeatedly cached ahead of pages that were read once by a scan.
 template <class IndexType, class ObjectType>
 class ObjectCache : NonCopyable {
-	struct Entry;
-	typedef std::unordered_map<IndexType, Entry> CacheT;
-
-	struct Entry : public boost::intrusive::list_base_hook<> {
-		Entry() : hits(0), size(0) {}
+	struct Entry : public boost::intrusive::list_base_hook<>, FastAllocated<Entry> {
+		Entry() : hits(0), size(0), visited(false) {}
 		IndexType index;
 		ObjectType item;
 		int hits;
 		int size;
 		bool ownedByEvictor;
-		CacheT* pCache;
+		// Set on a hit, and cleared when the evictor's hand passes over the entry
+		bool visited;
+		ObjectCache* pCache;
 	};
 
 	typedef boost::intrusive::list<Entry> EvictionOrderT;
@@ -1689,26 +1695,28 @@ public:
 		// but the entry size is still counted against the evictor
 		void moveOut(Entry& e, EvictionOrderT& dest) {
 			ASSERT(e.ownedByEvictor);
+			passOver(e);
 			dest.splice(dest.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
 			e.ownedByEvictor = false;
 			++movedOutCount;
 		}
 
-		// Move an entry to the back of the eviction order if it is in the eviction order
-		void moveToBack(Entry& e) {
-			ASSERT(e.ownedByEvictor);
-			evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
-		}
-
 		// Move entire contents of an external eviction order containing entries whose size is part of
-		// this Evictor to the front of its eviction order.
+		// this Evictor to the position of the hand, so that they are the next entries considered for eviction.
 		void moveIn(EvictionOrderT& otherOrder) {
+			if (otherOrder.empty()) {
+				return;
+			}
 			for (auto& e : otherOrder) {
 				ASSERT(!e.ownedByEvictor);
 				e.ownedByEvictor = true;
+				e.visited = false;
 				--movedOutCount;
 			}
-			evictionOrder.splice(evictionOrder.begin(), otherOrder);
+			Entry* first = &otherOrder.front();
+			evictionOrder.splice(hand == nullptr ? evictionOrder.begin() : EvictionOrderT::s_iterator_to(*hand),
+			                     otherOrder);
+			hand = first;
 		}
 
 		// Add a new item to the back of the eviction order
@@ -1716,6 +1724,7 @@ public:
 			sizeUsed += e.size;
 			evictionOrder.push_back(e);
 			e.ownedByEvictor = true;
+			e.visited = false;
 		}
 
 		// Claim ownership of an entry, removing its size from the current size and removing it
@@ -1724,6 +1733,7 @@ public:
 			sizeUsed -= e.size;
 			// If e is in evictionOrder then remove it
 			if (e.ownedByEvictor) {
+				passOver(e);
 				evictionOrder.erase(EvictionOrderT::s_iterator_to(e));
 				e.ownedByEvictor = false;
 			} else {
@@ -1734,34 +1744,47 @@ public:
 
 		void trim(int additionalSpaceNeeded = 0) {
 			int attemptsLeft = FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
-			// While the cache is too big, evict the oldest entry until the oldest entry can't be evicted.
-			while (attemptsLeft-- > 0 && sizeUsed > (sizeLimit - reservedSize - additionalSpaceNeeded) &&
+			// While the cache is too big, move the hand until it finds an entry that has not been visited since it
+			// last passed, and evict it, or until it finds an entry that can't be evicted.
+			// Passing over visited entries does not count as an attempt, and is bounded because it clears them.
+			while (attemptsLeft > 0 && sizeUsed > (sizeLimit - reservedSize - additionalSpaceNeeded) &&
 			       !evictionOrder.empty()) {
-				Entry& toEvict = evictionOrder.front();
+				if (hand == nullptr) {
+					hand = &evictionOrder.front();
+				}
+				Entry& toEvict = *hand;
 
 				debug_printf("Evictor count=%d sizeUsed=%" PRId64 " sizeLimit=%" PRId64 " sizePenalty=%" PRId64
-				             " needed=%d  Trying to evict %s evictable %d\n",
+				             " needed=%d  Trying to evict %s evictable %d visited %d\n",
 				             (int)evictionOrder.size(),
 				             sizeUsed,
 				             sizeLimit,
 				             reservedSize,
 				             additionalSpaceNeeded,
 				             ::toString(toEvict.index).c_str(),
-				             toEvict.item.evictable());
-
-				if (!toEvict.item.evictable()) {
-					// shift the front to the back
-					evictionOrder.shift_forward(1);
+				             toEvict.item.evictable(),
+				             toEvict.visited);
+
+				if (toEvict.visited) {
+					toEvict.visited = false;
+					passOver(toEvict);
+					++g_redwoodMetrics.metric.pagerEvictSkip;
+				} else if (!toEvict.item.evictable()) {
+					// leave the entry behind the hand, to be reconsidered on its next pass
+					passOver(toEvict);
 					++g_redwoodMetrics.metric.pagerEvictFail;
 					break;
 				} else {
+					--attemptsLeft;
 					if (toEvict.hits == 0) {
 						++g_redwoodMetrics.metric.pagerEvictUnhit;
 					}
+					++g_redwoodMetrics.metric.pagerEvict;
 					sizeUsed -= toEvict.size;
 					debug_printf("Evicting %s\n", ::toString(toEvict.index).c_str());
-					evictionOrder.pop_front();
-					toEvict.pCache->erase(toEvict.index);
+					passOver(toEvict);
+					evictionOrder.erase(EvictionOrderT::s_iterator_to(toEvict));
+					toEvict.pCache->erase(toEvict);
 				}
 			}
 		}
@@ -1782,10 +1805,12 @@ public:
 			                       reservedSize,
 			                       movedOutCount);
 			for (auto& entry : evictionOrder) {
-				s += format("\n\tindex %s  size %d  evictable %d\n",
+				s += format("\n\tindex %s  size %d  evictable %d  visited %d%s\n",
 				            ::toString(entry.index).c_str(),
 				            entry.size,
-				            entry.item.evictable());
+				            entry.item.evictable(),
+				            entry.visited,
+				            &entry == hand ? "  <- hand" : "");
 			}
 			s += "}\n";
 			return s;
@@ -1797,7 +1822,18 @@ public:
 		int64_t sizeLimit;
 
 	private:
+		// Advances the hand past e, if the hand is at e. Must be called before e leaves the eviction order.
+		void passOver(Entry& e) {
+			if (hand == &e) {
+				auto i = std::next(EvictionOrderT::s_iterator_to(e));
+				hand = i == evictionOrder.end() ? nullptr : &*i;
+			}
+		}
+
+		// Oldest entries are at the front. The hand moves from front to back and wraps around, and a null hand is
+		// at the front.
 		EvictionOrderT evictionOrder;
+		Entry* hand = nullptr;
 		// Size of all entries in the eviction order or held in external eviction orders
 		int64_t sizeUsed = 0;
 		// Number of items that have been moveOut()'d to other evictionOrders and aren't back yet
@@ -1808,83 +1844,106 @@ public:
 		if (pEvictor == nullptr) {
 			pEvictor = Evictor::getEvictor();
 		}
+		resize(minSlots);
+	}
+
+	~ObjectCache() {
+		for (Entry* e : slots) {
+			delete e;
+		}
 	}
 
 	Evictor& evictor() const { return *pEvictor; }
 
-	int64_t getCount() const { return cache.size(); }
+	int64_t getCount() const { return count; }
 
-	void reserveCount(int count) { cache.reserve(count); }
+	void reserveCount(int count) {
+		size_t n = slots.size();
+		while (n * maxLoadFactorNum < count * maxLoadFactorDen) {
+			n *= 2;
+		}
+		if (n > slots.size()) {
+			rehash(n);
+		}
+	}
 
 	// Get the object for i if it exists, else return nullptr.
 	// If the object exists, its eviction order will NOT change as this is not a cache hit.
 	ObjectType* getIfExists(const IndexType& index) {
-		auto i = cache.find(index);
-		if (i != cache.end()) {
-			++i->second.hits;
-			return &i->second.item;
+		Entry* e = slots[findSlot(index)];
+		if (e != nullptr) {
+			++e->hits;
+			return &e->item;
 		}
 		return nullptr;
 	}
 
 	// If index is in cache and not on the prioritized eviction order list, move it there.
 	void prioritizeEviction(const IndexType& index) {
-		auto i = cache.find(index);
-		if (i != cache.end() && i->second.ownedByEvictor) {
-			pEvictor->moveOut(i->second, prioritizedEvictions);
+		Entry* e = slots[findSlot(index)];
+		if (e != nullptr && e->ownedByEvictor) {
+			pEvictor->moveOut(*e, prioritizedEvictions);
 		}
 	}
 
 	// Get the object for i or create a new one.
-	// After a get(), the object for i is the last in evictionOrder.
+	// After a get(), the object for i is marked visited, so the evictor's hand will pass over it once.
 	// If noHit is set, do not consider this access to be cache hit if the object is present
 	// If noMiss is set, do not consider this access to be a cache miss if the object is not present
 	ObjectType& get(const IndexType& index, int size, bool noHit = false) {
-		Entry& entry = cache[index];
+		Entry* e = slots[findSlot(index)];
 
-		// If entry is linked into an evictionOrder
-		if (entry.is_linked()) {
+		if (e != nullptr) {
 			// If this access is meant to be a hit
 			if (!noHit) {
-				++entry.hits;
-				// If item eviction is not prioritized, move to end of eviction order
-				if (entry.ownedByEvictor) {
-					pEvictor->moveToBack(entry);
-				}
+				++e->hits;
+				e->visited = true;
 			}
 		} else {
 			// Otherwise it was a cache miss
+			e = new Entry();
+			e->index = index;
+			e->pCache = this;
+			e->size = size;
 
-			// Finish initializing entry
-			entry.index = index;
-			entry.pCache = &cache;
-			entry.hits = 0;
-			entry.size = size;
-
-			pEvictor->trim(entry.size);
-			pEvictor->addNew(entry);
+			// Trimming can erase other entries and move slots, so the new entry's slot is found afterward
+			pEvictor->trim(e->size);
+			insert(e);
+			pEvictor->addNew(*e);
 		}
 
-		return entry.item;
+		return e->item;
 	}
 
 	// Clears the cache, saving the entries to second cache, then waits for each item to be evictable and evicts it.
 	ACTOR static Future<Void> clear_impl(ObjectCache* self, bool waitForSafeEviction) {
 		// Claim ownership of all of our cached items, removing them from the evictor's control and quota.
-		for (auto& ie : self->cache) {
-			self->pEvictor->reclaim(ie.second);
+		for (Entry* e : self->slots) {
+			if (e != nullptr) {
+				self->pEvictor->reclaim(*e);
+			}
 		}
 
 		// All items are in the cache so we don't need the prioritized eviction order anymore, and the cache is about
 		// to be destroyed so the prioritizedEvictions head/tail will become invalid.
 		self->prioritizedEvictions.clear();
 
-		state typename CacheT::iterator i = self->cache.begin();
-		while (i != self->cache.end()) {
-			wait(waitForSafeEviction ? i->second.item.onEvictable() : i->second.item.cancel());
-			++i;
+		state std::vector<Entry*> entries;
+		entries.reserve(self->count);
+		for (Entry* e : self->slots) {
+			if (e != nullptr) {
+				entries.push_back(e);
+			}
+		}
+		self->resize(minSlots);
+
+		state int i = 0;
+		for (; i < entries.size(); ++i) {
+			wait(waitForSafeEviction ? entries[i]->item.onEvictable() : entries[i]->item.cancel());
+		}
+		for (Entry* e : entries) {
+			delete e;
 		}
-		self->cache.clear();
 
 		return Void();
 	}
@@ -1895,8 +1954,86 @@ public:
 	void flushPrioritizedEvictions() { pEvictor->moveIn(prioritizedEvictions); }
 
 private:
+	// The index is a linear probing hash table of entry pointers, kept at most 3/4 full
+	static constexpr size_t minSlots = 16;
+	static constexpr size_t maxLoadFactorNum = 3;
+	static constexpr size_t maxLoadFactorDen = 4;
+
+	size_t home(const IndexType& index) const {
+		// Fibonacci hashing, so that sequential page IDs are spread across the table
+		return (uint64_t(std::hash<IndexType>()(index)) * 0x9E3779B97F4A7C15ULL) >> hashShift;
+	}
+
+	// Returns the slot holding index, or the empty slot where it would be inserted
+	size_t findSlot(const IndexType& index) const {
+		const size_t mask = slots.size() - 1;
+		size_t i = home(index);
+		while (slots[i] != nullptr && !(slots[i]->index == index)) {
+			i = (i + 1) & mask;
+		}
+		return i;
+	}
+
+	void insert(Entry* e) {
+		if ((count + 1) * maxLoadFactorDen > slots.size() * maxLoadFactorNum) {
+			rehash(slots.size() * 2);
+		}
+		size_t i = findSlot(e->index);
+		ASSERT(slots[i] == nullptr);
+		slots[i] = e;
+		++count;
+	}
+
+	// Removes an evicted entry from the index and destroys it
+	void erase(Entry& e) {
+		const size_t mask = slots.size() - 1;
+		size_t i = findSlot(e.index);
+		ASSERT(slots[i] == &e);
+		// Shift later entries of the probe sequence back, so that lookups never need to skip over deleted slots
+		size_t j = i;
+		while (true) {
+			j = (j + 1) & mask;
+			if (slots[j] == nullptr) {
+				break;
+			}
+			size_t k = home(slots[j]->index);
+			// slots[j] can move to i only if its home is not cyclically within (i, j]
+			if (i <= j ? (k <= i || k > j) : (k <= i && k > j)) {
+				slots[i] = slots[j];
+				i = j;
+			}
+		}
+		slots[i] = nullptr;
+		--count;
+		delete &e;
+	}
+
+	// Replaces the index with an empty one of n slots, which must be a power of 2
+	void resize(size_t n) {
+		ASSERT(n >= minSlots && (n & (n - 1)) == 0);
+		slots.assign(n, nullptr);
+		hashShift = 64 - __builtin_ctzll(n);
+		count = 0;
+	}
+
+	// Moves the entries into a new index of n slots
+	void rehash(size_t n) {
+		std::vector<Entry*> old;
+		old.swap(slots);
+		int64_t oldCount = count;
+		resize(n);
+		for (Entry* e : old) {
+			if (e != nullptr) {
+				slots[findSlot(e->index)] = e;
+			}
+		}
+		count = oldCount;
+	}
+
 	Evictor* pEvictor;
-	CacheT cache;
+	std::vector<Entry*> slots;
+	int hashShift;
+	int64_t count;
 	EvictionOrderT prioritizedEvictions;
 };
 
@@ -7611,6 +7748,23 @@ public:
 		bool valid;
 		std::vector<PathEntry> path;
 
+		// State of readAhead() during a range scan
+		struct ReadAheadState {
+			Reference<const ArenaPage> parent;
+			// Link to the last sibling considered for reading ahead
+			BTreePage::BinaryTree::Cursor cursor;
+			// Number of siblings read ahead of the cursor's leaf
+			int pages = 0;
+			// Whether the siblings under parent or in the scan's range have run out
+			bool done = false;
+			// Leaves visited by the scan, with their total records and kv bytes
+			int leaves = 0;
+			int64_t records = 0;
+			int64_t kvBytes = 0;
+			int depth = 0;
+		};
+		ReadAheadState readAheadState;
+
 	public:
 		BTreeCursor() : reason(PagerEventReasons::MAXEVENTREASONS) {}
 
@@ -7722,6 +7876,7 @@ public:
 			path.clear();
 			path.reserve(6);
 			valid = false;
+			readAheadState = ReadAheadState();
 			return root.empty() ? Void() : pushPage(root);
 		}
 
@@ -7734,9 +7889,20 @@ public:
 		//     If there is a record in the tree > query then moveNext() will move to it.
 		// If non-zero is returned then the cursor is valid and the return value is logically equivalent
 		// to query.compare(cursor.get())
-		ACTOR Future<int> seek_impl(BTreeCursor* self, RedwoodRecordRef query) {
+		ACTOR Future<int> seek_impl(BTreeCursor* self, RedwoodRecordRef query, bool fromPath) {
 			state RedwoodRecordRef internalPageQuery = query.withMaxPageID();
-			self->path.resize(1);
+			if (fromPath) {
+				// Keep the pages of the current path whose boundaries contain query
+				while (self->path.size() > 1) {
+					const auto& cache = self->path.back().cursor.cache;
+					if (!(query.key < cache->lowerBound.key) && query.key < cache->upperBound.key) {
+						break;
+					}
+					self->path.pop_back();
+				}
+			} else {
+				self->path.resize(1);
+			}
 			debug_printf("seek(%s) start cursor = %s\n", query.toString().c_str(), self->toString().c_str());
 
 			loop {
@@ -7769,18 +7935,22 @@ public:
 			}
 		}
 
-		Future<int> seek(RedwoodRecordRef query) { return path.empty() ? 0 : seek_impl(this, query); }
+		Future<int> seek(RedwoodRecordRef query) { return path.empty() ? 0 : seek_impl(this, query, false); }
 
-		ACTOR Future<Void> seekGTE_impl(BTreeCursor* self, RedwoodRecordRef query) {
+		ACTOR Future<Void> seekGTE_impl(BTreeCursor* self, RedwoodRecordRef query, bool fromPath) {
 			debug_printf("seekGTE(%s) start\n", query.toString().c_str());
-			int cmp = wait(self->seek(query));
+			int cmp = wait(self->path.empty() ? Future<int>(0) : self->seek_impl(self, query, fromPath));
 			if (cmp > 0 || (cmp == 0 && !self->isValid())) {
 				wait(self->moveNext());
 			}
 			return Void();
 		}
 
-		Future<Void> seekGTE(RedwoodRecordRef query) { return seekGTE_impl(this, query); }
+		Future<Void> seekGTE(RedwoodRecordRef query) { return seekGTE_impl(this, query, false); }
+
+		// Like seekGTE(), but starts from the deepest page of the cursor's current path which could contain query
+		// instead of from the root, so seeking to a series of nearby keys reads their common pages only once
+		Future<Void> seekGTEFromPath(RedwoodRecordRef query) { return seekGTE_impl(this, query, true); }
 
 		// Start fetching sibling nodes in the forward or backward direction, stopping after recordLimit or byteLimit
 		void prefetch(KeyRef rangeEnd, bool directionForward, int recordLimit, int byteLimit) {
@@ -7838,6 +8008,73 @@ public:
 			}
 		}
 
+		// For range scans, reads sibling leaves ahead of the cursor's leaf in the forward or backward direction, and
+		// should be called each time the scan moves to a new leaf with the records and bytes the scan has left.
+		// The number of leaves read ahead starts at REDWOOD_RANGE_READ_AHEAD_MIN_PAGES and doubles with each leaf the
+		// scan moves to, up to REDWOOD_RANGE_READ_AHEAD_MAX_PAGES, so that a long scan keeps many reads in flight but
+		// a short one does not read pages it won't use. It is also limited to the number of leaves the scan's limits
+		// are expected to need, estimated from the leaves it has visited so far.
+		// As with prefetch(), only siblings under the same parent are read ahead.
+		void readAhead(KeyRef rangeEnd, bool directionForward, int recordsLeft, int bytesLeft) {
+			if (path.size() < 2) {
+				return;
+			}
+
+			ReadAheadState& ra = readAheadState;
+			const PathEntry& parent = path[path.size() - 2];
+			ASSERT(parent.btPage()->height == 2);
+			if (ra.parent != parent.page) {
+				ra.parent = parent.page;
+				ra.cursor = parent.cursor;
+				ra.pages = 0;
+				ra.done = false;
+			} else if (ra.pages > 0) {
+				// The scan has moved to the first of the siblings read ahead
+				--ra.pages;
+			} else {
+				ra.cursor = parent.cursor;
+			}
+
+			ra.depth = ra.leaves == 0 ? SERVER_KNOBS->REDWOOD_RANGE_READ_AHEAD_MIN_PAGES
+			                          : std::min(std::max(ra.depth * 2, 1), SERVER_KNOBS->REDWOOD_RANGE_READ_AHEAD_MAX_PAGES);
+			const BTreePage* leaf = path.back().btPage();
+			++ra.leaves;
+			ra.records += leaf->tree()->numItems;
+			ra.kvBytes += leaf->kvBytes;
+
+			int64_t recordsPerLeaf = std::max<int64_t>(ra.records / ra.leaves, 1);
+			int64_t bytesPerLeaf = std::max<int64_t>(ra.kvBytes / ra.leaves, 1);
+			int64_t leavesNeeded = std::min((recordsLeft + recordsPerLeaf - 1) / recordsPerLeaf,
+			                                (bytesLeft + bytesPerLeaf - 1) / bytesPerLeaf);
+			int target = std::min<int64_t>(ra.depth, leavesNeeded);
+
+			while (!ra.done && ra.pages < target) {
+				if (directionForward) {
+					// Stop if there is no right sibling or its lower boundary is at or after the range end
+					if (!ra.cursor.moveNext() || ra.cursor.get().key >= rangeEnd) {
+						ra.done = true;
+						break;
+					}
+				} else {
+					// Stop if the last sibling's lower boundary is at or before the range end, or there is no left
+					// sibling
+					if (ra.cursor.get().key <= rangeEnd || !ra.cursor.movePrev()) {
+						ra.done = true;
+						break;
+					}
+				}
+
+				// Null links are skipped by the scan, so they are not counted
+				if (ra.cursor.get().value.present()) {
+					BTreeNodeLinkRef childPage = ra.cursor.get().getChildPage();
+					if (childPage.size() > 0) {
+						preLoadPage(pager.getPtr(), childPage, ioLeafPriority);
+						++ra.pages;
+					}
+				}
+			}
+		}
+
 		ACTOR Future<Void> seekLT_impl(BTreeCursor* self, RedwoodRecordRef query) {
 			debug_printf("seekLT(%s) start\n", query.toString().c_str());
 			int cmp = wait(self->seek(query));
@@ -8116,11 +8353,11 @@ public:
 				wait(f);
 			}
 
-			if (self->prefetch) {
-				cur.prefetch(keys.end, true, rowLimit, byteLimit);
-			}
-
 			while (cur.isValid()) {
+				if (self->prefetch) {
+					cur.readAhead(keys.end, true, rowLimit, byteLimit - accumulatedBytes);
+				}
+
 				// Read leaf page contents without using waits by using the leaf page cursor directly
 				// and advancing it until it is no longer valid
 				BTreePage::BinaryTree::Cursor& leafCursor = cur.back().cursor;
@@ -8171,11 +8408,11 @@ public:
 				wait(f);
 			}
 
-			if (self->prefetch) {
-				cur.prefetch(keys.begin, false, -rowLimit, byteLimit);
-			}
-
 			while (cur.isValid()) {
+				if (self->prefetch) {
+					cur.readAhead(keys.begin, false, -rowLimit, byteLimit - accumulatedBytes);
+				}
+
 				// Read leaf page contents without using waits by using the leaf page cursor directly
 				// and advancing it until it is no longer valid
 				BTreePage::BinaryTree::Cursor& leafCursor = cur.back().cursor;
@@ -8252,6 +8489,40 @@ public:
 		return catchError(readValue_impl(this, key, options));
 	}
 
+	// Seeks to each key from the path of the previous one, so that sorted keys share the pages above them
+	ACTOR static Future<std::vector<Optional<Value>>> readValues_impl(KeyValueStoreRedwood* self,
+	                                                                  Standalone<VectorRef<KeyRef>> keys,
+	                                                                  Optional<ReadOptions> options) {
+		state VersionedBTree::BTreeCursor cur;
+		wait(self->m_tree->initBTreeCursor(
+		    &cur, self->m_tree->getLastCommittedVersion(), PagerEventReasons::PointRead, options));
+
+		state std::vector<Optional<Value>> results;
+		results.reserve(keys.size());
+		state int i = 0;
+		for (; i < keys.size(); ++i) {
+			++g_redwoodMetrics.metric.opGet;
+			wait(cur.seekGTEFromPath(keys[i]));
+			if (cur.isValid() && cur.get().key == keys[i]) {
+				// Return a Value whose arena depends on the source page arena
+				Value v;
+				v.arena().dependsOn(cur.back().page->getArena());
+				v.contents() = cur.get().value.get();
+				g_redwoodMetrics.kvSizeReadByGet->sample(cur.get().kvBytes());
+				results.push_back(v);
+			} else {
+				results.push_back(Optional<Value>());
+			}
+		}
+
+		return results;
+	}
+
+	Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                Optional<ReadOptions> options) override {
+		return catchError(readValues_impl(this, keys, options));
+	}
+
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
 		return catchError(map(readValue_impl(this, key, options), [maxLength](Optional<Value> v) {
 			if (v.present() && v.get().size() > maxLength) {
@@ -8514,6 +8785,8 @@ ACTOR Future<Void> seekAllBTreeCursor(VersionedBTree* btree,
 	state std::map<std::pair<std::string, Version>, Optional<std::string>>::const_iterator i = written->cbegin();
 	state std::map<std::pair<std::string, Version>, Optional<std::string>>::const_iterator iEnd = written->cend();
 	state VersionedBTree::BTreeCursor cur;
+	// Keys are visited in order, so seeks can start from the previous key's path
+	state bool seekFromPath = deterministicRandom()->coinflip();
 
 	wait(btree->initBTreeCursor(&cur, v, PagerEventReasons::RangeRead));
 
@@ -8526,7 +8799,8 @@ ACTOR Future<Void> seekAllBTreeCursor(VersionedBTree* btree,
 			state Optional<std::string> val = i->second;
 			debug_printf("Verifying @%" PRId64 " '%s'\n", ver, key.c_str());
 			state Arena arena;
-			wait(cur.seekGTE(RedwoodRecordRef(KeyRef(arena, key))));
+			RedwoodRecordRef query(KeyRef(arena, key));
+			wait(seekFromPath ? cur.seekGTEFromPath(query) : cur.seekGTE(query));
 			bool foundKey = cur.isValid() && cur.get().key == key;
 			bool hasValue = foundKey && cur.get().value.present();
 
@@ -8798,7 +9072,9 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		                                               { "", 0 },
 		                                               { "PagerProbeHit", metric.pagerProbeHit },
 		                                               { "PagerProbeMiss", metric.pagerProbeMiss },
+		                                               { "PagerEvict", metric.pagerEvict },
 		                                               { "PagerEvictUnhit", metric.pagerEvictUnhit },
+		                                               { "PagerEvictSkip", metric.pagerEvictSkip },
 		                                               { "PagerEvictFail", metric.pagerEvictFail },
 		                                               { "", 0 },
 		                                               { "PagerRemapFree", metric.pagerRemapFree },
@@ -10024,6 +10300,98 @@ TEST_CASE(":/redwood/pager/ArenaPage") {
 	return Void();
 }
 
+namespace {
+struct TestCacheObject {
+	int key = -1;
+	bool pinned = false;
+
+	bool evictable() const { return !pinned; }
+	Future<Void> onEvictable() const { return Void(); }
+	Future<Void> cancel() const { return Void(); }
+};
+typedef ObjectCache<int, TestCacheObject> TestObjectCache;
+} // namespace
+
+TEST_CASE("/redwood/correctness/unit/ObjectCache") {
+	state TestObjectCache::Evictor evictor(10);
+	state TestObjectCache cache(&evictor);
+
+	// A hit saves an entry from the next pass of the hand
+	for (int i = 0; i < 10; ++i) {
+		cache.get(i, 1).key = i;
+	}
+	cache.get(0, 1);
+	cache.get(10, 1).key = 10;
+	ASSERT(cache.getIfExists(0) != nullptr);
+	ASSERT(cache.getIfExists(1) == nullptr);
+
+	// Prioritized evictions are the next to go, even if they were hit
+	cache.get(5, 1);
+	cache.prioritizeEviction(5);
+	cache.flushPrioritizedEvictions();
+	cache.get(11, 1).key = 11;
+	ASSERT(cache.getIfExists(5) == nullptr);
+	wait(cache.clear());
+	ASSERT(evictor.empty());
+
+	// Random operations, checking the index against the evictor's accounting
+	evictor.sizeLimit = deterministicRandom()->randomInt(50, 500);
+	state int keys = deterministicRandom()->randomInt(100, 5000);
+	state std::vector<int> pinned;
+	state int i = 0;
+	for (; i < 20000; ++i) {
+		int k = deterministicRandom()->randomInt(0, keys);
+		int r = deterministicRandom()->randomInt(0, 100);
+		if (r < 80) {
+			TestCacheObject& o = cache.get(k, 1 + k % 3, deterministicRandom()->coinflip());
+			ASSERT(o.key == k || o.key == -1);
+			o.key = k;
+			if (deterministicRandom()->random01() < 0.01) {
+				o.pinned = true;
+				pinned.push_back(k);
+			}
+		} else if (r < 90) {
+			cache.prioritizeEviction(k);
+		} else if (r < 95) {
+			cache.flushPrioritizedEvictions();
+		} else if (!pinned.empty()) {
+			TestCacheObject* o = cache.getIfExists(pinned.back());
+			ASSERT(o != nullptr);
+			o->pinned = false;
+			pinned.pop_back();
+		}
+
+		if (i % 1000 == 0 || i == 19999) {
+			int64_t count = 0;
+			int64_t size = 0;
+			for (int k = 0; k < keys; ++k) {
+				TestCacheObject* o = cache.getIfExists(k);
+				if (o != nullptr) {
+					ASSERT(o->key == k);
+					++count;
+					size += 1 + k % 3;
+				}
+			}
+			ASSERT_EQ(count, cache.getCount());
+			ASSERT_EQ(count, evictor.getCountUsed());
+			ASSERT_EQ(size, evictor.getSizeUsed());
+		}
+	}
+
+	for (int k : pinned) {
+		cache.getIfExists(k)->pinned = false;
+	}
+	cache.flushPrioritizedEvictions();
+	evictor.trim();
+	ASSERT(evictor.getSizeUsed() <= evictor.sizeLimit);
+
+	wait(cache.clear());
+	ASSERT(evictor.empty());
+	ASSERT_EQ(cache.getCount(), 0);
+
+	return Void();
+}
+
 TEST_CASE("Lredwood/correctness/btree") {
 	g_redwoodMetricsActor = Void(); // Prevent trace event metrics from starting
 	g_redwoodMetrics.clear();
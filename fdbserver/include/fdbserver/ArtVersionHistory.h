@@ -0,0 +1,64 @@
+/*
+ * ArtVersionHistory.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_ARTVERSIONHISTORY_H
+#define FDBSERVER_ARTVERSIONHISTORY_H
+#pragma once
+
+#include "fdbclient/FDBTypes.h"
+#include "flow/Arena.h"
+
+// The write history of a conflict set, kept in an adaptive radix tree instead of the skip list in SkipList.cpp.
+//
+// As with the skip list, the history is a set of boundary keys. Each boundary holds the last version at which the
+// keys from it up to the next boundary were written, and the empty key is always a boundary. Every tree node also
+// keeps the max version of its subtree, so a read conflict range is checked by descending only along the paths of
+// its two ends. Path compression keeps the long prefixes shared by tenant and tuple encoded keys in a single node.
+//
+// Unlike art_tree (see art.h), nodes are individually allocated and freed, since the history lives as long as the
+// resolver.
+class ArtVersionHistory : NonCopyable {
+public:
+	struct Node;
+
+	explicit ArtVersionHistory(Version version = 0);
+	~ArtVersionHistory();
+
+	void swap(ArtVersionHistory& other) { std::swap(root, other.root); }
+
+	// Returns true if some key in [begin, end) was written at a version greater than the given one
+	bool detectConflict(const StringRef& begin, const StringRef& end, Version version) const;
+
+	// Records a write of [begin, end) at version, which must not be older than any version in the history
+	void addConflictRange(const StringRef& begin, const StringRef& end, Version version);
+
+	// Visits at most nodeCount boundaries, starting at removalKey, and removes each one that is older than version and
+	// follows another such boundary, so that its keys join the preceding range. removalKey is set to the first
+	// boundary not visited, or to the empty key once the end is reached. Returns the number of boundaries removed.
+	int removeBefore(Version version, Key& removalKey, int nodeCount);
+
+	// Returns the number of boundaries
+	int count() const;
+
+private:
+	Node* root;
+};
+
+#endif
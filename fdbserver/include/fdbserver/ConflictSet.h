@@ -28,7 +28,11 @@
 #include "fdbclient/CommitTransaction.h"
 
 struct ConflictSet;
-ConflictSet* newConflictSet();
+// When threadCount > 1, batches with at least minParallelRanges read or write conflict ranges are resolved by
+// splitting the conflict set into threadCount key-range partitions which are processed concurrently.
+// With useArt, the history is kept in an adaptive radix tree (see ArtVersionHistory.h) and batches are resolved on
+// a single thread.
+ConflictSet* newConflictSet(int threadCount = 1, int minParallelRanges = 0, bool useArt = false);
 void clearConflictSet(ConflictSet*, Version);
 void destroyConflictSet(ConflictSet*);
 
@@ -67,7 +71,9 @@ private:
 	void checkIntraBatchConflicts();
 	void combineWriteConflictRanges();
 	void checkReadConflictRanges();
+	void checkReadConflictRangesParallel();
 	void mergeWriteConflictRanges(Version now);
+	void mergeWriteConflictRangesParallel(Version now);
 	void addConflictRanges(Version now,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -0,0 +1,72 @@
+/*
+ * FifoCache.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_FIFOCACHE_H
+#define FDBSERVER_FIFOCACHE_H
+#pragma once
+
+#include <map>
+#include <utility>
+
+#include "flow/Arena.h"
+#include "flow/Deque.h"
+
+// Caches values which never change once inserted, such as the replies peekers of the same tag and version range all
+// receive. The cache holds at most capacityBytes, as given by the size of each insert, and evicts its oldest entries
+// first. A cache with no capacity holds nothing.
+template <class K, class V>
+class FifoCache {
+public:
+	explicit FifoCache(int64_t capacityBytes) : capacityBytes(capacityBytes) {}
+
+	Optional<V> get(K const& key) const {
+		auto it = entries.find(key);
+		if (it == entries.end()) {
+			return Optional<V>();
+		}
+		return it->second.first;
+	}
+
+	// Does nothing if key is already cached or value alone is over capacity
+	void insert(K const& key, V const& value, int64_t size) {
+		if (size > capacityBytes || entries.count(key)) {
+			return;
+		}
+		entries.emplace(key, std::make_pair(value, size));
+		insertionOrder.push_back(key);
+		bytes += size;
+		while (bytes > capacityBytes) {
+			auto oldest = entries.find(insertionOrder.front());
+			bytes -= oldest->second.second;
+			entries.erase(oldest);
+			insertionOrder.pop_front();
+		}
+	}
+
+	int64_t getBytes() const { return bytes; }
+
+private:
+	std::map<K, std::pair<V, int64_t>> entries; // Each value and its size
+	Deque<K> insertionOrder; // Oldest entry first
+	int64_t capacityBytes;
+	int64_t bytes = 0;
+};
+
+#endif
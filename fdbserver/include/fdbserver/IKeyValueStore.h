@@ -67,6 +67,18 @@ public:
 	                                                int maxLength,
 	                                                Optional<ReadOptions> options = Optional<ReadOptions>()) = 0;
 
+	// Reads the values of keys, returning them in the same order. Stores which can share work between nearby keys,
+	// such as the descent of a tree, do so when keys are sorted.
+	virtual Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                        Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		std::vector<Future<Optional<Value>>> reads;
+		reads.reserve(keys.size());
+		for (const KeyRef& key : keys) {
+			reads.push_back(readValue(key, options));
+		}
+		return getAll(reads);
+	}
+
 	// If rowLimit>=0, reads first rows sorted ascending, otherwise reads last rows sorted descending
 	// The total size of the returned value (less the last entry) will be less than byteLimit
 	virtual Future<RangeResult> readRange(KeyRangeRef keys,
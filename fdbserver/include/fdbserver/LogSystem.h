@@ -226,6 +226,13 @@ struct ILogSystem {
 		int fastReplies;
 		int unknownReplies;
 
+		// The version and offset within results.messages of each message in results, built once advanceTo() has to
+		// skip more than one message so that it can binary search instead of parsing every message it skips.
+		std::vector<std::pair<LogMessageVersion, int>> messageIndex;
+		bool messageIndexValid; // messageIndex describes results
+		bool messageIndexSorted; // messageIndex is in version order, which binary searching it relies on
+		bool messageIndexReachedEnd; // results reaches end after the messages in messageIndex
+
 		ServerPeekCursor(Reference<AsyncVar<OptionalInterface<TLogInterface>>> const& interf,
 		                 Tag tag,
 		                 Version begin,
@@ -260,6 +267,11 @@ struct ILogSystem {
 		Optional<UID> getPrimaryPeekLocation() const override;
 		Optional<UID> getCurrentPeekLocation() const override;
 
+		void buildMessageIndex();
+		// Moves to the first message at or after n using messageIndex. Returns false if the messages in results are not
+		// in version order, in which case the cursor has to move through them one by one.
+		bool seekMessage(LogMessageVersion n);
+
 		void addref() override { ReferenceCounted<ServerPeekCursor>::addref(); }
 
 		void delref() override { ReferenceCounted<ServerPeekCursor>::delref(); }
@@ -793,6 +805,10 @@ struct LogPushData : NonCopyable {
 
 	Standalone<StringRef> getMessages(int loc) const { return messagesWriter[loc].toValue(); }
 
+	// Returns the offsets within getMessages(loc) of the messages of each tag, allocated in arena. Empty unless
+	// PUSH_TAG_MESSAGE_INDEX was set when this was created.
+	VectorRef<TagMessagesRef> getTagMessages(int loc, Arena& arena) const;
+
 	// Returns all locations' messages, including empty ones.
 	std::vector<Standalone<StringRef>> getAllMessages() const;
 
@@ -819,6 +835,9 @@ private:
 	std::vector<BinaryWriter> messagesWriter;
 	std::vector<bool> messagesWritten; // if messagesWriter has written anything
 	std::vector<int> msg_locations;
+	bool indexTags;
+	// For each location, the offset of every message written there once for each of its tags, if indexTags
+	std::vector<std::vector<std::pair<Tag, int>>> tagMessageOffsets;
 	// Stores message locations that have had span information written to them
 	// for the current transaction. Adding transaction info will reset this
 	// field.
@@ -832,6 +851,15 @@ private:
 	// true on a successful write, and false if the location has already been
 	// written.
 	bool writeTransactionInfo(int location, uint32_t subseq);
+
+	// Records that the message at offset of the given location has prev_tags as its tags
+	void recordTags(int location, int offset) {
+		if (indexTags) {
+			for (auto& tag : prev_tags) {
+				tagMessageOffsets[location].emplace_back(tag, offset);
+			}
+		}
+	}
 };
 
 template <class T>
@@ -880,6 +908,7 @@ void LogPushData::writeTypedMessage(T const& item, bool metadataMessage, bool al
 	for (int loc : msg_locations) {
 		BinaryWriter& wr = messagesWriter[loc];
 
+		recordTags(loc, wr.getLength());
 		if (first) {
 			firstOffset = wr.getLength();
 			wr << uint32_t(0) << subseq << uint16_t(prev_tags.size());
@@ -0,0 +1,72 @@
+/*
+ * PeekReplyCompressionCache.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBSERVER_PEEKREPLYCOMPRESSIONCACHE_H
+#define FDBSERVER_PEEKREPLYCOMPRESSIONCACHE_H
+#pragma once
+
+#include <tuple>
+
+#include "fdbserver/FifoCache.h"
+#include "fdbserver/Knobs.h"
+#include "fdbserver/TLogInterface.h"
+#include "flow/CompressionUtils.h"
+
+// Compresses peek replies for peekers which asked for it. The messages a TLog or log router returns for a tag and
+// version range never change, so every peeker of the same range (the replicas of a storage team, a log router and its
+// backups) shares one compressed copy instead of paying for the compression again.
+class PeekReplyCompressionCache {
+public:
+	explicit PeekReplyCompressionCache(int64_t capacityBytes = SERVER_KNOBS->PEEK_COMPRESSION_CACHE_BYTES)
+	  : cache(capacityBytes) {}
+
+	// Compresses reply.messages, which are the messages of tag from begin to reply.end, with filter. The reply is left
+	// as is if the filter is not supported here or compression would not make it smaller.
+	void compress(TLogPeekReply& reply, Tag tag, Version begin, CompressionFilter filter) {
+		if (filter == CompressionFilter::NONE || !CompressionUtils::supportedFilters.count(filter) ||
+		    reply.messages.size() < SERVER_KNOBS->PEEK_COMPRESSION_MIN_BYTES) {
+			return;
+		}
+
+		const CacheKey key(tag, begin, reply.end, reply.messages.size(), filter);
+		Standalone<StringRef> compressed;
+		Optional<Standalone<StringRef>> cached = cache.get(key);
+		if (cached.present()) {
+			compressed = cached.get();
+		} else {
+			compressed.contents() = CompressionUtils::compress(filter, reply.messages, compressed.arena());
+			cache.insert(key, compressed, compressed.size());
+		}
+
+		if (compressed.size() < reply.messages.size()) {
+			reply.arena.dependsOn(compressed.arena());
+			reply.messages = compressed;
+			reply.compressionFilter = filter;
+		}
+	}
+
+private:
+	// Tag, begin and end version, uncompressed size and filter of a compressed reply
+	using CacheKey = std::tuple<Tag, Version, Version, int, CompressionFilter>;
+
+	FifoCache<CacheKey, Standalone<StringRef>> cache;
+};
+
+#endif
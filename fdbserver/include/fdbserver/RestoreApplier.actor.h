@@ -215,6 +215,16 @@ struct StagingKeyRange {
 	}
 };
 
+// A point mutation buffered on applier in a sorted run, see ApplierBatchData::sortedRuns
+struct RunMutation {
+	MutationRef mutation;
+	LogMessageVersion version;
+
+	bool operator<(const RunMutation& rhs) const {
+		return std::tie(mutation.param1, version) < std::tie(rhs.mutation.param1, rhs.version);
+	}
+};
+
 // Applier state in each verion batch
 class ApplierVersionBatchState : RoleVersionBatchState {
 public:
@@ -241,6 +251,11 @@ struct ApplierBatchData : public ReferenceCounted<ApplierBatchData> {
 	VersionedMutationsMap kvOps; // Mutations at each version
 	std::map<Key, StagingKey> stagingKeys;
 	std::set<StagingKeyRange> stagingKeyRanges;
+	// With FASTRESTORE_APPLIER_SORTED_RUNS, point mutations are appended to currentRun instead of stagingKeys. Full
+	// runs are sorted by key and version. When the version batch is applied, the runs are merged into stagingKeys and
+	// applied a chunk of keys at a time.
+	std::vector<Standalone<VectorRef<RunMutation>>> sortedRuns;
+	Standalone<VectorRef<RunMutation>> currentRun;
 
 	Future<Void> pollMetrics;
 
@@ -297,6 +312,13 @@ struct ApplierBatchData : public ReferenceCounted<ApplierBatchData> {
 
 	void addMutation(MutationRef m, LogMessageVersion ver) {
 		if (!isRangeMutation(m)) {
+			if (SERVER_KNOBS->FASTRESTORE_APPLIER_SORTED_RUNS) {
+				currentRun.push_back(currentRun.arena(), RunMutation{ MutationRef(currentRun.arena(), m), ver });
+				if (currentRun.size() >= SERVER_KNOBS->FASTRESTORE_APPLIER_RUN_MUTATIONS) {
+					sealCurrentRun();
+				}
+				return;
+			}
 			auto item = stagingKeys.emplace(m.param1, StagingKey(m.param1));
 			item.first->second.add(m, ver);
 		} else {
@@ -304,6 +326,15 @@ struct ApplierBatchData : public ReferenceCounted<ApplierBatchData> {
 		}
 	}
 
+	// Sorts currentRun and moves it to sortedRuns
+	void sealCurrentRun() {
+		if (currentRun.empty())
+			return;
+		std::sort(currentRun.begin(), currentRun.end());
+		sortedRuns.push_back(std::move(currentRun));
+		currentRun = Standalone<VectorRef<RunMutation>>();
+	}
+
 	// Return true if all staging keys have been precomputed
 	bool allKeysPrecomputed() {
 		for (auto& stagingKey : stagingKeys) {
@@ -26,6 +26,7 @@
 #include "fdbclient/CommitTransaction.h"
 #include "fdbclient/MutationList.h"
 #include "fdbclient/StorageServerInterface.h"
+#include "flow/CompressionUtils.h"
 #include <iterator>
 
 struct TLogInterface {
@@ -186,10 +187,28 @@ struct TLogPeekReply {
 	Version minKnownCommittedVersion;
 	Optional<Version> begin;
 	bool onlySpilled = false;
+	Optional<CompressionFilter> compressionFilter; // If present, messages are compressed with this filter
+
+	// Replaces compressed messages with the messages they were compressed from.
+	void decompress() {
+		if (compressionFilter.present()) {
+			messages = CompressionUtils::decompress(compressionFilter.get(), messages, arena);
+			compressionFilter.reset();
+		}
+	}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, messages, end, popped, maxKnownVersion, minKnownCommittedVersion, begin, onlySpilled, arena);
+		serializer(ar,
+		           messages,
+		           end,
+		           popped,
+		           maxKnownVersion,
+		           minKnownCommittedVersion,
+		           begin,
+		           onlySpilled,
+		           compressionFilter,
+		           arena);
 	}
 };
 
@@ -201,18 +220,22 @@ struct TLogPeekRequest {
 	bool onlySpilled;
 	Optional<std::pair<UID, int>> sequence;
 	ReplyPromise<TLogPeekReply> reply;
+	// The reply may be compressed with this filter. Older TLogs ignore it and reply uncompressed.
+	Optional<CompressionFilter> compressionFilter;
 
 	TLogPeekRequest(Version begin,
 	                Tag tag,
 	                bool returnIfBlocked,
 	                bool onlySpilled,
-	                Optional<std::pair<UID, int>> sequence = Optional<std::pair<UID, int>>())
-	  : begin(begin), tag(tag), returnIfBlocked(returnIfBlocked), onlySpilled(onlySpilled), sequence(sequence) {}
+	                Optional<std::pair<UID, int>> sequence = Optional<std::pair<UID, int>>(),
+	                Optional<CompressionFilter> compressionFilter = Optional<CompressionFilter>())
+	  : begin(begin), tag(tag), returnIfBlocked(returnIfBlocked), onlySpilled(onlySpilled), sequence(sequence),
+	    compressionFilter(compressionFilter) {}
 	TLogPeekRequest() {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, begin, tag, returnIfBlocked, onlySpilled, sequence, reply);
+		serializer(ar, begin, tag, returnIfBlocked, onlySpilled, sequence, reply, compressionFilter);
 	}
 };
 
@@ -238,14 +261,20 @@ struct TLogPeekStreamRequest {
 	bool returnIfBlocked;
 	int limitBytes;
 	ReplyPromiseStream<TLogPeekStreamReply> reply;
+	Optional<CompressionFilter> compressionFilter; // As in TLogPeekRequest
 
 	TLogPeekStreamRequest() {}
-	TLogPeekStreamRequest(Version version, Tag tag, bool returnIfBlocked, int limitBytes)
-	  : begin(version), tag(tag), returnIfBlocked(returnIfBlocked), limitBytes(limitBytes) {}
+	TLogPeekStreamRequest(Version version,
+	                      Tag tag,
+	                      bool returnIfBlocked,
+	                      int limitBytes,
+	                      Optional<CompressionFilter> compressionFilter = Optional<CompressionFilter>())
+	  : begin(version), tag(tag), returnIfBlocked(returnIfBlocked), limitBytes(limitBytes),
+	    compressionFilter(compressionFilter) {}
 
 	template <class Ar>
 	void serialize(Ar& ar) {
-		serializer(ar, begin, tag, returnIfBlocked, limitBytes, reply);
+		serializer(ar, begin, tag, returnIfBlocked, limitBytes, reply, compressionFilter);
 	}
 };
 
@@ -301,6 +330,9 @@ struct TLogCommitRequest {
 	Version prevVersion, version, knownCommittedVersion, minKnownCommittedVersion;
 
 	StringRef messages; // Each message prefixed by a 4-byte length
+	// The offsets within messages of the messages of each tag, in the order the messages were pushed. Empty if the
+	// proxy did not index its messages, in which case the TLog parses the tags of every message.
+	VectorRef<TagMessagesRef> tagMessages;
 
 	ReplyPromise<TLogCommitReply> reply;
 	int tLogCount;
@@ -315,10 +347,11 @@ struct TLogCommitRequest {
 	                  Version minKnownCommittedVersion,
 	                  StringRef messages,
 	                  int tLogCount,
-	                  Optional<UID> debugID)
+	                  Optional<UID> debugID,
+	                  VectorRef<TagMessagesRef> tagMessages = VectorRef<TagMessagesRef>())
 	  : spanContext(context), arena(a), prevVersion(prevVersion), version(version),
 	    knownCommittedVersion(knownCommittedVersion), minKnownCommittedVersion(minKnownCommittedVersion),
-	    messages(messages), tLogCount(tLogCount), debugID(debugID) {}
+	    messages(messages), tagMessages(tagMessages), tLogCount(tLogCount), debugID(debugID) {}
 	template <class Ar>
 	void serialize(Ar& ar) {
 		serializer(ar,
@@ -331,6 +364,7 @@ struct TLogCommitRequest {
 		           debugID,
 		           tLogCount,
 		           spanContext,
+		           tagMessages,
 		           arena);
 	}
 };
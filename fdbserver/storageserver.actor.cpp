@@ -20,6 +20,7 @@
 
 #include <cinttypes>
 #include <functional>
+#include <numeric>
 #include <type_traits>
 #include <unordered_map>
 
@@ -406,6 +407,14 @@ struct StorageServerDisk {
 		++(*kvGets);
 		return storage->readValue(key, options);
 	}
+	Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		*kvGets += keys.size();
+		return storage->readValues(keys, options);
+	}
+	// Like readValue(), but the read joins a batch of point reads which is sent to the storage engine as one sorted
+	// readValues() once STORAGE_SERVER_POINT_READ_BATCH_WINDOW has passed or the batch is full
+	Future<Optional<Value>> readValueBatched(KeyRef key, Optional<ReadOptions> options = Optional<ReadOptions>());
 	Future<Optional<Value>> readValuePrefix(KeyRef key,
 	                                        int maxLength,
 	                                        Optional<ReadOptions> options = Optional<ReadOptions>()) {
@@ -437,6 +446,7 @@ struct StorageServerDisk {
 	Counter* kvClearRanges;
 	Counter* kvClearSingleKey;
 	Counter* kvGets;
+	Counter* kvGetBatches;
 	Counter* kvScans;
 	Counter* kvCommits;
 
@@ -445,6 +455,55 @@ private:
 	IKeyValueStore* storage;
 	void writeMutations(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
 
+	// Point reads waiting to be sent to the storage engine together
+	struct PointReadBatch : ReferenceCounted<PointReadBatch> {
+		ReadOptions options;
+		Standalone<VectorRef<KeyRef>> keys;
+		std::vector<Promise<Optional<Value>>> replies;
+		Promise<Void> full;
+	};
+	// The batch being filled for each ReadType and cacheResult, as the reads in a batch share their options
+	std::map<std::pair<ReadType, bool>, Reference<PointReadBatch>> pointReadBatches;
+
+	ACTOR static Future<Void> sendPointReadBatch(StorageServerDisk* self, Reference<PointReadBatch> batch) {
+		wait(delay(SERVER_KNOBS->STORAGE_SERVER_POINT_READ_BATCH_WINDOW, TaskPriority::DefaultEndpoint) ||
+		     batch->full.getFuture());
+		auto i = self->pointReadBatches.find(std::make_pair(batch->options.type, batch->options.cacheResult));
+		if (i != self->pointReadBatches.end() && i->second == batch) {
+			self->pointReadBatches.erase(i);
+		}
+
+		// Sort the keys and remove duplicates, remembering where each request's key went
+		state std::vector<int> slots(batch->keys.size());
+		state Standalone<VectorRef<KeyRef>> keys;
+		std::vector<int> order(batch->keys.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](int a, int b) { return batch->keys[a] < batch->keys[b]; });
+		keys.arena().dependsOn(batch->keys.arena());
+		for (int j : order) {
+			if (keys.empty() || keys.back() != batch->keys[j]) {
+				keys.push_back(keys.arena(), batch->keys[j]);
+			}
+			slots[j] = keys.size() - 1;
+		}
+
+		++(*self->kvGetBatches);
+		try {
+			std::vector<Optional<Value>> values = wait(self->storage->readValues(keys, batch->options));
+			for (int j = 0; j < batch->replies.size(); ++j) {
+				batch->replies[j].send(values[slots[j]]);
+			}
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			for (auto& reply : batch->replies) {
+				reply.sendError(e);
+			}
+		}
+		return Void();
+	}
+
 	ACTOR static Future<Key> readFirstKey(IKeyValueStore* storage, KeyRangeRef range, Optional<ReadOptions> options) {
 		RangeResult r = wait(storage->readRange(range, 1, 1 << 30, options));
 		if (r.size())
@@ -1159,7 +1218,7 @@ public:
 
 	struct Counters {
 		CounterCollection cc;
-		Counter allQueries, getKeyQueries, getValueQueries, getRangeQueries, getMappedRangeQueries,
+		Counter allQueries, getKeyQueries, getValueQueries, getValuesQueries, getRangeQueries, getMappedRangeQueries,
 		    getRangeStreamQueries, finishedQueries, lowPriorityQueries, rowsQueried, bytesQueried, watchQueries,
 		    emptyQueries, feedRowsQueried, feedBytesQueried, feedStreamQueries, rejectedFeedStreamQueries,
 		    feedVersionQueries;
@@ -1221,6 +1280,8 @@ public:
 		Counter eagerReadsKeys;
 		// The count of readValue operation to the storage engine.
 		Counter kvGets;
+		// The count of readValues operations to the storage engine, each of which batches several readValue reads.
+		Counter kvGetBatches;
 		// The count of readValue operation to the storage engine.
 		Counter kvScans;
 		// The count of commit operation to the storage engine.
@@ -1245,6 +1306,7 @@ public:
 		Counters(StorageServer* self)
 		  : cc("StorageServer", self->thisServerID.toString()), allQueries("QueryQueue", cc),
 		    getKeyQueries("GetKeyQueries", cc), getValueQueries("GetValueQueries", cc),
+		    getValuesQueries("GetValuesQueries", cc),
 		    getRangeQueries("GetRangeQueries", cc), getMappedRangeQueries("GetMappedRangeQueries", cc),
 		    getRangeStreamQueries("GetRangeStreamQueries", cc), finishedQueries("FinishedQueries", cc),
 		    lowPriorityQueries("LowPriorityQueries", cc), rowsQueried("RowsQueried", cc),
@@ -1269,7 +1331,8 @@ public:
 		    quickGetValueMiss("QuickGetValueMiss", cc), quickGetKeyValuesHit("QuickGetKeyValuesHit", cc),
 		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc), kvScanBytes("KVScanBytes", cc),
 		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc), kvGets("KVGets", cc),
-		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
+		    kvGetBatches("KVGetBatches", cc), kvScans("KVScans", cc), kvCommits("KVCommits", cc),
+		    changeFeedDiskReads("ChangeFeedDiskReads", cc),
 		    readLatencySample("ReadLatencyMetrics",
 		                      self->thisServerID,
 		                      SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
@@ -1441,6 +1504,7 @@ public:
 		this->storage.kvClearRanges = &counters.kvClearRanges;
 		this->storage.kvClearSingleKey = &counters.kvClearSingleKey;
 		this->storage.kvGets = &counters.kvGets;
+		this->storage.kvGetBatches = &counters.kvGetBatches;
 		this->storage.kvScans = &counters.kvScans;
 		this->storage.kvCommits = &counters.kvCommits;
 
@@ -2099,7 +2163,9 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			path = 1;
 		} else if (!i || !i->isClearTo() || i->getEndKey() <= req.key) {
 			path = 2;
-			Optional<Value> vv = wait(data->storage.readValue(req.key, req.options));
+			Optional<Value> vv = wait(SERVER_KNOBS->STORAGE_SERVER_BATCH_POINT_READS
+			                              ? data->storage.readValueBatched(req.key, req.options)
+			                              : data->storage.readValue(req.key, req.options));
 			data->counters.kvGetBytes += vv.expectedSize();
 			// Validate that while we were reading the data we didn't lose the version or shard
 			if (version < data->storageVersion()) {
@@ -2183,6 +2249,133 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	return Void();
 }
 
+// Reads all the keys of req at one version. Keys whose value is decided by the versioned data are answered from memory,
+// and the rest are read from the storage engine with a single readValues().
+ACTOR Future<Void> getValuesQ(StorageServer* data, GetValuesRequest req) {
+	state int64_t resultSize = 0;
+	Span span("SS:getValues"_loc, req.spanContext);
+	if (req.tenantInfo.name.present()) {
+		span.addAttribute("tenant"_sr, req.tenantInfo.name.get());
+	}
+
+	try {
+		++data->counters.getValuesQueries;
+		++data->counters.allQueries;
+		data->maxQueryQueue = std::max<int>(
+		    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+		// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
+		// so we need to downgrade here
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+
+		// Track time from requestTime through now as read queueing wait time
+		state double queueWaitEnd = g_network->timer();
+		data->counters.readQueueWaitSample.addMeasurement(queueWaitEnd - req.requestTime());
+
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+		data->counters.readVersionWaitSample.addMeasurement(g_network->timer() - queueWaitEnd);
+
+		state Standalone<VectorRef<KeyRef>> keys;
+		Optional<TenantMapEntry> entry = data->getTenantEntry(version, req.tenantInfo);
+		keys.arena().dependsOn(req.arena);
+		keys.reserve(keys.arena(), req.keys.size());
+		for (const KeyRef& key : req.keys) {
+			keys.push_back(keys.arena(), entry.present() ? key.withPrefix(entry.get().prefix, keys.arena()) : key);
+		}
+		state uint64_t changeCounter = data->shardChangeCounter;
+
+		for (const KeyRef& key : keys) {
+			if (!data->shards[key]->isReadable()) {
+				throw wrong_shard_server();
+			}
+		}
+
+		// Keys which are not decided by the versioned data go to the storage engine together, in the sorted order the
+		// client sent them in
+		state std::vector<Optional<Value>> values(keys.size());
+		state Standalone<VectorRef<KeyRef>> diskKeys;
+		state std::vector<int> diskSlots;
+		diskKeys.arena().dependsOn(keys.arena());
+		auto view = data->data().at(version);
+		for (int j = 0; j < keys.size(); ++j) {
+			auto i = view.lastLessOrEqual(keys[j]);
+			if (i && i->isValue() && i.key() == keys[j]) {
+				values[j] = (Value)i->getValue();
+			} else if (!i || !i->isClearTo() || i->getEndKey() <= keys[j]) {
+				diskKeys.push_back(diskKeys.arena(), keys[j]);
+				diskSlots.push_back(j);
+			}
+		}
+
+		if (!diskKeys.empty()) {
+			std::vector<Optional<Value>> diskValues = wait(data->storage.readValues(diskKeys, req.options));
+			// Validate that while we were reading the data we didn't lose the version or shard
+			if (version < data->storageVersion()) {
+				CODE_PROBE(true, "transaction_too_old after readValues");
+				throw transaction_too_old();
+			}
+			// A shard which moved during the read invalidates every key of the batch, not just those read from disk
+			for (const KeyRef& key : keys) {
+				data->checkChangeCounter(changeCounter, key);
+			}
+			for (int j = 0; j < diskSlots.size(); ++j) {
+				data->counters.kvGetBytes += diskValues[j].expectedSize();
+				values[diskSlots[j]] = diskValues[j];
+			}
+		}
+
+		GetValuesReply reply;
+		for (int j = 0; j < keys.size(); ++j) {
+			const Optional<Value>& v = values[j];
+			if (v.present()) {
+				++data->counters.rowsQueried;
+				resultSize += v.get().size();
+				data->counters.bytesQueried += v.get().size();
+				reply.data.push_back_deep(reply.arena, KeyValueRef(req.keys[j], v.get()));
+			} else {
+				++data->counters.emptyQueries;
+			}
+
+			if (SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+				// If the read yields no value, randomly sample the empty read.
+				int64_t bytesReadPerKSecond =
+				    v.present() ? std::max((int64_t)(keys[j].size() + v.get().size()), SERVER_KNOBS->EMPTY_READ_PENALTY)
+				                : SERVER_KNOBS->EMPTY_READ_PENALTY;
+				data->metrics.notifyBytesReadPerKSecond(keys[j], bytesReadPerKSecond);
+			}
+
+			// Check if the desired key might be cached
+			reply.cached = reply.cached || data->cachedRangeMap[keys[j]];
+		}
+
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	// Key size is not included in "BytesQueried", but still contributes to cost,
+	// so it must be accounted for here.
+	data->transactionTagCounter.addRequest(req.tags, req.keys.expectedSize() + resultSize);
+
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySample.addMeasurement(duration);
+	data->counters.readValueLatencySample.addMeasurement(duration);
+	if (data->latencyBandConfig.present()) {
+		int maxReadBytes =
+		    data->latencyBandConfig.get().readConfig.maxReadBytes.orDefault(std::numeric_limits<int>::max());
+		data->counters.readLatencyBands.addMeasurement(duration, 1, Filtered(resultSize > maxReadBytes));
+	}
+
+	return Void();
+}
+
 // Pessimistic estimate the number of overhead bytes used by each
 // watch. Watch key references are stored in an AsyncMap<Key,bool>, and actors
 // must be kept alive until the watch is finished.
@@ -9645,6 +9838,34 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 #pragma region StorageServerDisk
 #endif
 
+Future<Optional<Value>> StorageServerDisk::readValueBatched(KeyRef key, Optional<ReadOptions> options) {
+	// Traced reads and consistency check reads are not batched
+	if (options.present() && (options.get().debugID.present() || options.get().consistencyCheckStartVersion.present())) {
+		return readValue(key, options);
+	}
+
+	++(*kvGets);
+	ReadOptions readOptions = options.orDefault(ReadOptions());
+	auto batchKey = std::make_pair(readOptions.type, readOptions.cacheResult);
+	Reference<PointReadBatch>& batch = pointReadBatches[batchKey];
+	if (!batch.isValid()) {
+		batch = makeReference<PointReadBatch>();
+		batch->options = readOptions;
+		data->actors.add(sendPointReadBatch(this, batch));
+	}
+
+	batch->keys.push_back_deep(batch->keys.arena(), key);
+	batch->replies.emplace_back();
+	Future<Optional<Value>> reply = batch->replies.back().getFuture();
+
+	if (batch->keys.size() >= SERVER_KNOBS->STORAGE_SERVER_POINT_READ_BATCH_MAX) {
+		Reference<PointReadBatch> full = batch;
+		pointReadBatches.erase(batchKey);
+		full->full.send(Void());
+	}
+	return reply;
+}
+
 void StorageServerDisk::makeNewStorageServerDurable(const bool shardAware) {
 	if (shardAware) {
 		storage->set(persistShardAwareFormat);
@@ -10568,6 +10789,16 @@ ACTOR Future<Void> serveGetValueRequests(StorageServer* self, FutureStream<GetVa
 	}
 }
 
+ACTOR Future<Void> serveGetValuesRequests(StorageServer* self, FutureStream<GetValuesRequest> getValues) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetValue;
+	loop {
+		GetValuesRequest req = waitNext(getValues);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		self->actors.add(self->readGuard(req, getValuesQ));
+	}
+}
+
 ACTOR Future<Void> serveGetKeyValuesRequests(StorageServer* self, FutureStream<GetKeyValuesRequest> getKeyValues) {
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
 	loop {
@@ -10818,6 +11049,7 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 	self->actors.add(logLongByteSampleRecovery(self->byteSampleRecovery));
 	self->actors.add(checkBehind(self));
 	self->actors.add(serveGetValueRequests(self, ssi.getValue.getFuture()));
+	self->actors.add(serveGetValuesRequests(self, ssi.getValues.getFuture()));
 	self->actors.add(serveGetKeyValuesRequests(self, ssi.getKeyValues.getFuture()));
 	self->actors.add(serveGetMappedKeyValuesRequests(self, ssi.getMappedKeyValues.getFuture()));
 	self->actors.add(serveGetKeyValuesStreamRequests(self, ssi.getKeyValuesStream.getFuture()));
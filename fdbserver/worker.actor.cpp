@@ -425,6 +425,7 @@ struct TLogOptions {
 		case TLogVersion::V5:
 		case TLogVersion::V6:
 		case TLogVersion::V7:
+		case TLogVersion::V8:
 			toReturn = "V_" + boost::lexical_cast<std::string>(version);
 			break;
 		}
@@ -456,6 +457,7 @@ TLogFn tLogFnForOptions(TLogOptions options) {
 	case TLogVersion::V5:
 	case TLogVersion::V6:
 	case TLogVersion::V7:
+	case TLogVersion::V8:
 		return tLog;
 	default:
 		ASSERT(false);
@@ -45,8 +45,9 @@ static const char* logTypes[] = { "log_engine:=1",
 	                              "log_version:=4",
 	                              "log_version:=5",
 	                              "log_version:=6",
-	                              // downgrade incompatible log version
-	                              "log_version:=7" };
+	                              // downgrade incompatible log versions
+	                              "log_version:=7",
+	                              "log_version:=8" };
 static const char* redundancies[] = { "single", "double", "triple" };
 static const char* backupTypes[] = { "backup_worker_enabled:=0", "backup_worker_enabled:=1" };
 
@@ -427,7 +428,7 @@ struct ConfigureDatabaseWorkload : TestWorkload {
 				int length = sizeof(logTypes) / sizeof(logTypes[0]);
 
 				if (self->downgradeTest1) {
-					length -= 1;
+					length -= 2;
 				}
 
 				wait(success(
@@ -20,6 +20,8 @@
 
 #include "flow/Arena.h"
 
+#include "flow/Histogram.h"
+#include "flow/Knobs.h"
 #include "flow/UnitTest.h"
 
 // We don't align memory properly, and we need to tell lsan about that.
@@ -102,8 +104,126 @@ void makeNoAccess(void*, size_t) {}
 void makeDefined(void*, size_t) {}
 void makeUndefined(void*, size_t) {}
 #endif
+
+// Sanitizers and valgrind should see every block being freed, so they can catch uses after free
+#if defined(USE_GPERFTOOLS) || defined(ADDRESS_SANITIZER) || VALGRIND
+constexpr bool arenaBlockPoolSupported = false;
+#else
+constexpr bool arenaBlockPoolSupported = true;
+#endif
+
+constexpr int ARENA_BLOCK_POOL_MAX_SIZE = 1 << 20;
+// 4096, 8192, and four classes for each power of two between 8KiB and 1MiB
+constexpr int ARENA_BLOCK_POOL_CLASSES = 2 + 4 * 7;
+
+// Returns the pool class of blocks of the given size, and rounds size up to the size of the blocks in that class.
+// Blocks larger than 8KiB are rounded up to the next multiple of a quarter of their power of two, which wastes at most
+// 25% of a block.
+int arenaBlockPoolClass(int& size) {
+	if (size <= 4096) {
+		size = 4096;
+		return 0;
+	}
+	if (size <= 8192) {
+		size = 8192;
+		return 1;
+	}
+	int log2 = 13;
+	while ((size - 1) >> (log2 + 1)) {
+		++log2;
+	}
+	int step = 1 << (log2 - 2);
+	int quarters = (size + step - 1) / step;
+	size = quarters * step;
+	return 2 + 4 * (log2 - 13) + (quarters - 5);
+}
+
+// Only the network thread pools blocks. Other threads mostly release blocks the network thread allocated (e.g. client
+// replies destroyed by application threads), so a pool of theirs would hold blocks it rarely reuses.
+bool arenaBlockPoolEnabled() {
+	return arenaBlockPoolSupported && FLOW_KNOBS && FLOW_KNOBS->ARENA_BLOCK_POOL_BYTES > 0 &&
+	       TraceEvent::isNetworkThread();
+}
+
+// Cached blocks of the network thread, kept in one free list per class, linked through their first word
+struct ArenaBlockPool {
+	void* freeLists[ARENA_BLOCK_POOL_CLASSES] = {};
+	int64_t bytes = 0;
+
+	~ArenaBlockPool();
+};
+
+// Set once the network thread's pool is destroyed, so that blocks released by later thread local destructors are
+// freed directly
+thread_local bool arenaBlockPoolDestroyed = false;
+
+ArenaBlockPool::~ArenaBlockPool() {
+	arenaBlockPoolDestroyed = true;
+	for (void* p : freeLists) {
+		while (p) {
+			void* next = *(void**)p;
+			delete[] reinterpret_cast<uint8_t*>(p);
+			p = next;
+		}
+	}
+	g_arenaBlockPoolMemory.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+ArenaBlockPool& arenaBlockPool() {
+	static thread_local ArenaBlockPool pool;
+	return pool;
+}
+
+// Returns a block of size bytes, from the pool if called on the network thread and size is the size of a pool class
+uint8_t* allocateArenaBlock(int size) {
+	if (size <= ARENA_BLOCK_POOL_MAX_SIZE && arenaBlockPoolEnabled() && !arenaBlockPoolDestroyed) {
+		int rounded = size;
+		ArenaBlockPool& pool = arenaBlockPool();
+		void*& freeList = pool.freeLists[arenaBlockPoolClass(rounded)];
+		if (rounded == size && freeList) {
+			void* p = freeList;
+			freeList = *(void**)p;
+			pool.bytes -= size;
+			g_arenaBlockPoolMemory.fetch_sub(size, std::memory_order_relaxed);
+			g_arenaBlockPoolHits.fetch_add(1, std::memory_order_relaxed);
+			return reinterpret_cast<uint8_t*>(p);
+		}
+		g_arenaBlockPoolMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+	return new uint8_t[size];
+}
+
+void releaseArenaBlock(void* p, int size) {
+	if (size <= ARENA_BLOCK_POOL_MAX_SIZE && arenaBlockPoolEnabled() && !arenaBlockPoolDestroyed) {
+		int rounded = size;
+		int poolClass = arenaBlockPoolClass(rounded);
+		ArenaBlockPool& pool = arenaBlockPool();
+		// Blocks allocated while the pool was disabled may not have a class size
+		if (rounded == size && pool.bytes + size <= FLOW_KNOBS->ARENA_BLOCK_POOL_BYTES) {
+			*(void**)p = pool.freeLists[poolClass];
+			pool.freeLists[poolClass] = p;
+			pool.bytes += size;
+			g_arenaBlockPoolMemory.fetch_add(size, std::memory_order_relaxed);
+			return;
+		}
+	}
+	delete[] reinterpret_cast<uint8_t*>(p);
+}
+
+// Samples the size of blocks of at least 4KiB allocated by the network thread
+void sampleArenaBlockSize(int size) {
+	if (TraceEvent::isNetworkThread()) {
+		static Reference<Histogram>* histogram =
+		    new Reference<Histogram>(Histogram::getHistogram("Arena"_sr, "BlockBytes"_sr, Histogram::Unit::bytes));
+		(*histogram)->sample(size);
+	}
+}
 } // namespace
 
+std::atomic<int64_t> g_arenaBlockPoolHits(0);
+std::atomic<int64_t> g_arenaBlockPoolMisses(0);
+std::atomic<int64_t> g_arenaBlockPoolMemory(0);
+
 Arena::Arena() : impl(nullptr) {}
 Arena::Arena(size_t reservedSize) : impl(0) {
 	UNSTOPPABLE_ASSERT(reservedSize < std::numeric_limits<int>::max());
@@ -381,22 +501,28 @@ ArenaBlock* ArenaBlock::create(int dataSize, Reference<ArenaBlock>& next) {
 				b->bigSize = 2048;
 				INSTRUMENT_ALLOCATE("Arena2048");
 			} else if (reqSize <= 4096) {
-				b = (ArenaBlock*)new uint8_t[4096];
+				b = (ArenaBlock*)allocateArenaBlock(4096);
 				b->bigSize = 4096;
+				sampleArenaBlockSize(4096);
 				INSTRUMENT_ALLOCATE("Arena4096");
 			} else {
-				b = (ArenaBlock*)new uint8_t[8192];
+				b = (ArenaBlock*)allocateArenaBlock(8192);
 				b->bigSize = 8192;
+				sampleArenaBlockSize(8192);
 				INSTRUMENT_ALLOCATE("Arena8192");
 			}
 			b->totalSizeEstimate = b->bigSize;
 			b->tinySize = b->tinyUsed = NOT_TINY;
 			b->bigUsed = sizeof(ArenaBlock);
 		} else {
+			if (reqSize <= ARENA_BLOCK_POOL_MAX_SIZE && arenaBlockPoolEnabled()) {
+				arenaBlockPoolClass(reqSize);
+			}
 #ifdef ALLOC_INSTRUMENTATION
 			allocInstr["ArenaHugeKB"].alloc((reqSize + 1023) >> 10);
 #endif
-			b = (ArenaBlock*)new uint8_t[reqSize];
+			b = (ArenaBlock*)allocateArenaBlock(reqSize);
+			sampleArenaBlockSize(reqSize);
 			b->tinySize = b->tinyUsed = NOT_TINY;
 			b->bigSize = reqSize;
 			b->totalSizeEstimate = b->bigSize;
@@ -493,17 +619,17 @@ void ArenaBlock::destroyLeaf() {
 			delete[] reinterpret_cast<uint8_t*>(this);
 			INSTRUMENT_RELEASE("Arena2048");
 		} else if (bigSize <= 4096) {
-			delete[] reinterpret_cast<uint8_t*>(this);
+			releaseArenaBlock(this, 4096);
 			INSTRUMENT_RELEASE("Arena4096");
 		} else if (bigSize <= 8192) {
-			delete[] reinterpret_cast<uint8_t*>(this);
+			releaseArenaBlock(this, 8192);
 			INSTRUMENT_RELEASE("Arena8192");
 		} else {
 #ifdef ALLOC_INSTRUMENTATION
 			allocInstr["ArenaHugeKB"].dealloc((bigSize + 1023) >> 10);
 #endif
 			g_hugeArenaMemory.fetch_sub(bigSize);
-			delete[] reinterpret_cast<uint8_t*>(this);
+			releaseArenaBlock(this, bigSize);
 		}
 	}
 }
@@ -787,6 +913,63 @@ TEST_CASE("/flow/Arena/SelfRef") {
 	return Void();
 }
 
+TEST_CASE("/flow/Arena/BlockPoolClasses") {
+	int previousClass = 1;
+	int previousSize = 8192;
+	for (int size = 8193; size <= ARENA_BLOCK_POOL_MAX_SIZE; ++size) {
+		int rounded = size;
+		int poolClass = arenaBlockPoolClass(rounded);
+		ASSERT(rounded >= size && (rounded - size) * 4 < rounded);
+		ASSERT_EQ(poolClass, rounded == previousSize ? previousClass : previousClass + 1);
+
+		int roundedAgain = rounded;
+		ASSERT_EQ(arenaBlockPoolClass(roundedAgain), poolClass);
+		ASSERT_EQ(roundedAgain, rounded);
+
+		previousClass = poolClass;
+		previousSize = rounded;
+	}
+	ASSERT_EQ(previousClass, ARENA_BLOCK_POOL_CLASSES - 1);
+	ASSERT_EQ(previousSize, ARENA_BLOCK_POOL_MAX_SIZE);
+	return Void();
+}
+
+TEST_CASE("/flow/Arena/BlockPoolReuse") {
+	if (!arenaBlockPoolEnabled()) {
+		return Void();
+	}
+
+	int64_t pooledMemory = g_arenaBlockPoolMemory.load();
+	{
+		Arena a(20000);
+		memset(new (a) uint8_t[20000], 0xfd, 20000);
+	}
+	// The block is only kept if the pool had room for it
+	if (g_arenaBlockPoolMemory.load() > pooledMemory) {
+		int64_t hits = g_arenaBlockPoolHits.load();
+		Arena b(20000);
+		memset(new (b) uint8_t[20000], 0xfd, 20000);
+		ASSERT_EQ(g_arenaBlockPoolHits.load(), hits + 1);
+	}
+	return Void();
+}
+
+TEST_CASE("/flow/StringRef/commonPrefixLengthSIMD") {
+	uint8_t a[100], b[100];
+	for (int i = 0; i < 10000; i++) {
+		int length = deterministicRandom()->randomInt(0, 100);
+		for (int j = 0; j < length; j++) {
+			a[j] = b[j] = deterministicRandom()->randomInt(0, 256);
+		}
+		if (length > 0 && deterministicRandom()->coinflip()) {
+			b[deterministicRandom()->randomInt(0, length)] ^= 1 << deterministicRandom()->randomInt(0, 8);
+		}
+		ASSERT_EQ(commonPrefixLengthSIMD(a, b, length), commonPrefixLength(a, b, length));
+	}
+
+	return Void();
+}
+
 TEST_CASE("flow/StringRef/eat") {
 	StringRef str = "test/case"_sr;
 	StringRef first = str.eat("/");
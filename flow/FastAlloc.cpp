@@ -28,8 +28,12 @@
 #include "crc32/crc32c.h"
 #include "flow/flow.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <limits>
+#include <map>
+#include <tuple>
 #include <unordered_map>
 
 //#ifdef WIN32
@@ -248,7 +252,16 @@ struct FastAllocator<Size>::GlobalData {
 	std::atomic<long long> totalMemory;
 	long long partialMagazineUnallocatedMemory;
 	std::atomic<long long> activeThreads;
-	GlobalData() : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0) {
+	// Slabs obtained from the system by address, with their size and whether guard pages were mapped around them
+	std::map<uintptr_t, std::pair<size_t, bool>> slabs;
+	std::atomic<int64_t> magazinesAllocated;
+	std::atomic<int64_t> magazinesReused;
+	std::atomic<int64_t> magazinesReturned;
+	std::atomic<int64_t> slabsReleased;
+	std::atomic<int64_t> memoryReleased;
+	GlobalData()
+	  : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0), magazinesAllocated(0),
+	    magazinesReused(0), magazinesReturned(0), slabsReleased(0), memoryReleased(0) {
 		InitializeCriticalSection(&mutex);
 	}
 };
@@ -273,6 +286,23 @@ long long FastAllocator<Size>::getActiveThreads() {
 	return globalData()->activeThreads.load();
 }
 
+template <int Size>
+long long FastAllocator<Size>::getThreadCachedMemory() {
+	ThreadData& thr = threadData();
+	return (thr.count + (thr.alternate ? magazine_size : 0)) * (long long)Size;
+}
+
+template <int Size>
+FastAllocatorStats FastAllocator<Size>::getStats() {
+	FastAllocatorStats stats;
+	stats.magazinesAllocated = globalData()->magazinesAllocated.load();
+	stats.magazinesReused = globalData()->magazinesReused.load();
+	stats.magazinesReturned = globalData()->magazinesReturned.load();
+	stats.slabsReleased = globalData()->slabsReleased.load();
+	stats.memoryReleased = globalData()->memoryReleased.load();
+	return stats;
+}
+
 #if FAST_ALLOCATOR_DEBUG
 static int64_t getSizeCode(int i) {
 	switch (i) {
@@ -469,6 +499,7 @@ void FastAllocator<Size>::getMagazine() {
 		void* m = globalData()->magazines.back();
 		globalData()->magazines.pop_back();
 		LeaveCriticalSection(&globalData()->mutex);
+		globalData()->magazinesReused.fetch_add(1, std::memory_order_relaxed);
 		thr.freelist = m;
 		thr.count = magazine_size;
 		return;
@@ -477,11 +508,21 @@ void FastAllocator<Size>::getMagazine() {
 		globalData()->partial_magazines.pop_back();
 		globalData()->partialMagazineUnallocatedMemory -= p.first * Size;
 		LeaveCriticalSection(&globalData()->mutex);
+		globalData()->magazinesReused.fetch_add(1, std::memory_order_relaxed);
 		thr.freelist = p.second;
 		thr.count = p.first;
 		return;
 	}
-	globalData()->totalMemory.fetch_add(magazine_size * Size);
+
+	// A huge page slab holds several magazines; the ones this thread does not take go to the global free list
+	int magazinesPerSlab = 1;
+#if !FAST_ALLOCATOR_DEBUG
+	if (FLOW_KNOBS && FLOW_KNOBS->FAST_ALLOC_HUGE_PAGE_SLABS) {
+		magazinesPerSlab = std::max(1, kFastAllocHugePageSlabBytes / (magazine_size * Size));
+	}
+#endif
+	const size_t slabBytes = (size_t)magazinesPerSlab * magazine_size * Size;
+	globalData()->totalMemory.fetch_add(slabBytes);
 	LeaveCriticalSection(&globalData()->mutex);
 
 // Allocate a new page of data from the system allocator
@@ -513,28 +554,51 @@ void FastAllocator<Size>::getMagazine() {
 	// with smaller-than-2MiB magazine sizes strands memory.  See issue #909.
 #if !DEBUG_DETERMINISM
 	if (FLOW_KNOBS && g_allocation_tracing_disabled == 0 &&
-	    nondeterministicRandom()->random01() < (magazine_size * Size) / FLOW_KNOBS->FAST_ALLOC_LOGGING_BYTES) {
+	    nondeterministicRandom()->random01() < slabBytes / FLOW_KNOBS->FAST_ALLOC_LOGGING_BYTES) {
 		++g_allocation_tracing_disabled;
 		TraceEvent("GetMagazineSample").detail("Size", Size).backtrace();
 		--g_allocation_tracing_disabled;
 	}
 #endif
+	// Guard pages are not compatible with huge pages
+	const bool hugePages = magazinesPerSlab > 1;
 #ifdef VALGRIND
 	const bool includeGuardPages = false;
 #else
-	const bool includeGuardPages = true;
+	const bool includeGuardPages = !hugePages && FLOW_KNOBS->FAST_ALLOC_ALLOW_GUARD_PAGES;
+#endif
+	// Explicit huge pages aren't requested since mapping them aborts the process on hosts which haven't reserved any
+	block = (void**)::allocate(slabBytes, /*allowLargePages*/ false, includeGuardPages);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	if (hugePages) {
+		// Lets transparent huge pages back the slab
+		madvise(block, slabBytes, MADV_HUGEPAGE);
+	}
 #endif
-	block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
 #endif
 
 	// void** block = new void*[ magazine_size * PSize ];
-	for (int i = 0; i < magazine_size - 1; i++) {
-		block[i * PSize + 1] = block[i * PSize] = &block[(i + 1) * PSize];
-		check(&block[i * PSize], false);
+	for (int m = 0; m < magazinesPerSlab; m++) {
+		void** magazine = block + (size_t)m * magazine_size * PSize;
+		for (int i = 0; i < magazine_size - 1; i++) {
+			magazine[i * PSize + 1] = magazine[i * PSize] = &magazine[(i + 1) * PSize];
+			check(&magazine[i * PSize], false);
+		}
+
+		magazine[(magazine_size - 1) * PSize + 1] = magazine[(magazine_size - 1) * PSize] = nullptr;
+		check(&magazine[(magazine_size - 1) * PSize], false);
+	}
+
+	EnterCriticalSection(&globalData()->mutex);
+#if !FAST_ALLOCATOR_DEBUG
+	globalData()->slabs.emplace(uintptr_t(block), std::make_pair(slabBytes, includeGuardPages));
+#endif
+	for (int m = 1; m < magazinesPerSlab; m++) {
+		globalData()->magazines.push_back(block + (size_t)m * magazine_size * PSize);
 	}
+	LeaveCriticalSection(&globalData()->mutex);
+	globalData()->magazinesAllocated.fetch_add(magazinesPerSlab, std::memory_order_relaxed);
 
-	block[(magazine_size - 1) * PSize + 1] = block[(magazine_size - 1) * PSize] = nullptr;
-	check(&block[(magazine_size - 1) * PSize], false);
 	thr.freelist = block;
 	thr.count = magazine_size;
 }
@@ -543,6 +607,123 @@ void FastAllocator<Size>::releaseMagazine(void* mag) {
 	EnterCriticalSection(&globalData()->mutex);
 	globalData()->magazines.push_back(mag);
 	LeaveCriticalSection(&globalData()->mutex);
+	globalData()->magazinesReturned.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <int Size>
+long long FastAllocator<Size>::releaseEmptySlabs(int maxElements) {
+#if VALGRIND || FAST_ALLOCATOR_DEBUG
+	return 0;
+#else
+	GlobalData* data = globalData();
+
+	// Take the oldest magazines of the global free list, up to about maxElements elements, so that the work done here
+	// is bounded. Threads which need a magazine in the meantime take a newer one or get a new slab instead of waiting.
+	std::vector<std::pair<int, void*>> freeMagazines;
+	int elementCount = 0;
+	EnterCriticalSection(&data->mutex);
+	while (!data->partial_magazines.empty() && elementCount < maxElements) {
+		freeMagazines.push_back(data->partial_magazines.back());
+		elementCount += freeMagazines.back().first;
+		data->partialMagazineUnallocatedMemory -= freeMagazines.back().first * Size;
+		data->partial_magazines.pop_back();
+	}
+	int taken = 0;
+	for (; taken < data->magazines.size() && elementCount < maxElements; taken++) {
+		freeMagazines.emplace_back(magazine_size, data->magazines[taken]);
+		elementCount += magazine_size;
+	}
+	data->magazines.erase(data->magazines.begin(), data->magazines.begin() + taken);
+	LeaveCriticalSection(&data->mutex);
+	if (freeMagazines.empty()) {
+		return 0;
+	}
+
+	std::vector<void*> elements;
+	elements.reserve(elementCount);
+	for (auto const& [count, magazine] : freeMagazines) {
+		void* p = magazine;
+		for (int i = 0; i < count; i++) {
+			elements.push_back(p);
+			p = *(void**)p;
+		}
+	}
+	std::sort(elements.begin(), elements.end());
+
+	// The slabs the elements are in. Other threads only add slabs, and none of these can be released meanwhile.
+	std::vector<std::pair<uintptr_t, size_t>> slabs;
+	EnterCriticalSection(&data->mutex);
+	auto slab = data->slabs.upper_bound(uintptr_t(elements.front()));
+	if (slab != data->slabs.begin()) {
+		--slab;
+	}
+	for (; slab != data->slabs.end() && slab->first <= uintptr_t(elements.back()); ++slab) {
+		slabs.emplace_back(slab->first, slab->second.first);
+	}
+	LeaveCriticalSection(&data->mutex);
+
+	// Walk the sorted elements and slabs together. A slab is released if all of its memory is among the elements, and
+	// the elements of the other slabs are relinked into magazines in address order. Later calls then find the free
+	// elements of a slab next to each other in the free list.
+	std::vector<uintptr_t> releasedSlabs;
+	std::vector<void*> keptMagazines;
+	void* current = nullptr;
+	int currentCount = 0;
+	auto keep = [&](void* p) {
+		*(void**)p = current;
+		current = p;
+		if (++currentCount == magazine_size) {
+			keptMagazines.push_back(current);
+			current = nullptr;
+			currentCount = 0;
+		}
+	};
+	auto element = elements.begin();
+	for (auto const& [address, length] : slabs) {
+		for (; element != elements.end() && uintptr_t(*element) < address; ++element) {
+			keep(*element);
+		}
+		auto slabEnd = element;
+		while (slabEnd != elements.end() && uintptr_t(*slabEnd) < address + length) {
+			++slabEnd;
+		}
+		if (size_t(slabEnd - element) * Size == length) {
+			releasedSlabs.push_back(address);
+			element = slabEnd;
+		} else {
+			for (; element != slabEnd; ++element) {
+				keep(*element);
+			}
+		}
+	}
+	for (; element != elements.end(); ++element) {
+		keep(*element);
+	}
+
+	std::vector<std::tuple<void*, size_t, bool>> released;
+	long long releasedBytes = 0;
+	EnterCriticalSection(&data->mutex);
+	for (uintptr_t address : releasedSlabs) {
+		auto it = data->slabs.find(address);
+		released.emplace_back((void*)it->first, it->second.first, it->second.second);
+		releasedBytes += it->second.first;
+		data->slabs.erase(it);
+	}
+	data->magazines.insert(data->magazines.end(), keptMagazines.begin(), keptMagazines.end());
+	if (currentCount > 0) {
+		data->partial_magazines.emplace_back(currentCount, current);
+		data->partialMagazineUnallocatedMemory += currentCount * Size;
+	}
+	data->totalMemory.fetch_sub(releasedBytes);
+	LeaveCriticalSection(&data->mutex);
+
+	for (auto const& [block, length, guardPages] : released) {
+		::deallocate(block, length, guardPages);
+	}
+	data->slabsReleased.fetch_add(released.size(), std::memory_order_relaxed);
+	data->memoryReleased.fetch_add(releasedBytes, std::memory_order_relaxed);
+	return releasedBytes;
+#endif
 }
 template <int Size>
 FastAllocator<Size>::ThreadData::~ThreadData() {
@@ -555,6 +736,7 @@ FastAllocator<Size>::ThreadData::~ThreadData() {
 	if (alternate) {
 		globalData()->magazines.push_back(alternate);
 	}
+	globalData()->magazinesReturned.fetch_add((freelist ? 1 : 0) + (alternate ? 1 : 0), std::memory_order_relaxed);
 	globalData()->activeThreads.fetch_add(-1);
 	LeaveCriticalSection(&globalData()->mutex);
 
@@ -582,6 +764,36 @@ int64_t getTotalUnusedAllocatedMemory() {
 	return unusedMemory;
 }
 
+// Returns -1 without scanning if the size class has less than minUnusedBytes in its global free list
+template <int Size>
+static int64_t releaseEmptySlabsIfUnused(int64_t minUnusedBytes, int maxScanElements) {
+	if (FastAllocator<Size>::getApproximateMemoryUnused() < minUnusedBytes) {
+		return -1;
+	}
+	return FastAllocator<Size>::releaseEmptySlabs(maxScanElements);
+}
+
+int64_t releaseEmptyFastAllocatorSlabs(int64_t minUnusedBytes, int maxScanElements) {
+	static int64_t (*const releaseFns[])(int64_t, int) = {
+		releaseEmptySlabsIfUnused<16>,   releaseEmptySlabsIfUnused<32>,   releaseEmptySlabsIfUnused<64>,
+		releaseEmptySlabsIfUnused<96>,   releaseEmptySlabsIfUnused<128>,  releaseEmptySlabsIfUnused<256>,
+		releaseEmptySlabsIfUnused<512>,  releaseEmptySlabsIfUnused<1024>, releaseEmptySlabsIfUnused<2048>,
+		releaseEmptySlabsIfUnused<4096>, releaseEmptySlabsIfUnused<8192>, releaseEmptySlabsIfUnused<16384>,
+	};
+	constexpr int sizeClasses = sizeof(releaseFns) / sizeof(releaseFns[0]);
+	static int nextSizeClass = 0;
+
+	// Scan one size class per call, taking turns
+	for (int i = 0; i < sizeClasses; i++) {
+		int64_t releasedMemory = releaseFns[nextSizeClass](minUnusedBytes, maxScanElements);
+		nextSizeClass = (nextSizeClass + 1) % sizeClasses;
+		if (releasedMemory >= 0) {
+			return releasedMemory;
+		}
+	}
+	return 0;
+}
+
 template class FastAllocator<16>;
 template class FastAllocator<32>;
 template class FastAllocator<64>;
@@ -595,6 +807,41 @@ template class FastAllocator<4096>;
 template class FastAllocator<8192>;
 template class FastAllocator<16384>;
 
+TEST_CASE("/flow/FastAllocator/ReleaseEmptySlabs") {
+	// Free many magazines worth of elements, so that whole slabs, even huge page ones, end up in the global free list
+	std::vector<void*> elements;
+	for (int i = 0; i < 128 * (kFastAllocMagazineBytes / 16384); i++) {
+		elements.push_back(FastAllocator<16384>::allocate());
+	}
+	for (void* p : elements) {
+		FastAllocator<16384>::release(p);
+	}
+
+	long long totalMemory = FastAllocator<16384>::getTotalMemory();
+	FastAllocatorStats before = FastAllocator<16384>::getStats();
+	ASSERT_EQ(FastAllocator<16384>::releaseEmptySlabs(0), 0);
+	long long released = FastAllocator<16384>::releaseEmptySlabs(std::numeric_limits<int>::max());
+	FastAllocatorStats after = FastAllocator<16384>::getStats();
+	ASSERT(released % 16384 == 0);
+#if !defined(USE_GPERFTOOLS) && !defined(ADDRESS_SANITIZER) && !VALGRIND && !FAST_ALLOCATOR_DEBUG
+	// Elements only come from slabs when they are not handed to the system allocator
+	ASSERT_GT(released, 0);
+	ASSERT_GT(after.slabsReleased, before.slabsReleased);
+#endif
+	ASSERT_EQ(FastAllocator<16384>::getTotalMemory(), totalMemory - released);
+	ASSERT_EQ(after.memoryReleased - before.memoryReleased, released);
+
+	// The elements left in the free list must still be usable
+	for (void*& p : elements) {
+		p = FastAllocator<16384>::allocate();
+		memset(p, 0xfd, 16384);
+	}
+	for (void* p : elements) {
+		FastAllocator<16384>::release(p);
+	}
+	return Void();
+}
+
 #ifdef USE_JEMALLOC
 #include <jemalloc/jemalloc.h>
 TEST_CASE("/jemalloc/4k_aligned_usable_size") {
@@ -74,6 +74,11 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( RANDOMSEED_RETRY_LIMIT,                                4 );
 	init( FAST_ALLOC_LOGGING_BYTES,                           10e6 );
 	init( FAST_ALLOC_ALLOW_GUARD_PAGES,                      false );
+	init( FAST_ALLOC_HUGE_PAGE_SLABS,                        false ); if( randomize && BUGGIFY ) FAST_ALLOC_HUGE_PAGE_SLABS = true;
+	init( FAST_ALLOC_RELEASE_EMPTY_SLABS,                    false ); if( randomize && BUGGIFY ) FAST_ALLOC_RELEASE_EMPTY_SLABS = true;
+	init( FAST_ALLOC_RELEASE_MIN_UNUSED_BYTES,                64e6 ); if( randomize && BUGGIFY ) FAST_ALLOC_RELEASE_MIN_UNUSED_BYTES = 0;
+	init( FAST_ALLOC_RELEASE_MAX_SCAN_ELEMENTS,              1<<17 );
+	init( ARENA_BLOCK_POOL_BYTES,                          4<<20 ); if( randomize && BUGGIFY ) ARENA_BLOCK_POOL_BYTES = deterministicRandom()->coinflip() ? 0 : 64<<10;
 	init( HUGE_ARENA_LOGGING_BYTES,                          100e6 );
 	init( HUGE_ARENA_LOGGING_INTERVAL,                         5.0 );
 
@@ -172,6 +177,10 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( PAGE_WRITE_CHECKSUM_HISTORY,                           0 ); if( randomize && BUGGIFY ) PAGE_WRITE_CHECKSUM_HISTORY = 10000000;
 	init( DISABLE_POSIX_KERNEL_AIO,                              0 );
 
+	//AsyncFileIOUring
+	init( ENABLE_IO_URING,                                       0 ); // Use io_uring instead of kernel AIO for unbuffered files, if the kernel supports it
+	init( IO_URING_FIXED_FILES,                               1024 );
+
 	//AsyncFileNonDurable
 	init( NON_DURABLE_MAX_WRITE_DELAY,                         2.0 ); if( randomize && BUGGIFY ) NON_DURABLE_MAX_WRITE_DELAY = 5.0;
 	init( MAX_PRIOR_MODIFICATION_DELAY,                        1.0 ); if( randomize && BUGGIFY ) MAX_PRIOR_MODIFICATION_DELAY = 10.0;
@@ -201,6 +210,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MIN_LOGGED_PRIORITY_BUSY_FRACTION,                  0.05 );
 	init( CERT_FILE_MAX_SIZE,                      5 * 1024 * 1024 );
 	init( READY_QUEUE_RESERVED_SIZE,                          8192 );
+	init( THREAD_READY_QUEUE_CAPACITY,                       4096 ); if( randomize && BUGGIFY ) THREAD_READY_QUEUE_CAPACITY = 2;
 	init( TASKS_PER_REACTOR_CHECK,                             100 );
 
 	//Network
@@ -210,6 +220,8 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MAX_PACKET_SEND_BYTES,                        128 * 1024 );
 	init( MIN_PACKET_BUFFER_BYTES,                        4 * 1024 );
 	init( MIN_PACKET_BUFFER_FREE_BYTES,                        256 );
+	init( PACKET_DIRECT_READ_BYTES,                      64 * 1024 ); // Read into a dedicated buffer
+	init( MIN_SHARED_PACKET_BUFFER_BYTES,                 16 * 1024 ); // Smaller cached serializations are copied
 	init( FLOW_TCP_NODELAY,                                      1 );
 	init( FLOW_TCP_QUICKACK,                                     0 );
 
@@ -43,6 +43,7 @@
 #include "flow/IAsyncFile.h"
 #include "flow/ActorCollection.h"
 #include "flow/TaskQueue.h"
+#include "flow/ThreadSafeQueue.h"
 #include "flow/ThreadHelper.actor.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/AsioReactor.h"
@@ -2167,6 +2168,97 @@ TEST_CASE("flow/Net2/ThreadSafeQueue/Threaded") {
 	return Void();
 }
 
+TEST_CASE("flow/Net2/ThreadSafeRingQueue/Interface") {
+	// A capacity of 2 makes the later pushes spill into the overflow map
+	ThreadSafeRingQueue<int> tq(2);
+	ASSERT(!tq.pop().present());
+	ASSERT(tq.canSleep());
+
+	ASSERT(tq.push(1) == true);
+	ASSERT(!tq.canSleep());
+	ASSERT(!tq.canSleep());
+	ASSERT(tq.push(2) == false);
+	ASSERT(tq.push(3) == false);
+	ASSERT(tq.push(4) == false);
+
+	ASSERT(tq.pop().get() == 1);
+	ASSERT(tq.pop().get() == 2);
+	ASSERT(tq.push(5) == false);
+	ASSERT(tq.pop().get() == 3);
+	ASSERT(tq.pop().get() == 4);
+	ASSERT(tq.pop().get() == 5);
+	ASSERT(!tq.pop().present());
+	ASSERT(tq.canSleep());
+
+	for (int i = 0; i < 10; ++i) {
+		ASSERT(tq.push(i) == (i == 0));
+	}
+	for (int i = 0; i < 10; ++i) {
+		ASSERT(tq.pop().get() == i);
+	}
+	ASSERT(!tq.pop().present());
+	return Void();
+}
+
+TEST_CASE("flow/Net2/ThreadSafeRingQueue/Threaded") {
+	// Same as ThreadSafeQueue/Threaded, with a ring small enough that producers regularly find their slot still taken
+	// and go through the overflow map.
+	noUnseed = true; // multi-threading inherently non-deterministic
+
+	ThreadSafeRingQueue<int> queue(deterministicRandom()->coinflip() ? 4 : 1024);
+	state std::vector<QueueTestThreadState> perThread = { QueueTestThreadState(0, 1000000),
+		                                                  QueueTestThreadState(1, 100000),
+		                                                  QueueTestThreadState(2, 1000000) };
+	state std::vector<Future<Void>> doneProducing;
+
+	int total = 0;
+	for (int t = 0; t < perThread.size(); ++t) {
+		auto& s = perThread[t];
+		doneProducing.push_back(s.doneProducing.getFuture());
+		total += s.toProduce;
+		s.handle = startThreadF([&queue, &s]() {
+			int nextYield = 0;
+			while (s.produced < s.toProduce) {
+				queue.push(s.nextProduced());
+				if (nextYield-- == 0) {
+					std::this_thread::yield();
+					nextYield = nondeterministicRandom()->randomInt(0, 100);
+				}
+			}
+			s.doneProducing.send(Void());
+		});
+	}
+	int consumed = 0;
+	while (consumed < total) {
+		Optional<int> element = queue.pop();
+		if (element.present()) {
+			int v = element.get();
+			auto& s = perThread[QueueTestThreadState::valueToThreadId(v)];
+			++consumed;
+			ASSERT(v == s.nextConsumed());
+		} else {
+			std::this_thread::yield();
+		}
+		if ((consumed & 3) == 0)
+			queue.canSleep();
+	}
+	ASSERT(!queue.pop().present());
+
+	wait(waitForAll(doneProducing));
+
+	// Make sure we continue on the main thread.
+	Promise<Void> signal;
+	state Future<Void> doneConsuming = signal.getFuture();
+	g_network->onMainThread(std::move(signal), TaskPriority::DefaultOnMainThread);
+	wait(doneConsuming);
+
+	for (int t = 0; t < perThread.size(); ++t) {
+		waitThread(perThread[t].handle);
+		perThread[t].checkDone();
+	}
+	return Void();
+}
+
 TEST_CASE("noSim/flow/Net2/onMainThreadFIFO") {
 	// Verifies that signals processed by onMainThread() are executed in order.
 	noUnseed = true; // multi-threading inherently non-deterministic
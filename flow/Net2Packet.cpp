@@ -19,6 +19,8 @@
  */
 
 #include "flow/Net2Packet.h"
+#include "flow/Knobs.h"
+#include "flow/UnitTest.h"
 
 void PacketWriter::init(PacketBuffer* buf, ReliablePacket* reliable) {
 	this->buffer = buf;
@@ -72,6 +74,29 @@ void PacketWriter::nextBuffer(size_t size) {
 	}
 }
 
+void PacketWriter::serializeSharedBytes(Standalone<StringRef> const& bytes) {
+	if (bytes.size() < FLOW_KNOBS->MIN_SHARED_PACKET_BUFFER_BYTES) {
+		serializeBytes(bytes);
+		return;
+	}
+
+	auto last_buffer_bytes_written = buffer->bytes_written;
+	length += last_buffer_bytes_written;
+
+	// The wrapped buffer is full, so the next write into this chain starts a new PacketBuffer after it
+	buffer->next = PacketBuffer::wrap(bytes);
+	buffer = buffer->nextPacketBuffer();
+
+	if (reliable) {
+		reliable->end = last_buffer_bytes_written;
+		reliable->cont = new ReliablePacket;
+		reliable = reliable->cont;
+		reliable->buffer = buffer;
+		buffer->addref();
+		reliable->begin = 0;
+	}
+}
+
 // Adds exactly bytes of unwritten length to the buffer, possibly across packet buffer boundaries,
 // and initializes buf to point to the packet buffer(s) that contain the unwritten space
 void PacketWriter::writeAhead(int bytes, struct SplitBuffer* buf) {
@@ -217,3 +242,36 @@ void ReliablePacketList::discardAll() {
 	while (reliable.next != &reliable)
 		reliable.next->remove();
 }
+
+TEST_CASE("/flow/Net2Packet/SharedBytes") {
+	Standalone<StringRef> shared = makeString(FLOW_KNOBS->MIN_SHARED_PACKET_BUFFER_BYTES + 100);
+	deterministicRandom()->randomBytes(mutateString(shared), shared.size());
+
+	// Queue the same bytes to two destinations, each with a small header in front of them
+	for (int i = 0; i < 2; i++) {
+		UnsentPacketQueue unsent;
+		ReliablePacketList reliable;
+		ReliablePacket* rp = new ReliablePacket;
+		PacketWriter wr(unsent.getWriteBuffer(), rp, AssumeVersion(g_network->protocolVersion()));
+		uint32_t header = i;
+		wr.serializeBinaryItem(header);
+		wr.serializeSharedBytes(shared);
+		unsent.setWriteBuffer(wr.finish());
+		reliable.insert(rp);
+		ASSERT_EQ(wr.size(), (int)(sizeof(header) + shared.size()));
+
+		std::string contents;
+		bool linked = false;
+		for (SendBuffer* b = unsent.getUnsent(); b; b = b->next) {
+			contents.append(reinterpret_cast<const char*>(b->data()), b->bytes_written);
+			linked = linked || b->data() == shared.begin();
+		}
+		ASSERT(linked);
+		ASSERT_EQ(contents.size(), sizeof(header) + shared.size());
+		ASSERT(StringRef(contents).substr(sizeof(header)) == shared);
+
+		unsent.discardAll();
+		reliable.discardAll();
+	}
+	return Void();
+}
@@ -2191,6 +2191,24 @@ void* allocate(size_t length, bool allowLargePages, bool includeGuardPages) {
 	return block;
 }
 
+void deallocate(void* block, size_t length, bool includeGuardPages) {
+#ifdef _WIN32
+	VirtualFree(block, 0, MEM_RELEASE);
+#else
+	if (includeGuardPages) {
+		static size_t pageSize = sysconf(_SC_PAGESIZE);
+		length = RightAlign(length, pageSize) + 2 * pageSize;
+		block = (void*)(uintptr_t(block) - pageSize);
+	}
+	if (munmap(block, length) != 0) {
+		int err = errno;
+		fprintf(stderr, "Error calling munmap(%p, %zu): %s\n", block, length, strerror(err));
+		fflush(stderr);
+		std::abort();
+	}
+#endif
+}
+
 #if 0
 void* numaAllocate(size_t size) {
 	void* thePtr = (void*)0xA00000000LL;
@@ -67,7 +67,42 @@ SystemStatistics getSystemStatistics() {
 #define DETAILALLOCATORMEMUSAGE(size)                                                                                  \
 	detail("TotalMemory" #size, FastAllocator<size>::getTotalMemory())                                                 \
 	    .detail("ApproximateUnusedMemory" #size, FastAllocator<size>::getApproximateMemoryUnused())                    \
-	    .detail("ActiveThreads" #size, FastAllocator<size>::getActiveThreads())
+	    .detail("ActiveThreads" #size, FastAllocator<size>::getActiveThreads())                                        \
+	    .detail("MainThreadCachedMemory" #size, FastAllocator<size>::getThreadCachedMemory())                          \
+	    .detail("MagazinesAllocated" #size, FastAllocator<size>::getStats().magazinesAllocated)                        \
+	    .detail("MagazinesReused" #size, FastAllocator<size>::getStats().magazinesReused)                              \
+	    .detail("MagazinesReturned" #size, FastAllocator<size>::getStats().magazinesReturned)                          \
+	    .detail("ReleasedMemory" #size, FastAllocator<size>::getStats().memoryReleased)
+
+// Publishes the statistics of one FastAllocator size class as TDMetrics, so their rates can be followed over time
+template <int Size>
+struct FastAllocatorMetrics {
+	Int64MetricHandle totalMemory;
+	Int64MetricHandle unusedMemory;
+	Int64MetricHandle magazinesAllocated;
+	Int64MetricHandle magazinesReused;
+	Int64MetricHandle magazinesReturned;
+	Int64MetricHandle memoryReleased;
+
+	FastAllocatorMetrics()
+	  : totalMemory("FastAlloc.TotalMemory"_sr, format("%d", Size)),
+	    unusedMemory("FastAlloc.UnusedMemory"_sr, format("%d", Size)),
+	    magazinesAllocated("FastAlloc.MagazinesAllocated"_sr, format("%d", Size)),
+	    magazinesReused("FastAlloc.MagazinesReused"_sr, format("%d", Size)),
+	    magazinesReturned("FastAlloc.MagazinesReturned"_sr, format("%d", Size)),
+	    memoryReleased("FastAlloc.MemoryReleased"_sr, format("%d", Size)) {}
+
+	static void update() {
+		static FastAllocatorMetrics metrics;
+		FastAllocatorStats stats = FastAllocator<Size>::getStats();
+		metrics.totalMemory = FastAllocator<Size>::getTotalMemory();
+		metrics.unusedMemory = FastAllocator<Size>::getApproximateMemoryUnused();
+		metrics.magazinesAllocated = stats.magazinesAllocated;
+		metrics.magazinesReused = stats.magazinesReused;
+		metrics.magazinesReturned = stats.magazinesReturned;
+		metrics.memoryReleased = stats.memoryReleased;
+	}
+};
 
 namespace {
 
@@ -179,6 +214,14 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			                currentStats.elapsed)
 			    .trackLatest(eventName);
 
+			if (FLOW_KNOBS->FAST_ALLOC_RELEASE_EMPTY_SLABS) {
+				int64_t releasedMemory = releaseEmptyFastAllocatorSlabs(
+				    FLOW_KNOBS->FAST_ALLOC_RELEASE_MIN_UNUSED_BYTES, FLOW_KNOBS->FAST_ALLOC_RELEASE_MAX_SCAN_ELEMENTS);
+				if (releasedMemory > 0) {
+					TraceEvent("FastAllocReleasedMemory").detail("Bytes", releasedMemory);
+				}
+			}
+
 			TraceEvent("MemoryMetrics")
 			    .DETAILALLOCATORMEMUSAGE(16)
 			    .DETAILALLOCATORMEMUSAGE(32)
@@ -193,6 +236,9 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .DETAILALLOCATORMEMUSAGE(8192)
 			    .DETAILALLOCATORMEMUSAGE(16384)
 			    .detail("HugeArenaMemory", g_hugeArenaMemory.load())
+			    .detail("ArenaBlockPoolHits", g_arenaBlockPoolHits.load())
+			    .detail("ArenaBlockPoolMisses", g_arenaBlockPoolMisses.load())
+			    .detail("ArenaBlockPoolMemory", g_arenaBlockPoolMemory.load())
 			    .detail("DCID", machineState.dcId)
 			    .detail("ZoneID", machineState.zoneId)
 			    .detail("MachineID", machineState.machineId);
@@ -225,6 +271,19 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			unused_memory += FastAllocator<8192>::getApproximateMemoryUnused();
 			unused_memory += FastAllocator<16384>::getApproximateMemoryUnused();
 
+			FastAllocatorMetrics<16>::update();
+			FastAllocatorMetrics<32>::update();
+			FastAllocatorMetrics<64>::update();
+			FastAllocatorMetrics<96>::update();
+			FastAllocatorMetrics<128>::update();
+			FastAllocatorMetrics<256>::update();
+			FastAllocatorMetrics<512>::update();
+			FastAllocatorMetrics<1024>::update();
+			FastAllocatorMetrics<2048>::update();
+			FastAllocatorMetrics<4096>::update();
+			FastAllocatorMetrics<8192>::update();
+			FastAllocatorMetrics<16384>::update();
+
 			if (total_memory > 0) {
 				TraceEvent("FastAllocMemoryUsage")
 				    .detail("TotalMemory", total_memory)
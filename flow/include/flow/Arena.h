@@ -196,6 +196,12 @@ struct ArenaBlock : NonCopyable, ThreadSafeReferenceCounted<ArenaBlock> {
 	static void* operator new(size_t s) = delete;
 };
 
+// Blocks of 4KiB to 1MiB released by the network thread are kept for its reuse, up to ARENA_BLOCK_POOL_BYTES.
+// These count the block allocations served from and missed by the pool, and the memory it holds.
+extern std::atomic<int64_t> g_arenaBlockPoolHits;
+extern std::atomic<int64_t> g_arenaBlockPoolMisses;
+extern std::atomic<int64_t> g_arenaBlockPoolMemory;
+
 inline void* operator new(size_t size, Arena& p) {
 	UNSTOPPABLE_ASSERT(size < std::numeric_limits<int>::max());
 	return ArenaBlock::allocate(p.impl, (int)size);
@@ -889,6 +895,21 @@ static inline int commonPrefixLength(uint8_t const* ap, uint8_t const* bp, int c
 	return cl;
 }
 
+// Same as commonPrefixLength(), but compares 16 bytes at a time using SSE2 (NEON through sse2neon.h on aarch64).
+// Faster than the word-at-a-time version for keys that share long prefixes, such as tenant or tuple encoded keys.
+static inline int commonPrefixLengthSIMD(uint8_t const* ap, uint8_t const* bp, int cl) {
+	int i = 0;
+	for (; i + 16 <= cl; i += 16) {
+		__m128i a = _mm_loadu_si128((const __m128i*)(ap + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(bp + i));
+		unsigned mismatch = ~unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xffff;
+		if (mismatch) {
+			return i + ctz(mismatch);
+		}
+	}
+	return i + commonPrefixLength(ap + i, bp + i, cl - i);
+}
+
 static inline int commonPrefixLength(const StringRef& a, const StringRef& b) {
 	return commonPrefixLength(a.begin(), b.begin(), std::min(a.size(), b.size()));
 }
@@ -104,6 +104,17 @@ void recordDeallocation(void* ptr);
 #endif
 
 inline constexpr auto kFastAllocMagazineBytes = 128 << 10;
+// Size of the slabs FastAllocator carves magazines from when FAST_ALLOC_HUGE_PAGE_SLABS is set
+inline constexpr auto kFastAllocHugePageSlabBytes = 2 << 20;
+
+// Cumulative counts of magazines moving between a FastAllocator's threads, its global free list and the system
+struct FastAllocatorStats {
+	int64_t magazinesAllocated = 0; // Carved from slabs newly obtained from the system
+	int64_t magazinesReused = 0; // Taken by a thread from the global free list
+	int64_t magazinesReturned = 0; // Given back by a thread to the global free list
+	int64_t slabsReleased = 0; // Found completely free and returned to the system
+	int64_t memoryReleased = 0;
+};
 
 template <int Size>
 class FastAllocator {
@@ -115,6 +126,15 @@ public:
 	static long long getTotalMemory();
 	static long long getApproximateMemoryUnused();
 	static long long getActiveThreads();
+	// Memory held for allocation by the calling thread's magazines
+	static long long getThreadCachedMemory();
+	static FastAllocatorStats getStats();
+
+	// Looks at the oldest magazines in the global free list, about maxElements elements, returns the slabs whose
+	// memory is entirely among them to the system, and returns the number of bytes released. The elements kept go back
+	// to the end of the free list, so repeated calls work through all of it. Memory cached by threads is not looked at,
+	// so a slab with an element in any thread's magazine is kept.
+	static long long releaseEmptySlabs(int maxElements);
 
 #ifdef ALLOC_INSTRUMENTATION
 	static volatile int32_t pageCount;
@@ -176,6 +196,9 @@ extern std::atomic<int64_t> g_hugeArenaMemory;
 void hugeArenaSample(int size);
 void releaseAllThreadMagazines();
 int64_t getTotalUnusedAllocatedMemory();
+// Calls FastAllocator<Size>::releaseEmptySlabs(maxScanElements) for the next size class, in turn, with at least
+// minUnusedBytes in its global free list, and returns the number of bytes released
+int64_t releaseEmptyFastAllocatorSlabs(int64_t minUnusedBytes, int maxScanElements);
 
 inline constexpr int nextFastAllocatedSize(int x) {
 	assert(x > 0 && x <= 16384);
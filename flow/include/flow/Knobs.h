@@ -132,6 +132,11 @@ public:
 	int RANDOMSEED_RETRY_LIMIT;
 	double FAST_ALLOC_LOGGING_BYTES;
 	bool FAST_ALLOC_ALLOW_GUARD_PAGES;
+	bool FAST_ALLOC_HUGE_PAGE_SLABS; // Get memory for magazines in 2MiB slabs advised to use transparent huge pages
+	bool FAST_ALLOC_RELEASE_EMPTY_SLABS; // Periodically return completely free slabs to the system
+	int64_t FAST_ALLOC_RELEASE_MIN_UNUSED_BYTES; // Only look for free slabs in size classes with this much unused
+	int FAST_ALLOC_RELEASE_MAX_SCAN_ELEMENTS; // Free list elements looked at per search for free slabs
+	int64_t ARENA_BLOCK_POOL_BYTES; // Arena blocks of 4KiB to 1MiB the network thread keeps for reuse; 0 disables it
 	double HUGE_ARENA_LOGGING_BYTES;
 	double HUGE_ARENA_LOGGING_INTERVAL;
 
@@ -235,6 +240,10 @@ public:
 	int PAGE_WRITE_CHECKSUM_HISTORY;
 	int DISABLE_POSIX_KERNEL_AIO;
 
+	// AsyncFileIOUring
+	int ENABLE_IO_URING;
+	int IO_URING_FIXED_FILES;
+
 	// AsyncFileNonDurable
 	double NON_DURABLE_MAX_WRITE_DELAY;
 	double MAX_PRIOR_MODIFICATION_DELAY;
@@ -265,6 +274,7 @@ public:
 	double MIN_LOGGED_PRIORITY_BUSY_FRACTION;
 	int CERT_FILE_MAX_SIZE;
 	int READY_QUEUE_RESERVED_SIZE;
+	int THREAD_READY_QUEUE_CAPACITY; // Ring slots for tasks added from other threads; more spill into an overflow map
 	int TASKS_PER_REACTOR_CHECK;
 
 	// Network
@@ -274,6 +284,8 @@ public:
 	int MAX_PACKET_SEND_BYTES;
 	int MIN_PACKET_BUFFER_BYTES;
 	int MIN_PACKET_BUFFER_FREE_BYTES;
+	int PACKET_DIRECT_READ_BYTES;
+	int MIN_SHARED_PACKET_BUFFER_BYTES;
 	int FLOW_TCP_NODELAY;
 	int FLOW_TCP_QUICKACK;
 
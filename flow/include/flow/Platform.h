@@ -300,6 +300,9 @@ std::vector<std::string> getEnvironmentKnobOptions();
 void setMemoryQuota(size_t limit);
 
 void* allocate(size_t length, bool allowLargePages, bool includeGuardPages);
+// Returns a block obtained from allocate() to the system. includeGuardPages says whether guard pages were actually
+// mapped around the block, which allocate() only does if FAST_ALLOC_ALLOW_GUARD_PAGES is set.
+void deallocate(void* block, size_t length, bool includeGuardPages);
 
 void setAffinity(int proc);
 
@@ -26,14 +26,16 @@
 #include <vector>
 #include "flow/TDMetric.actor.h"
 #include "flow/network.h"
-#include "flow/ThreadSafeQueue.h"
+#include "flow/ThreadSafeRingQueue.h"
 
 template <typename Task>
 // A queue of ordered tasks, both ready to execute, and delayed for later execution.
 // All functions must be called on the main thread, except for addReadyThreadSafe() which can be called from any thread.
 class TaskQueue {
 public:
-	TaskQueue() : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE) {}
+	TaskQueue()
+	  : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE),
+	    threadReady(FLOW_KNOBS->THREAD_READY_QUEUE_CAPACITY) {}
 
 	// Add a task that is ready to be executed.
 	void addReady(TaskPriority taskId, Task* t) { this->ready.push(OrderedTask(getFIFOPriority(taskId), taskId, t)); }
@@ -149,7 +151,7 @@ private:
 	uint64_t tasksIssued;
 
 	ReadyQueue<OrderedTask> ready;
-	ThreadSafeQueue<std::pair<TaskPriority, Task*>> threadReady;
+	ThreadSafeRingQueue<std::pair<TaskPriority, Task*>> threadReady;
 
 	std::priority_queue<DelayedTask, std::vector<DelayedTask>> timers;
 
@@ -0,0 +1,142 @@
+/*
+ * ThreadSafeRingQueue.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_THREAD_SAFE_RING_QUEUE_H
+#define FLOW_THREAD_SAFE_RING_QUEUE_H
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include "flow/Arena.h"
+#include "flow/ThreadPrimitives.h"
+
+// A multi-producer, single-consumer queue with the same interface as ThreadSafeQueue, backed by a fixed size ring of
+// slots instead of a linked list of allocated nodes.
+//
+// Each push takes a ticket from a shared counter, and elements are popped in ticket order, so elements pushed by one
+// thread are popped in the order they were pushed. A producer whose slot is still held by the element one lap earlier
+// puts its element in an overflow map instead of waiting for the consumer, so push never blocks on a full ring.
+//
+// Like ThreadSafeQueue, only the first push after the consumer decides it can sleep returns true, so a burst of pushes
+// from other threads wakes the consumer once.
+template <class T>
+class ThreadSafeRingQueue : NonCopyable {
+	struct Slot {
+		// ticket when the slot is free for the producer holding that ticket, ticket + 1 once the element is stored
+		std::atomic<uint64_t> sequence;
+		T data;
+	};
+
+	const uint64_t capacity;
+	const uint64_t mask;
+	std::unique_ptr<Slot[]> slots;
+
+	// Written by producers
+	alignas(MAX_CACHE_LINE_SIZE) std::atomic<uint64_t> tail;
+	// Set by the consumer before sleeping, and cleared by the first producer to see it
+	alignas(MAX_CACHE_LINE_SIZE) std::atomic<bool> sleeping;
+	// Only accessed by the consumer
+	alignas(MAX_CACHE_LINE_SIZE) uint64_t head;
+
+	ThreadSpinLock overflowLock;
+	std::atomic<int64_t> overflowSize;
+	std::map<uint64_t, T> overflow;
+
+	static uint64_t roundUpToPowerOfTwo(uint64_t n) {
+		uint64_t result = 1;
+		while (result < n) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+public:
+	explicit ThreadSafeRingQueue(int minCapacity)
+	  : capacity(roundUpToPowerOfTwo(std::max(minCapacity, 2))), mask(capacity - 1), slots(new Slot[capacity]),
+	    tail(0), sleeping(false), head(0), overflowSize(0) {
+		for (uint64_t i = 0; i < capacity; i++) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// If push() returns true, the consumer may be sleeping and should be woken
+	template <class U>
+	bool push(U&& data) {
+		uint64_t ticket = tail.fetch_add(1);
+		Slot& slot = slots[ticket & mask];
+		if (slot.sequence.load(std::memory_order_acquire) == ticket) {
+			slot.data = std::forward<U>(data);
+			slot.sequence.store(ticket + 1, std::memory_order_release);
+		} else {
+			ThreadSpinLockHolder holder(overflowLock);
+			overflow.emplace(ticket, std::forward<U>(data));
+			overflowSize.fetch_add(1, std::memory_order_release);
+		}
+		// The sequentially consistent load pairs with the store in canSleep(): either the consumer sees our ticket
+		// before it sleeps, or we see that it is sleeping.
+		return sleeping.load() && sleeping.exchange(false);
+	}
+
+	///////////// The below functions may only be called by a single, consumer thread //////////////////
+
+	// If canSleep returns true, then the queue is empty and the next push() will return true
+	bool canSleep() {
+		if (tail.load() != head) {
+			return false;
+		}
+		sleeping.store(true);
+		return tail.load() == head;
+	}
+
+	// Returns the next element, or an empty Optional if the next element has not been fully pushed yet
+	Optional<T> pop() {
+		if (sleeping.load(std::memory_order_relaxed)) {
+			sleeping.store(false, std::memory_order_relaxed);
+		}
+
+		Slot& slot = slots[head & mask];
+		if (slot.sequence.load(std::memory_order_acquire) == head + 1) {
+			T data = std::move(slot.data);
+			slot.sequence.store(head + capacity, std::memory_order_release);
+			++head;
+			return Optional<T>(std::move(data));
+		}
+
+		if (overflowSize.load(std::memory_order_acquire) > 0) {
+			ThreadSpinLockHolder holder(overflowLock);
+			auto it = overflow.begin();
+			if (it != overflow.end() && it->first == head) {
+				T data = std::move(it->second);
+				overflow.erase(it);
+				overflowSize.fetch_sub(1, std::memory_order_relaxed);
+				// The producer of this ticket never used the slot, so hand it to the producer of the next lap
+				slot.sequence.store(head + capacity, std::memory_order_release);
+				++head;
+				return Optional<T>(std::move(data));
+			}
+		}
+		return Optional<T>();
+	}
+};
+
+#endif
@@ -348,6 +348,26 @@ struct serialize_raw<ErrorOr<EnsureTable<CachedSerialization<V>>>> : std::true_t
 	}
 };
 
+// A reply of a CachedSerialization serializes to exactly its cached bytes (see serialize_raw above), so a value sent
+// to many peers shares a single buffer across their send queues instead of being copied into each of them.
+template <class V>
+struct SerializeSource<ErrorOr<EnsureTable<CachedSerialization<V>>>>
+  : MakeSerializeSource<SerializeSource<ErrorOr<EnsureTable<CachedSerialization<V>>>>,
+                        ErrorOr<EnsureTable<CachedSerialization<V>>>> {
+	using value_type = ErrorOr<EnsureTable<CachedSerialization<V>>>;
+	value_type const& value;
+	SerializeSource(value_type const& value) : value(value) {}
+	void serializePacketWriter(PacketWriter& w) const override {
+		if (value.present()) {
+			w.serializeSharedBytes(value.get().asUnderlyingType().getCache());
+		} else {
+			MakeSerializeSource<SerializeSource<value_type>, value_type>::serializePacketWriter(w);
+		}
+	}
+	void serializeObjectWriter(ObjectWriter& w) const override { w.serialize(value); }
+	value_type const& get() const override { return value; }
+};
+
 template <class T>
 struct Callback {
 	Callback<T>*prev, *next;
@@ -781,8 +781,10 @@ struct PacketBuffer : SendBuffer {
 private:
 	int reference_count;
 	uint32_t const size_;
+	// Keeps the bytes of a buffer created by wrap() alive; empty for buffers which own their data
+	Arena shared;
 	static constexpr size_t PACKET_BUFFER_MIN_SIZE = 16384;
-	static constexpr size_t PACKET_BUFFER_OVERHEAD = 40;
+	static constexpr size_t PACKET_BUFFER_OVERHEAD = 48;
 
 public:
 	double const enqueue_time;
@@ -803,10 +805,21 @@ public:
 		uint8_t* mem = new uint8_t[size + PACKET_BUFFER_OVERHEAD];
 		return new (mem) PacketBuffer{ size };
 	}
+	// Returns a full buffer whose data is the given immutable bytes rather than a copy of them. The same bytes can be
+	// wrapped once per destination, so a message serialized once is queued to many peers without being copied.
+	static PacketBuffer* wrap(Standalone<StringRef> const& bytes) {
+		uint8_t* mem = new uint8_t[PACKET_BUFFER_OVERHEAD];
+		PacketBuffer* pb = new (mem) PacketBuffer{ static_cast<size_t>(bytes.size()) };
+		pb->_data = const_cast<uint8_t*>(bytes.begin());
+		pb->bytes_written = bytes.size();
+		pb->shared = bytes.arena();
+		return pb;
+	}
 	PacketBuffer* nextPacketBuffer() { return static_cast<PacketBuffer*>(next); }
 	void addref() { ++reference_count; }
 	void delref() {
 		if (!--reference_count) {
+			this->~PacketBuffer();
 			delete[] reinterpret_cast<uint8_t*>(this);
 		}
 	}
@@ -845,6 +858,9 @@ struct PacketWriter {
 	int size() const { return length; }
 
 	void serializeBytes(StringRef bytes) { serializeBytes(bytes.begin(), bytes.size()); }
+	// Like serializeBytes, but large enough byte strings are linked into the buffer chain instead of copied. The bytes
+	// must not be modified while any packet referencing them is queued.
+	void serializeSharedBytes(Standalone<StringRef> const& bytes);
 	template <class T>
 	void serializeBinaryItem(const T& t) {
 		static_assert(is_binary_serializable<T>::value,
@@ -0,0 +1,96 @@
+/*
+ * BenchArena.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/IKnobCollection.h"
+#include "flow/Arena.h"
+#include "flow/Knobs.h"
+#include "flow/Trace.h"
+
+#include <algorithm>
+#include <vector>
+
+static constexpr bool NO_POOL = false;
+static constexpr bool POOL = true;
+
+// Sets ARENA_BLOCK_POOL_BYTES for the lifetime of a benchmark run
+class ArenaBlockPoolSetting {
+	int64_t previous;
+
+	static void set(int64_t bytes) {
+		IKnobCollection::getMutableGlobalKnobCollection().setKnob("arena_block_pool_bytes",
+		                                                          KnobValueRef::create(int64_t{ bytes }));
+	}
+
+public:
+	explicit ArenaBlockPoolSetting(bool usePool) : previous(FLOW_KNOBS->ARENA_BLOCK_POOL_BYTES) {
+		// Only the network thread pools blocks, and benchmarks run on a thread of their own
+		if (usePool) {
+			TraceEvent::setNetworkThread();
+		}
+		set(usePool ? std::max<int64_t>(previous, 64 << 20) : 0);
+	}
+	~ArenaBlockPoolSetting() { set(previous); }
+};
+
+// A range read reply: range(0) key-value pairs with values of range(1) bytes, built in one arena and then dropped
+template <bool usePool>
+static void bench_arena_reply(benchmark::State& state) {
+	ArenaBlockPoolSetting setting(usePool);
+	const int rows = state.range(0);
+	const std::string value(state.range(1), 'v');
+	const int64_t poolHits = g_arenaBlockPoolHits.load();
+	const int64_t poolMisses = g_arenaBlockPoolMisses.load();
+	for (auto _ : state) {
+		Arena arena;
+		VectorRef<StringRef> reply;
+		for (int i = 0; i < rows; ++i) {
+			reply.push_back_deep(arena, StringRef(value));
+		}
+		benchmark::DoNotOptimize(reply);
+	}
+	state.SetBytesProcessed(static_cast<long>(state.iterations()) * rows * value.size());
+	state.counters["pool_hits"] = g_arenaBlockPoolHits.load() - poolHits;
+	state.counters["pool_misses"] = g_arenaBlockPoolMisses.load() - poolMisses;
+}
+
+// A commit batch: range(0) transactions, each with an arena of range(1) bytes, all alive until the batch is done
+template <bool usePool>
+static void bench_arena_batch(benchmark::State& state) {
+	ArenaBlockPoolSetting setting(usePool);
+	const int transactions = state.range(0);
+	const int bytes = state.range(1);
+	std::vector<Arena> batch;
+	batch.reserve(transactions);
+	for (auto _ : state) {
+		for (int i = 0; i < transactions; ++i) {
+			batch.emplace_back(bytes);
+			benchmark::DoNotOptimize(new (batch.back()) uint8_t[bytes]);
+		}
+		batch.clear();
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()) * transactions);
+}
+
+BENCHMARK_TEMPLATE(bench_arena_reply, NO_POOL)->Ranges({ { 1, 1 << 12 }, { 16, 1 << 14 } });
+BENCHMARK_TEMPLATE(bench_arena_reply, POOL)->Ranges({ { 1, 1 << 12 }, { 16, 1 << 14 } });
+BENCHMARK_TEMPLATE(bench_arena_batch, NO_POOL)->Ranges({ { 1, 1 << 10 }, { 1 << 12, 1 << 20 } });
+BENCHMARK_TEMPLATE(bench_arena_batch, POOL)->Ranges({ { 1, 1 << 10 }, { 1 << 12, 1 << 20 } });
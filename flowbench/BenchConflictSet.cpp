@@ -0,0 +1,92 @@
+/*
+ * BenchConflictSet.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/CommitTransaction.h"
+#include "fdbserver/ConflictSet.h"
+#include "flow/IRandom.h"
+
+#include <string>
+#include <vector>
+
+// Keys share a prefix, the shape of tenant or tuple encoded keys
+static StringRef conflictKey(Arena& arena, const std::string& prefix, int n) {
+	return StringRef(arena, prefix + format("%08d", n));
+}
+
+// Resolves batches of 1000 transactions, each reading one key range and writing another, against a conflict set
+// holding the writes of the previous range(0) batches. Keys share a prefix of 2^range(1) bytes. Each iteration checks
+// one batch's reads and inserts its writes, so this times both skip list searches and inserts. Build with
+// -DCONFLICT_SET_PARTIAL_KEY_SEARCH=0 to time the search from before partial keys were added to the nodes.
+static void bench_conflict_set(benchmark::State& state) {
+	const int historyBatches = state.range(0);
+	const std::string prefix(1 << state.range(1), 'p');
+	const int transactionsPerBatch = 1000;
+	const int keySpace = 1000000;
+
+	ConflictSet* cs = newConflictSet();
+	Version version = 0;
+	std::vector<int> nonConflicting;
+
+	Arena arena;
+	std::vector<CommitTransactionRef> trs;
+	auto makeBatch = [&]() {
+		arena = Arena();
+		trs.assign(transactionsPerBatch, CommitTransactionRef());
+		for (auto& tr : trs) {
+			int r = deterministicRandom()->randomInt(0, keySpace);
+			int w = deterministicRandom()->randomInt(0, keySpace);
+			tr.read_snapshot = version;
+			tr.read_conflict_ranges.push_back(
+			    arena, KeyRangeRef(conflictKey(arena, prefix, r), conflictKey(arena, prefix, r + 10)));
+			tr.write_conflict_ranges.push_back(
+			    arena, KeyRangeRef(conflictKey(arena, prefix, w), conflictKey(arena, prefix, w + 1)));
+		}
+	};
+	auto resolveBatch = [&]() {
+		version += 10;
+		const Version newOldestVersion = std::max<Version>(0, version - 10 * historyBatches);
+		ConflictBatch batch(cs);
+		for (const auto& tr : trs) {
+			batch.addTransaction(tr, newOldestVersion);
+		}
+		nonConflicting.clear();
+		batch.detectConflicts(version, newOldestVersion, nonConflicting);
+	};
+
+	for (int i = 0; i < historyBatches; ++i) {
+		makeBatch();
+		resolveBatch();
+	}
+	for (auto _ : state) {
+		state.PauseTiming();
+		makeBatch();
+		state.ResumeTiming();
+		resolveBatch();
+	}
+
+	destroyConflictSet(cs);
+	state.SetItemsProcessed(static_cast<long>(state.iterations() * transactionsPerBatch));
+}
+
+BENCHMARK(bench_conflict_set)
+    ->ArgsProduct({ { 10, 100 }, { 0, 4, 6 } })
+    ->ReportAggregatesOnly(true);
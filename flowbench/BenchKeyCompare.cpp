@@ -0,0 +1,72 @@
+/*
+ * BenchKeyCompare.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2022 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "flow/Arena.h"
+
+#include <string>
+
+enum class CompareType {
+	Memcmp,
+	CommonPrefix,
+	CommonPrefixSIMD,
+};
+
+template <CompareType compareType>
+int compare(const StringRef& a, const StringRef& b) = delete;
+
+template <>
+inline int compare<CompareType::Memcmp>(const StringRef& a, const StringRef& b) {
+	return a.compare(b);
+}
+
+template <>
+inline int compare<CompareType::CommonPrefix>(const StringRef& a, const StringRef& b) {
+	int cl = std::min(a.size(), b.size());
+	int p = commonPrefixLength(a.begin(), b.begin(), cl);
+	return p == cl ? a.size() - b.size() : a[p] - b[p];
+}
+
+template <>
+inline int compare<CompareType::CommonPrefixSIMD>(const StringRef& a, const StringRef& b) {
+	int cl = std::min(a.size(), b.size());
+	int p = commonPrefixLengthSIMD(a.begin(), b.begin(), cl);
+	return p == cl ? a.size() - b.size() : a[p] - b[p];
+}
+
+// Compares two keys which share a prefix of 2^range(0) bytes and differ in the last byte, the shape of keys
+// the resolver compares when they are tenant or tuple encoded.
+template <CompareType compareType>
+static void bench_key_compare(benchmark::State& state) {
+	int prefixLength = 1 << state.range(0);
+	std::string a(prefixLength, 'x');
+	std::string b = a;
+	a.push_back('a');
+	b.push_back('b');
+	StringRef aRef(a), bRef(b);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(compare<compareType>(aRef, bRef));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_key_compare, CompareType::Memcmp)->DenseRange(2, 10)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_key_compare, CompareType::CommonPrefix)->DenseRange(2, 10)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_key_compare, CompareType::CommonPrefixSIMD)->DenseRange(2, 10)->ReportAggregatesOnly(true);
@@ -26,6 +26,11 @@
 #include "flow/network.h"
 #include "flow/ThreadHelper.actor.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 ACTOR static Future<Void> increment(TaskPriority priority, uint32_t* sum) {
@@ -91,3 +96,58 @@ static void bench_delay(benchmark::State& benchState) {
 
 BENCHMARK_TEMPLATE(bench_delay, DELAY)->Range(0, 1 << 16)->ReportAggregatesOnly(true);
 BENCHMARK_TEMPLATE(bench_delay, YIELD)->Range(0, 1 << 16)->ReportAggregatesOnly(true);
+
+static constexpr int64_t SUBMITS_PER_THREAD = 1 << 14;
+
+// Throughput of tasks submitted to the network thread from range(0) other threads at once
+static void bench_cross_thread_submit(benchmark::State& benchState) {
+	const int threadCount = benchState.range(0);
+	std::atomic<int64_t> executed(0);
+	while (benchState.KeepRunning()) {
+		executed = 0;
+		std::vector<std::thread> producers;
+		producers.reserve(threadCount);
+		for (int t = 0; t < threadCount; ++t) {
+			producers.emplace_back([&executed] {
+				for (int64_t i = 0; i < SUBMITS_PER_THREAD; ++i) {
+					onMainThreadVoid([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+				}
+			});
+		}
+		for (auto& producer : producers) {
+			producer.join();
+		}
+		while (executed.load(std::memory_order_relaxed) < threadCount * SUBMITS_PER_THREAD) {
+			std::this_thread::yield();
+		}
+	}
+	benchState.SetItemsProcessed(threadCount * SUBMITS_PER_THREAD * static_cast<long>(benchState.iterations()));
+}
+
+BENCHMARK(bench_cross_thread_submit)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->ReportAggregatesOnly(true);
+
+// Time from submitting a task on another thread until it starts running on an idle network thread, which includes
+// waking the network thread up. range(0) is the number of microseconds the network thread is left idle beforehand.
+static void bench_wake_latency(benchmark::State& benchState) {
+	const auto idle = std::chrono::microseconds(benchState.range(0));
+	std::atomic<double> latencySum(0);
+	while (benchState.KeepRunning()) {
+		benchState.PauseTiming();
+		std::this_thread::sleep_for(idle);
+		benchState.ResumeTiming();
+
+		std::atomic<bool> done(false);
+		const double submitted = timer_monotonic();
+		onMainThreadVoid([&latencySum, &done, submitted] {
+			latencySum.store(latencySum.load(std::memory_order_relaxed) + timer_monotonic() - submitted,
+			                 std::memory_order_relaxed);
+			done.store(true, std::memory_order_release);
+		});
+		while (!done.load(std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+	}
+	benchState.counters["wake_latency_us"] = 1e6 * latencySum.load() / benchState.iterations();
+}
+
+BENCHMARK(bench_wake_latency)->Arg(0)->Arg(100)->Arg(1000)->UseRealTime()->ReportAggregatesOnly(true);